@@ -60,6 +60,8 @@
 *               -s       :  output smoothed cepstrum    [FALSE]         *
 *               -e e     :  minimum value for epsilon   [0]             *
 *               -P P     :  order of Pade approximation [4]             *
+*               --stats  :  write statistics to stderr  [FALSE]         *
+*                           as JSON lines                               *
 *       infile:                                                         *
 *               data sequence                                           *
 *                   , x(0), x(1), ...                                   *
@@ -72,7 +74,7 @@
 *       notice:                                                         *
 *               P = 4 or 5                                              *
 *       require:                                                        *
-*               lmadf()                                                 *
+*               lmadf(), cepwarm_valid(), stats_open()                  *
 *                                                                       *
 ************************************************************************/
 
@@ -108,6 +110,7 @@ static char *rcs_id = "$Id: acep.c,v 1.27 2014/12/11 08:30:28 uratec Exp $";
 #define AVEFLAG FA
 #define TAU 0.9
 #define EPS 0.0
+#define STATS FA
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -133,6 +136,9 @@ void usage(const int status)
    fprintf(stderr, "       -e e  : minimum value for epsilon   [%g]\n", EPS);
    fprintf(stderr, "       -P P  : order of Pade approximation [%d]\n",
            PADEORD);
+   fprintf(stderr, "       --stats : write statistics to stderr  [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  stdin:\n");
    fprintf(stderr, "       data sequence (%s)\n", FORMAT);
@@ -156,7 +162,7 @@ int main(int argc, char **argv)
 {
    int m = ORDER, period = PERIOD, i, j, pd = PADEORD;
    FILE *fp = stdin, *fpe = NULL;
-   Boolean aveflag = AVEFLAG;
+   Boolean aveflag = AVEFLAG, stats = STATS;
    double lambda = LAMBDA, step = STEP, tau = TAU, eps = EPS,
        *c, *e, *ep, *cc, *d, *avec, x, ll, gg, tt, mu, ttx;
 
@@ -199,6 +205,13 @@ int main(int argc, char **argv)
             eps = atof(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -227,6 +240,8 @@ int main(int argc, char **argv)
    step /= (double) m;
    tt = 2 * (1.0 - tau);
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("analysis");
    while (freadf(&x, sizeof(x), 1, fp) == 1) {
       for (i = 1; i <= m; i++)
          cc[i] = -c[i];
@@ -258,6 +273,7 @@ int main(int argc, char **argv)
 
       if (--j == 0) {
          j = period;
+         stats_frame(period, !cepwarm_valid(c, m));
          if (aveflag) {
             for (i = 0; i <= m; i++)
                avec[i] /= period;
@@ -267,5 +283,7 @@ int main(int argc, char **argv)
             fwritef(c, sizeof(*c), m + 1, stdout);
       }
    }
+   stats_close();
+
    return (0);
 }
@@ -67,13 +67,42 @@
 
 void acorr(double *x, int l, double *r, const int np)
 {
-   double d;
-   int k, i;
+   double d0, d1, d2, d3, xi;
+   int k, i, n;
 
-   for (k = 0; k <= np; k++) {
-      for (d = 0.0, i = 0; i < l - k; i++)
-         d += x[i] * x[i + k];
-      r[k] = d;
+   /* four lags at a time so that each sample is loaded once per group */
+   for (k = 0; k + 3 <= np; k += 4) {
+      d0 = d1 = d2 = d3 = 0.0;
+      n = l - k - 3;
+      for (i = 0; i < n; i++) {
+         xi = x[i];
+         d0 += xi * x[i + k];
+         d1 += xi * x[i + k + 1];
+         d2 += xi * x[i + k + 2];
+         d3 += xi * x[i + k + 3];
+      }
+      for (; i < l - k - 2; i++) {
+         xi = x[i];
+         d0 += xi * x[i + k];
+         d1 += xi * x[i + k + 1];
+         d2 += xi * x[i + k + 2];
+      }
+      for (; i < l - k - 1; i++) {
+         xi = x[i];
+         d0 += xi * x[i + k];
+         d1 += xi * x[i + k + 1];
+      }
+      for (; i < l - k; i++)
+         d0 += x[i] * x[i + k];
+      r[k] = d0;
+      r[k + 1] = d1;
+      r[k + 2] = d2;
+      r[k + 3] = d3;
+   }
+   for (; k <= np; k++) {
+      for (d0 = 0.0, i = 0; i < l - k; i++)
+         d0 += x[i] * x[i + k];
+      r[k] = d0;
    }
 
    return;
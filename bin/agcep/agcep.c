@@ -61,6 +61,8 @@
 *               -s       :  output smoothed generalized cepstrum   [FALSE]    *
 *               -n       :  output normalized generalized cepstrum [FALSE]    *
 *               -e e     :  minimum value for epsilon              [0]        *
+*               --stats  :  write statistics to stderr             [FALSE]    *
+*                           as JSON lines                                     *
 *       infile:                                                               *
 *               data sequence                                                 *
 *                   , x(0), x(1), ...                                         *
@@ -71,7 +73,7 @@
 *               prediction error (if pefile is specified)                     *
 *                   , e(0), e(1), ...                                         *  
 *       require:                                                              *
-*               iglsadf1(), ignorm()                                          *
+*               iglsadf1(), ignorm(), cepwarm_valid(), stats_open()           *
 *                                                                             *
 ******************************************************************************/
 
@@ -109,6 +111,7 @@ static char *rcs_id = "$Id: agcep.c,v 1.30 2014/12/11 08:30:28 uratec Exp $";
 #define NORM FA
 #define TAU 0.9
 #define EPS 0.0
+#define STATS FA
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -149,6 +152,10 @@ void usage(int status)
            BOOL[NORM]);
    fprintf(stderr,
            "       -e e  : minimum value for epsilon              [%g]\n", EPS);
+   fprintf(stderr,
+           "       --stats : write statistics to stderr             [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  stdin:\n");
    fprintf(stderr, "       data sequence (%s)\n", FORMAT);
@@ -170,7 +177,7 @@ int main(int argc, char **argv)
 {
    int m = ORDER, period = PERIOD, stage = STAGE, i, j;
    FILE *fp = stdin, *fpe = NULL;
-   Boolean ave = AVERAGE, norm = NORM;
+   Boolean ave = AVERAGE, norm = NORM, stats = STATS;
    double lambda = LAMBDA, step = STEP, eps = EPS,
        *c, *cc, *eg, *ep, *d, *avec, tau = TAU,
        x, ee, ll, gg, mu, gamma, tt, ttx;
@@ -216,6 +223,13 @@ int main(int argc, char **argv)
             eps = atof(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -245,6 +259,8 @@ int main(int argc, char **argv)
    step /= (double) m;
    tt = 2 * (1.0 - tau);
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("analysis");
    while (freadf(&x, sizeof(x), 1, fp) == 1) {
       eg[m] = d[stage * m - 1];
       x = iglsadf1(x, c, m, stage, d);
@@ -273,6 +289,7 @@ int main(int argc, char **argv)
 
       if (--j == 0) {
          j = period;
+         stats_frame(period, !cepwarm_valid(c, m));
          if (ave) {
             for (i = 0; i <= m; i++)
                avec[i] /= period;
@@ -287,5 +304,7 @@ int main(int argc, char **argv)
             fwritef(c, sizeof(*c), m + 1, stdout);
       }
    }
+   stats_close();
+
    return (0);
 }
@@ -58,6 +58,8 @@
 *               -s       :  output smoothed mel cepstrum     [FALSE]    *
 *               -e e     :  minimum value for epsilon        [0]        *
 *               -P P     :  order of Pade approximation      [4]        *
+*               --stats  :  write statistics to stderr       [FALSE]    *
+*                           as JSON lines                               *
 *       infile:                                                         *
 *               data sequence                                           *
 *                   , x(0), x(1), ...                                   *
@@ -70,7 +72,7 @@
 *       notice:                                                         *
 *               P = 4 or 5                                              *
 *       require:                                                        *  
-*               mlsadf()                                                *
+*               mlsadf(), cepwarm_valid(), stats_open()                 *
 *                                                                       *
 ************************************************************************/
 
@@ -109,6 +111,7 @@ static char *rcs_id = "$Id: amcep.c,v 1.28 2014/12/11 08:30:30 uratec Exp $";
 #define PEFLAG FA
 #define EPS 0.0
 #define PADEORDER 4
+#define STATS FA
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -139,6 +142,9 @@ void usage(int status)
    fprintf(stderr, "       -e e  : minimum value for epsilon     [%g]\n", EPS);
    fprintf(stderr, "       -P P  : order of Pade approximation   [%d]\n",
            PADEORDER);
+   fprintf(stderr, "       --stats : write statistics to stderr    [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  stdin:\n");
    fprintf(stderr, "       data sequence (%s)\n", FORMAT);
@@ -162,7 +168,7 @@ int main(int argc, char **argv)
 {
    int m = ORDER, period = PERIOD, pd = PADEORDER, i, j;
    FILE *fp = stdin, *fpe = NULL;
-   Boolean aveflag = AVEFLAG;
+   Boolean aveflag = AVEFLAG, stats = STATS;
    double alpha = ALPHA, lambda = LAMBDA, tau = TAU, step = STEP, eps = EPS,
        *mc, *b, *ep, *e, *bb, *d, *avemc, x, xx, ll, tt, gg, mu, ttx;
 
@@ -208,6 +214,13 @@ int main(int argc, char **argv)
             eps = atof(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -238,6 +251,8 @@ int main(int argc, char **argv)
    step /= (double) m;
    xx = 0.0;
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("analysis");
    while (freadf(&x, sizeof(x), 1, fp) == 1) {
       for (i = 1; i <= m; i++)
          bb[i] = -b[i];
@@ -269,6 +284,7 @@ int main(int argc, char **argv)
 
       if (--j == 0) {
          j = period;
+         stats_frame(period, !cepwarm_valid(b, m));
          if (aveflag) {
             for (i = 0; i <= m; i++)
                avemc[i] /= period;
@@ -278,5 +294,7 @@ int main(int argc, char **argv)
             fwritef(mc, sizeof(*mc), m + 1, stdout);
       }
    }
+   stats_close();
+
    return (0);
 }
@@ -0,0 +1,749 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/************************************************************************
+*                                                                       *
+*    Run a Pipeline of SPTK Commands over a List of Files               *
+*                                                                       *
+*       usage:                                                          *
+*               batch [ options ] pipe listfile                         *
+*       options:                                                        *
+*               -j j     :  number of worker processes          [1]     *
+*               -o o     :  output directory                    [.]     *
+*               -e e     :  extension of output files           [out]   *
+*               -s s     :  report files taking more than s     [3.0]   *
+*                           times the median time                       *
+*               -c c     :  cache directory                     [N/A]   *
+*               -C C     :  maximum size of cache (MB)          [0]     *
+*                           (0: no limit)                               *
+*               -d       :  pass double precision values        [FALSE] *
+*                           between stages                              *
+*               -v       :  print time of every file            [FALSE] *
+*       pipe:                                                           *
+*               commands separated by '|' as in pipeline, e.g.          *
+*               'x2x +sf | frame -l 400 -p 80 | window -l 400 -L 512 |  *
+*                mcep -m 24 -a 0.42 -l 512'                             *
+*       listfile:                                                       *
+*               one input file per line, optionally followed by the     *
+*               output file; otherwise the output is written to         *
+*               o/(input name without extension).e                      *
+*       stderr:                                                         *
+*               failed files, throughput and slowest files              *
+*       notes:                                                          *
+*               The pipeline is parsed once and reset for each file,    *
+*               so tables are built only once per worker.  Workers      *
+*               take the next file as soon as they finish one, and      *
+*               each output file depends only on its input.  With -c,   *
+*               results are looked up by the pipeline and the input     *
+*               bytes, and the least recently used ones are removed     *
+*               beyond -C; several runs may share one cache directory.  *
+*               A file whose worker process dies is reported as failed. *
+*       require:                                                        *
+*               pipeline_init(), pipeline_reset(), pipeline_push(),     *
+*               pipeline_flush(), cache_open(), cache_key(),            *
+*               cache_update(), cache_get(), cache_put()                *
+*                                                                       *
+************************************************************************/
+
+static char *rcs_id = "$Id$";
+
+
+/*  Standard C Libraries  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#else
+#  include <strings.h>
+#  ifndef HAVE_STRRCHR
+#     define strrchr rindex
+#  endif
+#endif
+
+#ifndef WIN32
+#  include <unistd.h>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <sys/time.h>
+#  include <poll.h>
+#  include <signal.h>
+#  include <errno.h>
+#endif
+
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+/*  Default Values  */
+#define NWORKER 1
+#define ODIR "."
+#define EXT "out"
+#define STRAGGLER 3.0
+#define DOUBLE FA
+#define VERBOSE FA
+#define CLIMIT 0.0
+
+/*  Command Name  */
+char *cmnd;
+char *BOOL[] = { "FALSE", "TRUE" };
+
+/* result of one file */
+typedef struct _JobResult {
+   int idx;                     /* index in list */
+   int status;                  /* 0: done, 1: read, 2: write, 3: pipeline,
+                                   4: worker died */
+   int hit;                     /* taken from cache */
+   long nin;                    /* number of input values */
+   long nout;                   /* number of output values */
+   double sec;                  /* processing time */
+} JobResult;
+
+char *failure[] = {
+   "", "Cannot read file", "Cannot write file", "Pipeline failed on",
+   "Worker process died on"
+};
+
+
+void usage(int status)
+{
+   fprintf(stderr, "\n");
+   fprintf(stderr, " %s - run a pipeline of SPTK commands over a list of files\n",
+           cmnd);
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  usage:\n");
+   fprintf(stderr, "       %s [ options ] pipe listfile\n", cmnd);
+   fprintf(stderr, "  options:\n");
+   fprintf(stderr,
+           "       -j j  : number of worker processes                  [%d]\n",
+           NWORKER);
+   fprintf(stderr,
+           "       -o o  : output directory                            [%s]\n",
+           ODIR);
+   fprintf(stderr,
+           "       -e e  : extension of output files                   [%s]\n",
+           EXT);
+   fprintf(stderr,
+           "       -s s  : report files taking more than s times the   [%g]\n",
+           STRAGGLER);
+   fprintf(stderr, "               median time\n");
+   fprintf(stderr,
+           "       -c c  : cache directory                             [N/A]\n");
+   fprintf(stderr,
+           "       -C C  : maximum size of cache (MB, 0: no limit)     [%g]\n",
+           CLIMIT);
+   fprintf(stderr,
+           "       -d    : pass double precision values between stages [%s]\n",
+           BOOL[DOUBLE]);
+   fprintf(stderr,
+           "       -v    : print time of every file                    [%s]\n",
+           BOOL[VERBOSE]);
+   fprintf(stderr, "       -h    : print this message\n");
+   fprintf(stderr, "  pipe:\n");
+   fprintf(stderr, "       commands separated by '|' as in pipeline\n");
+   fprintf(stderr, "  listfile:\n");
+   fprintf(stderr,
+           "       one input file per line, optionally followed by the output\n");
+   fprintf(stderr,
+           "       file; otherwise o/(input name without extension).e\n");
+   fprintf(stderr, "  stderr:\n");
+   fprintf(stderr, "       failed files, throughput and slowest files\n");
+   fprintf(stderr, "  note:\n");
+   fprintf(stderr,
+           "       without fork() (e.g. on Windows), -j is ignored\n");
+#ifdef PACKAGE_VERSION
+   fprintf(stderr, "\n");
+   fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
+   fprintf(stderr, " CVS Info: %s", rcs_id);
+#endif
+   fprintf(stderr, "\n");
+   exit(status);
+}
+
+static double now(void)
+{
+#ifndef WIN32
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return ((double) tv.tv_sec + 1e-6 * (double) tv.tv_usec);
+#else
+   return ((double) clock() / CLOCKS_PER_SEC);
+#endif
+}
+
+static size_t type_size(const char type)
+{
+   switch (type) {
+   case 'c':
+   case 'C':
+      return (sizeof(char));
+   case 's':
+   case 'S':
+      return (sizeof(short));
+   case 'i':
+   case 'I':
+      return (sizeof(int));
+   case 'd':
+      return (sizeof(double));
+   default:
+      return (sizeof(float));
+   }
+}
+
+static void to_double(const char type, const void *raw, double *x,
+                      const long n, const Boolean dbl)
+{
+   long i;
+
+   switch (type) {
+   case 'c':
+      for (i = 0; i < n; i++)
+         x[i] = ((signed char *) raw)[i];
+      break;
+   case 'C':
+      for (i = 0; i < n; i++)
+         x[i] = ((unsigned char *) raw)[i];
+      break;
+   case 's':
+      for (i = 0; i < n; i++)
+         x[i] = ((short *) raw)[i];
+      break;
+   case 'S':
+      for (i = 0; i < n; i++)
+         x[i] = ((unsigned short *) raw)[i];
+      break;
+   case 'i':
+      for (i = 0; i < n; i++)
+         x[i] = ((int *) raw)[i];
+      break;
+   case 'I':
+      for (i = 0; i < n; i++)
+         x[i] = ((unsigned int *) raw)[i];
+      break;
+   case 'd':
+      for (i = 0; i < n; i++)
+         x[i] = dbl ? ((double *) raw)[i] : (float) ((double *) raw)[i];
+      break;
+   default:
+      for (i = 0; i < n; i++)
+         x[i] = ((float *) raw)[i];
+      break;
+   }
+}
+
+/* output values of one file */
+static double *result = NULL;
+static int nresult = 0, rsize = 0;
+
+static void keep(const double *y, const int n)
+{
+   double *z;
+
+   if (nresult + n > rsize) {
+      rsize = 2 * (nresult + n);
+      z = dgetmem(rsize);
+      if (result != NULL) {
+         memcpy(z, result, sizeof(*z) * nresult);
+         free(result);
+      }
+      result = z;
+   }
+   memcpy(result + nresult, y, sizeof(*y) * n);
+   nresult += n;
+}
+
+/* output values in the output type; returns the number of bytes */
+static size_t to_bytes(const char type, const double *y, const int n,
+                       char **b)
+{
+   static float *f = NULL;
+   static int size = 0;
+   int i;
+
+   if (type == 'd') {
+      *b = (char *) y;
+      return (sizeof(*y) * n);
+   }
+   if (n > size) {
+      if (f != NULL)
+         free(f);
+      size = n;
+      f = fgetmem(size);
+   }
+   for (i = 0; i < n; i++)
+      f[i] = (float) y[i];
+   *b = (char *) f;
+
+   return (sizeof(*f) * n);
+}
+
+/* read a whole file, run it through the pipeline (or take the result
+   from the cache) and write the output */
+static void run_job(PIPELINE * p, char *in, char *out, const Boolean dbl,
+                    Cache * c, const char *key, JobResult * r)
+{
+   static char *raw = NULL;
+   static double *x = NULL;
+   static long size = 0;
+   const size_t ts = type_size(p->itype);
+   long n;
+   int k;
+   size_t nb;
+   char *b;
+   double *y;
+   FILE *fp;
+
+   r->sec = now();
+   r->status = 0;
+   r->hit = 0;
+   r->nin = r->nout = 0;
+
+   if ((fp = fopen(in, "rb")) == NULL || fseek(fp, 0L, SEEK_END) != 0
+       || (n = ftell(fp)) < 0) {
+      if (fp != NULL)
+         fclose(fp);
+      r->status = 1;
+      r->sec = now() - r->sec;
+      return;
+   }
+   n /= (long) ts;
+   rewind(fp);
+   if (n > size) {
+      if (x != NULL) {
+         free(raw);
+         free(x);
+      }
+      size = n;
+      raw = (char *) getmem(size, ts);
+      x = dgetmem(size);
+   }
+   n = fread(raw, ts, n, fp);
+   fclose(fp);
+   r->nin = n;
+
+   if (c != NULL) {
+      cache_key(c, key);
+      cache_update(c, raw, ts * n);
+      r->hit = (cache_get(c, (void **) &b, &nb) == 0);
+   }
+   if (!r->hit) {
+      to_double(p->itype, raw, x, n, dbl);
+      pipeline_reset(p);
+      nresult = 0;
+      if ((k = pipeline_push(p, x, (int) n, &y)) >= 0) {
+         keep(y, k);
+         k = pipeline_flush(p, &y);
+      }
+      if (k < 0) {
+         r->status = 3;
+         r->sec = now() - r->sec;
+         return;
+      }
+      keep(y, k);
+      nb = to_bytes(p->otype, result, nresult, &b);
+      if (c != NULL)
+         cache_put(c, b, nb);
+   }
+
+   r->nout = nb / ((p->otype == 'd') ? sizeof(double) : sizeof(float));
+   if ((fp = fopen(out, "wb")) == NULL || fwrite(b, 1, nb, fp) != nb)
+      r->status = 2;
+   if (fp != NULL && fclose(fp) != 0)
+      r->status = 2;
+   r->sec = now() - r->sec;
+}
+
+/* read list of "infile [outfile]" lines */
+static int read_list(char *name, char ***in, char ***out, char *dir,
+                     char *ext)
+{
+   FILE *fp = getfp(name, "r");
+   char *buf, *s, *t, *base, *dot;
+   long len = 0, size = 4096;
+   int n = 0, k;
+
+   buf = (char *) getmem(size + 1, sizeof(*buf));
+   while ((k = fread(buf + len, 1, size - len, fp)) > 0)
+      if ((len += k) == size) {
+         s = (char *) getmem(2 * size + 1, sizeof(*s));
+         memcpy(s, buf, len);
+         free(buf);
+         buf = s;
+         size *= 2;
+      }
+   buf[len] = '\0';
+   fclose(fp);
+
+   for (s = buf; *s != '\0'; s++)
+      if (*s == '\n')
+         n++;
+   *in = (char **) getmem(n + 1, sizeof(**in));
+   *out = (char **) getmem(n + 1, sizeof(**out));
+
+   for (n = 0, s = strtok(buf, "\n"); s != NULL; s = strtok(NULL, "\n")) {
+      while (*s == ' ' || *s == '\t')
+         s++;
+      if (*s == '\0' || *s == '#' || *s == '\r')
+         continue;
+      (*in)[n] = s;
+      for (t = s; *t != '\0' && *t != ' ' && *t != '\t' && *t != '\r'; t++);
+      if (*t != '\0')
+         *t++ = '\0';
+      while (*t == ' ' || *t == '\t')
+         t++;
+      if (*t != '\0' && *t != '\r') {
+         (*out)[n] = t;
+         for (; *t != '\0' && *t != ' ' && *t != '\t' && *t != '\r'; t++);
+         *t = '\0';
+      } else {
+         if ((base = strrchr(s, '/')) == NULL)
+            base = s;
+         else
+            base++;
+         if ((dot = strrchr(base, '.')) == NULL || dot == base)
+            dot = base + strlen(base);
+         (*out)[n] =
+             (char *) getmem(strlen(dir) + (dot - base) + strlen(ext) + 3,
+                             sizeof(char));
+         sprintf((*out)[n], "%s/%.*s.%s", dir, (int) (dot - base), base, ext);
+      }
+      n++;
+   }
+
+   return (n);
+}
+
+#ifndef WIN32
+static int read_all(const int fd, void *buf, const size_t n)
+{
+   size_t k = 0;
+   ssize_t r;
+
+   while (k < n) {
+      if ((r = read(fd, (char *) buf + k, n - k)) <= 0)
+         return (-1);
+      k += r;
+   }
+
+   return (0);
+}
+
+/* each worker takes one file at a time on its own pipes, so that a
+   worker which dies is seen at the end of its result pipe and only
+   the file it was running fails */
+static void run_workers(PIPELINE * p, char **in, char **out, const int nfile,
+                        const int nworker, const Boolean dbl, Cache * c,
+                        const char *key, JobResult * res)
+{
+   int task[2], done[2], *tfd, *cur, w, v, next = 0, nbusy = 0, k;
+   struct pollfd *fds;
+   JobResult r;
+
+   tfd = (int *) getmem(nworker, sizeof(*tfd));
+   cur = (int *) getmem(nworker, sizeof(*cur));
+   fds = (struct pollfd *) getmem(nworker, sizeof(*fds));
+
+   for (w = 0; w < nworker; w++) {
+      if (pipe(task) != 0 || pipe(done) != 0) {
+         fprintf(stderr, "%s : Cannot create pipe!\n", cmnd);
+         exit(1);
+      }
+      switch (fork()) {
+      case -1:
+         fprintf(stderr, "%s : Cannot create worker process!\n", cmnd);
+         exit(1);
+      case 0:
+         for (v = 0; v < w; v++) {
+            close(tfd[v]);
+            close(fds[v].fd);
+         }
+         close(task[1]);
+         close(done[0]);
+         while (read_all(task[0], &k, sizeof(k)) == 0) {
+            run_job(p, in[k], out[k], dbl, c, key, &r);
+            r.idx = k;
+            if (write(done[1], &r, sizeof(r)) != sizeof(r))
+               _exit(1);
+         }
+         _exit(0);
+      default:
+         break;
+      }
+      close(task[0]);
+      close(done[1]);
+      tfd[w] = task[1];
+      fds[w].fd = done[0];
+      fds[w].events = POLLIN;
+      cur[w] = -1;
+   }
+
+   /* a worker that is gone makes write() fail instead of killing us */
+   signal(SIGPIPE, SIG_IGN);
+
+   for (;;) {
+      for (w = 0; w < nworker && next < nfile; w++) {
+         if (fds[w].fd < 0 || cur[w] >= 0)
+            continue;
+         if (write(tfd[w], &next, sizeof(next)) == sizeof(next)) {
+            cur[w] = next++;
+            nbusy++;
+         } else {
+            close(tfd[w]);
+            close(fds[w].fd);
+            fds[w].fd = -1;
+         }
+      }
+      if (nbusy == 0)
+         break;
+
+      if (poll(fds, nworker, -1) < 0) {
+         if (errno == EINTR)
+            continue;
+         fprintf(stderr, "%s : Cannot wait for worker processes!\n", cmnd);
+         exit(1);
+      }
+      for (w = 0; w < nworker; w++) {
+         if (fds[w].fd < 0 || fds[w].revents == 0)
+            continue;
+         if (read_all(fds[w].fd, &r, sizeof(r)) == 0 && r.idx == cur[w])
+            res[r.idx] = r;
+         else {
+            close(tfd[w]);
+            close(fds[w].fd);
+            fds[w].fd = -1;
+            if (cur[w] < 0)
+               continue;
+            res[cur[w]].idx = cur[w];
+            res[cur[w]].status = 4;
+         }
+         cur[w] = -1;
+         nbusy--;
+      }
+   }
+
+   /* files left when every worker has died */
+   for (; next < nfile; next++) {
+      res[next].idx = next;
+      res[next].status = 4;
+   }
+
+   for (w = 0; w < nworker; w++)
+      if (fds[w].fd >= 0) {
+         close(tfd[w]);
+         close(fds[w].fd);
+      }
+   while (wait(NULL) > 0);
+
+   free(tfd);
+   free(cur);
+   free(fds);
+}
+#endif
+
+static int cmp_sec(const void *a, const void *b)
+{
+   const double x = *(const double *) a, y = *(const double *) b;
+
+   return ((x > y) - (x < y));
+}
+
+int main(int argc, char **argv)
+{
+   char *spec = NULL, *list = NULL, *dir = ODIR, *ext = EXT, **in, **out,
+       *cdir = NULL, *key;
+   int nfile, nworker = NWORKER, nfail = 0, nok, nhit = 0, k;
+   double thr = STRAGGLER, climit = CLIMIT, start, wall, cpu = 0.0, nin =
+       0.0, nout = 0.0, *sec, median;
+   Boolean dbl = DOUBLE, verbose = VERBOSE;
+   JobResult *res;
+   PIPELINE p;
+   Cache cache, *cp = NULL;
+
+   if ((cmnd = strrchr(argv[0], '/')) == NULL)
+      cmnd = argv[0];
+   else
+      cmnd++;
+
+   while (--argc)
+      if (**++argv == '-' && *(*argv + 1) != '\0' && spec == NULL) {
+         switch (*(*argv + 1)) {
+         case 'j':
+            nworker = atoi(*++argv);
+            --argc;
+            break;
+         case 'o':
+            dir = *++argv;
+            --argc;
+            break;
+         case 'e':
+            ext = *++argv;
+            --argc;
+            break;
+         case 's':
+            thr = atof(*++argv);
+            --argc;
+            break;
+         case 'c':
+            cdir = *++argv;
+            --argc;
+            break;
+         case 'C':
+            climit = atof(*++argv);
+            --argc;
+            break;
+         case 'd':
+            dbl = 1 - dbl;
+            break;
+         case 'v':
+            verbose = 1 - verbose;
+            break;
+         case 'h':
+            usage(0);
+         default:
+            fprintf(stderr, "%s : Invalid option '%c'!\n", cmnd, *(*argv + 1));
+            usage(1);
+         }
+      } else if (spec == NULL)
+         spec = *argv;
+      else
+         list = *argv;
+
+   if (spec == NULL || list == NULL) {
+      fprintf(stderr, "%s : Pipeline and list of files must be given!\n",
+              cmnd);
+      usage(1);
+   }
+   if (nworker < 1) {
+      fprintf(stderr, "%s : Number of workers must be positive!\n", cmnd);
+      usage(1);
+   }
+   if (pipeline_init(&p, spec, 1 - dbl) < 0) {
+      fprintf(stderr, "%s : Cannot run '%s' in pipeline!\n", cmnd, p.err);
+      usage(1);
+   }
+
+   /* results are cached under the pipeline and the input bytes */
+   key = getmem(strlen(spec) + 64, sizeof(*key));
+#ifdef PACKAGE_VERSION
+   sprintf(key, "SPTK %s batch %s%s", PACKAGE_VERSION, spec,
+           (dbl) ? " -d" : "");
+#else
+   sprintf(key, "SPTK batch %s%s", spec, (dbl) ? " -d" : "");
+#endif
+   if (cdir != NULL) {
+      cache_open(&cache, cdir, (long) (climit * 1024 * 1024));
+      cp = &cache;
+   }
+
+   nfile = read_list(list, &in, &out, dir, ext);
+   res = (JobResult *) getmem(nfile + 1, sizeof(*res));
+   if (nworker > nfile)
+      nworker = (nfile > 0) ? nfile : 1;
+
+   start = now();
+#ifndef WIN32
+   if (nworker > 1)
+      run_workers(&p, in, out, nfile, nworker, dbl, cp, key, res);
+   else
+#endif
+   {
+      nworker = 1;
+      for (k = 0; k < nfile; k++) {
+         run_job(&p, in[k], out[k], dbl, cp, key, res + k);
+         res[k].idx = k;
+      }
+   }
+   wall = now() - start;
+
+   /* report */
+   sec = dgetmem(nfile + 1);
+   for (k = 0, nok = 0; k < nfile; k++) {
+      if (res[k].status != 0) {
+         fprintf(stderr, "%s : %s %s!\n", cmnd, failure[res[k].status],
+                 (res[k].status == 2) ? out[k] : in[k]);
+         nfail++;
+         continue;
+      }
+      if (verbose)
+         fprintf(stderr, "%s : %s -> %s %.3f sec%s\n", cmnd, in[k], out[k],
+                 res[k].sec, (res[k].hit) ? " (cached)" : "");
+      sec[nok++] = res[k].sec;
+      nhit += res[k].hit;
+      cpu += res[k].sec;
+      nin += res[k].nin;
+      nout += res[k].nout;
+   }
+   fprintf(stderr, "%s : %d files (%d failed), %.0f input values, %.0f output values\n",
+           cmnd, nfile, nfail, nin, nout);
+   if (cp != NULL)
+      fprintf(stderr, "%s : %d files taken from cache %s\n", cmnd, nhit,
+              cdir);
+   if (wall > 0.0)
+      fprintf(stderr,
+              "%s : %.3f sec with %d workers, %.1f files/sec, %.3g input values/sec\n",
+              cmnd, wall, nworker, nfile / wall, nin / wall);
+   if (nok > 0) {
+      qsort(sec, nok, sizeof(*sec), cmp_sec);
+      median = sec[nok / 2];
+      fprintf(stderr,
+              "%s : %.3f sec per file (median %.3f sec, maximum %.3f sec)\n",
+              cmnd, cpu / nok, median, sec[nok - 1]);
+      for (k = 0; k < nfile; k++)
+         if (res[k].status == 0 && res[k].sec > thr * median
+             && res[k].sec > 0.0)
+            fprintf(stderr, "%s : straggler %s %.3f sec\n", cmnd, in[k],
+                    res[k].sec);
+   }
+
+   pipeline_free(&p);
+   if (cp != NULL)
+      cache_close(cp);
+
+   return ((nfail > 0) ? 1 : 0);
+}
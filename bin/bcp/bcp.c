@@ -110,6 +110,7 @@ static char *rcs_id = "$Id: bcp.c,v 1.30 2014/12/11 08:30:31 uratec Exp $";
 #define ITEM 512
 #define DITEM 0
 #define FILL 0.0
+#define BLOCK 4096              /* number of blocks copied at a time */
 
 
 /*  Command Name  */
@@ -364,8 +365,8 @@ int main(int argc, char **argv)
 
 void bcp(FILE * fp)
 {
-   char *buf, *lz = NULL, *fz = NULL;
-   int ibytes, obytes, offset, nlz, nfz;
+   char *buf, *out, *p;
+   int ibytes, obytes, offset, nlz, nfz, nbytes, i, n;
    void acopy(FILE * fp);
    void filln(char *ptr, int size, int nitem);
 
@@ -429,27 +430,24 @@ void bcp(FILE * fp)
    obytes = size * (eno - sno);
    nlz = size * dsno;
    nfz = ((nfz = size * dnitems - nlz - obytes) < 0) ? 0 : nfz;
+   nbytes = nlz + obytes + nfz;
 
-   if ((buf = (char *) dgetmem(ibytes + nlz + nfz)) == NULL)
+   if ((buf = (char *) getmem(BLOCK, ibytes + nbytes)) == NULL)
       return;
+   out = buf + BLOCK * ibytes;
 
-   if (nlz) {
-      lz = buf + ibytes;
-      filln(lz, size, nlz);
-   }
-
-   if (nfz) {
-      fz = buf + ibytes + nlz;
-      filln(fz, size, nfz);
-   }
-
-   while (freadx(buf, sizeof(*buf), ibytes, fp) == ibytes) {
+   /* leading and trailing fill of every output block */
+   for (i = 0, p = out; i < BLOCK; i++, p += nbytes) {
       if (nlz)
-         fwritex(lz, sizeof(*lz), nlz, stdout);
-      fwritex(buf + offset, sizeof(*buf), obytes, stdout);
-
+         filln(p, size, nlz);
       if (nfz)
-         fwritex(fz, sizeof(*fz), nfz, stdout);
+         filln(p + nlz + obytes, size, nfz);
+   }
+
+   while ((n = freadx(buf, ibytes, BLOCK, fp)) > 0) {
+      for (i = 0, p = out + nlz; i < n; i++, p += nbytes)
+         memcpy(p, buf + i * ibytes + offset, obytes);
+      fwritex(out, nbytes, n, stdout);
    }
 }
 
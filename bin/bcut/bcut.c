@@ -103,6 +103,7 @@ static char *rcs_id = "$Id: bcut.c,v 1.32 2014/12/11 08:30:31 uratec Exp $";
 #define START 0
 #define END -1
 #define LENG 1
+#define BLOCK 4096              /* number of items copied at a time */
 
 #define SIGNED_INT3 FA
 #define UNSIGNED_INT3 FA
@@ -171,10 +172,10 @@ int main(int argc, char **argv)
    int n = LENG;
    long long start = START, end = END, ptr;
    FILE *fp = stdin;
-   char *s, c;
+   char *s, *buf, *p, c;
+   int i, k;
    Boolean int3flg = SIGNED_INT3, uint3flg = UNSIGNED_INT3;
    long int y = 0, z = 0;
-   long double x;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -273,23 +274,31 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   ptr = start * n;
-   while (ptr--)
-      if (freadx(&x, size, 1, fp) != 1)
+   buf = (char *) getmem(BLOCK, size);
+
+   /* skip first start * n items */
+   for (ptr = start * n; ptr != 0; ptr -= k) {
+      k = (ptr < 0 || ptr > BLOCK) ? BLOCK : (int) ptr;
+      if (freadx(buf, size, k, fp) != k)
          return (0);
+   }
 
-   ptr = (end - start + 1) * n;
-   while (end == -1 || ptr--) {
-      if (freadx(&x, size, 1, fp) != 1)
+   /* copy (end - start + 1) * n items; negative count copies until EOF */
+   for (ptr = (end == -1) ? -1 : (end - start + 1) * n; ptr != 0; ptr -= k) {
+      k = (ptr < 0 || ptr > BLOCK) ? BLOCK : (int) ptr;
+      if ((k = freadx(buf, size, k, fp)) == 0)
          break;
-      if (int3flg == TR || uint3flg == TR) {
-         memcpy(&z, &x, size);
-         y = z & 0x00FFFFFF;
-         if (int3flg == TR && y >> 23 == 1)
-            y = y | 0xFF000000;
-         fwritex(&y, size, 1, stdout);
-      } else
-         fwritex(&x, size, 1, stdout);
+      if (int3flg == TR || uint3flg == TR)
+         for (i = 0, p = buf; i < k; i++, p += size) {
+            memcpy(&z, p, size);
+            y = z & 0x00FFFFFF;
+            if (int3flg == TR && y >> 23 == 1)
+               y = y | 0xFF000000;
+            memcpy(p, &y, size);
+         }
+      fwritex(buf, size, k, stdout);
+      if (ptr < 0)
+         k = 0;
    }
 
    return (0);
@@ -48,16 +48,27 @@
     Transform cepstrum to spectrum
 
         void   c2sp(c, m, sp, y, l)
+        void   c2sp_batch(c, m, x, y, l, nfrm)
 
         double   *c  : cepstrum
         int      m   : order of cepstrum
         double   *x  : real part of spectrum
         double   *y  : imaginary part of spectrum
         double   l   : FFT length
+        int      nfrm: number of frames
+
+    c2sp_batch() transforms nfrm frames of (m+1) coefficients into
+    nfrm frames of the first l/2+1 bins of the spectrum.  For low
+    orders the transform is done by one matrix product with a
+    cached (m+1) x (l/2+1) table of cosines and sines, which is
+    cheaper than zero-padding every frame to l points; otherwise
+    every frame is transformed by fftr().
 
 ***************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 
 #if defined(WIN32)
 #  include "SPTK.h"
@@ -65,6 +76,8 @@
 #  include <SPTK.h>
 #endif
 
+#define C2SP_DIRECT 8           /* maximum order for the matrix product */
+
 void c2sp(double *c, const int m, double *x, double *y, const int l)
 {
    int m1;
@@ -76,3 +89,60 @@ void c2sp(double *c, const int m, double *x, double *y, const int l)
 
    fftr(x, y, l);
 }
+
+static double *c2sp_table(const int m, const int l)
+{
+   int j, k, no, isnew;
+   double w, *t;
+
+   no = l / 2 + 1;
+   t = warptab(WARP_C2SP, m, l / 2, l, 0.0, 0.0, (m + 1) * 2 * no, &isnew);
+   if (!isnew)
+      return (t);
+
+   /* row j: real and imaginary parts of exp(-i 2 pi j k / l) */
+   w = PI2 / l;
+   for (j = 0; j <= m; j++)
+      for (k = 0; k < no; k++) {
+         t[j * 2 * no + k] = cos(w * ((j * k) % l));
+         t[j * 2 * no + no + k] = -sin(w * ((j * k) % l));
+      }
+
+   return (t);
+}
+
+void c2sp_batch(double *c, const int m, double *x, double *y, const int l,
+                const int nfrm)
+{
+   int i, no;
+   double *t;
+   static double *buf = NULL;
+   static int size;
+
+   no = l / 2 + 1;
+
+   if (m < C2SP_DIRECT) {
+      t = c2sp_table(m, l);
+      mat_gemm(nfrm, no, m + 1, 1.0, c, m + 1, t, 2 * no, 0.0, x, no);
+      mat_gemm(nfrm, no, m + 1, 1.0, c, m + 1, t + no, 2 * no, 0.0, y, no);
+      return;
+   }
+
+   if (buf == NULL) {
+      buf = dgetmem(l + l);
+      size = l;
+   }
+   if (l > size) {
+      free(buf);
+      buf = dgetmem(l + l);
+      size = l;
+   }
+
+   for (i = 0; i < nfrm; i++) {
+      c2sp(c + i * (m + 1), m, buf, buf + l, l);
+      movem(buf, x + i * no, sizeof(*buf), no);
+      movem(buf + l, y + i * no, sizeof(*buf), no);
+   }
+
+   return;
+}
@@ -103,6 +103,7 @@ static char *rcs_id = "$Id: c2sp.c,v 1.25 2014/12/11 08:30:32 uratec Exp $";
 #define LENG 256
 #define PHASE FA
 #define OTYPE 0
+#define BLOCK 64                /* number of frames transformed at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -146,7 +147,7 @@ void usage(int status)
 
 int main(int argc, char **argv)
 {
-   int leng = LENG, m = ORDER, start = 0, end = 0, otype = OTYPE, i, no;
+   int leng = LENG, m = ORDER, start = 0, end = 0, otype = OTYPE, i, j, n, no;
    FILE *fp = stdin;
    char phase = PHASE;
    double logk, *x, *y, *c;
@@ -193,32 +194,34 @@ int main(int argc, char **argv)
    if (end == 0)
       end = m;
 
-   x = dgetmem(leng * 2);
-   y = x + leng;
-   c = dgetmem(m + 1);
-
    no = leng / 2 + 1;
    logk = 20.0 / log(10.0);
 
-   while (freadf(c, sizeof(*c), m + 1, fp) == m + 1) {
-      fillz(c, sizeof(*c), start);
-      for (i = end + 1; i <= m; i++)
-         c[i] = 0.0;
+   x = dgetmem(BLOCK * (no + no + m + 1));
+   y = x + BLOCK * no;
+   c = y + BLOCK * no;
+
+   while ((n = freadf(c, sizeof(*c), BLOCK * (m + 1), fp) / (m + 1)) > 0) {
+      for (j = 0; j < n; j++) {
+         fillz(c + j * (m + 1), sizeof(*c), start);
+         for (i = end + 1; i <= m; i++)
+            c[j * (m + 1) + i] = 0.0;
+      }
 
-      c2sp(c, m, x, y, leng);
+      c2sp_batch(c, m, x, y, leng, n);
 
       if (phase)
          switch (otype) {
          case 1:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i];
             break;
          case 2:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i] * 180 / PI;
             break;
          default:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i] / PI;
             break;
       } else
@@ -226,16 +229,16 @@ int main(int argc, char **argv)
          case 1:
             break;
          case 2:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = exp(x[i]);
             break;
          default:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] *= logk;
             break;
          }
 
-      fwritef(x, sizeof(*x), no, stdout);
+      fwritef(x, sizeof(*x), n * no, stdout);
    }
 
    return (0);
@@ -42,11 +42,44 @@
 /* POSSIBILITY OF SUCH DAMAGE.                                       */
 /* ----------------------------------------------------------------- */
 
+/****************************************************************
+
+    Discrete Cosine Transform
+
+    void dct(in, out, size, m, dftmode, compmode)
+    void idct(in, out, size, m, dftmode, compmode)
+    int  dft(pReal, pImag, nDFTLength)
+
+    double  *in      : input (real part in[0..size-1],
+                              imaginary part in[size..2size-1])
+    double  *out     : output (real part out[0..m-1],
+                               imaginary part out[size..size+m-1]
+                               if compmode)
+    int     size     : transform size
+    int     m        : number of output values
+    Boolean dftmode  : do not use FFT
+    Boolean compmode : output imaginary part
+
+    dct() is the orthonormal DCT-II and idct() its inverse
+    (DCT-III).  Sizes up to DCT_DIRECT are transformed by a
+    product with the DCT matrix.  Larger powers of 2 use an N
+    point complex FFT of the even/odd reordered sequence with
+    pre- and post-twiddles (real and imaginary parts are packed
+    into one FFT); other sizes (and dftmode) sum directly over a
+    cosine table.  The matrices and cosine tables are built once
+    per size in the warptab() registry and shared by every
+    caller; dft() uses the same cosine table for its twiddles.
+
+    dct_create_table(), dct_create_table_fft(),
+    dct_based_on_dft() and dct_based_on_fft() are kept for
+    compatibility: the first two select the size transformed
+    by the other two.
+
+****************************************************************/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <memory.h>
 
 #if defined(WIN32)
 #  include "SPTK.h"
@@ -54,188 +87,258 @@
 #  include <SPTK.h>
 #endif
 
-/* workspace */
-static int dct_table_size = 0;
-static double *dct_workspace = NULL;
-static double *pLocalReal = NULL;
-static double *pLocalImag = NULL;
-static double *pWeightReal = NULL;
-static double *pWeightImag = NULL;
+#define DCT_DIRECT 64           /* largest size transformed by matrix */
 
+/* sizes selected by dct_create_table() and dct_create_table_fft() */
+static int dct_table_size = 0;
 static int dct_table_size_fft = 0;
-static double *dct_workspace2 = NULL;
-static double *pLocalReal2 = NULL;
-static double *pLocalImag2 = NULL;
-static double *pWeightReal2 = NULL;
-static double *pWeightImag2 = NULL;
 
+/* work buffer */
+static double *work = NULL;
+static int work_size = 0;
 
-int dft(double *pReal, double *pImag, const int nDFTLength)
+static double *dct_work(const int size)
 {
-   int k, n;
-   double *pTempReal, *pTempImag, TempReal, TempImag;
+   if (size > work_size) {
+      if (work != NULL)
+         free(work);
+      work_size = size;
+      work = dgetmem(work_size);
+   }
 
-   pTempReal = dgetmem(nDFTLength);
-   pTempImag = dgetmem(nDFTLength);
+   return (work);
+}
 
-   memcpy(pTempReal, pReal, sizeof(double) * nDFTLength);
-   memcpy(pTempImag, pImag, sizeof(double) * nDFTLength);
+/* cos(PI j / (2 size)), j = 0, ..., 4 size - 1 */
+static double *dct_costab(const int size)
+{
+   int j, isnew;
+   double *t;
 
-   for (k = 0; k < nDFTLength; k++) {
-      TempReal = 0;
-      TempImag = 0;
-      for (n = 0; n < nDFTLength; n++) {
-         TempReal += pTempReal[n] * cos(2.0 * PI * n * k / (double) nDFTLength)
-             + pTempImag[n] * sin(2.0 * PI * n * k / (double) nDFTLength);
-         TempImag += -pTempReal[n] * sin(2.0 * PI * n * k / (double) nDFTLength)
-             + pTempImag[n] * cos(2.0 * PI * n * k / (double) nDFTLength);
-      }
-      pReal[k] = TempReal;
-      pImag[k] = TempImag;
-   }
-   free(pTempReal);
-   free(pTempImag);
+   t = warptab(WARP_DCT, size, 0, 0, 0.0, 0.0, 4 * size, &isnew);
+   if (isnew)
+      for (j = 0; j < 4 * size; j++)
+         t[j] = cos(PI * j / (2.0 * size));
 
-   return (0);
+   return (t);
 }
 
-int dct_create_table_fft(const int nSize)
+/* orthonormal DCT-II matrix, c[k * size + n] */
+static double *dct_matrix(const int size)
+{
+   int k, n, isnew;
+   double *c;
+
+   c = warptab(WARP_DCT, size, size, 0, 0.0, 0.0, size * size, &isnew);
+   if (isnew)
+      for (k = 0; k < size; k++)
+         for (n = 0; n < size; n++)
+            c[k * size + n] = sqrt(((k == 0) ? 1.0 : 2.0) / size)
+                * cos(PI * k * (2 * n + 1) / (2.0 * size));
+
+   return (c);
+}
+
+/* direct transform of one part (x) into m values (y) */
+static void dct_direct(const double *x, double *y, const int size, const int m,
+                       const Boolean inverse)
 {
-   register int k;
-
-   if (nSize == dct_table_size_fft) {
-      /* no needs to resize workspace. */
-      return (0);
-   } else {
-      /* release resources to resize workspace. */
-      if (dct_workspace2 != NULL) {
-         free(dct_workspace2);
-         dct_workspace2 = NULL;
+   int k, n, j, step, size4 = 4 * size;
+   double *c, sum, w0 = sqrt(1.0 / size), w = sqrt(2.0 / size);
+
+   if (size <= DCT_DIRECT) {
+      c = dct_matrix(size);
+      for (k = 0; k < m; k++) {
+         sum = 0.0;
+         if (inverse)
+            for (n = 0; n < size; n++)
+               sum += c[n * size + k] * x[n];
+         else
+            sum = simd_dot(c + k * size, x, size);
+         y[k] = sum;
       }
-      pLocalReal2 = NULL;
-      pLocalImag2 = NULL;
-      pWeightReal2 = NULL;
-      pWeightImag2 = NULL;
+      return;
    }
 
-   /* getting resources. */
-   if (nSize <= 0) {
-      dct_table_size_fft = 0;
-      return (0);
-   } else {
-      dct_table_size_fft = nSize;
-      dct_workspace2 = dgetmem(dct_table_size_fft * 6);
-      pWeightReal2 = dct_workspace2;
-      pWeightImag2 = dct_workspace2 + dct_table_size_fft;
-      pLocalReal2 = dct_workspace2 + (2 * dct_table_size_fft);
-      pLocalImag2 = dct_workspace2 + (4 * dct_table_size_fft);
-
-      for (k = 0; k < dct_table_size_fft; k++) {
-         pWeightReal2[k] =
-             cos(k * PI / (2.0 * dct_table_size_fft)) /
-             sqrt(2.0 * dct_table_size_fft);
-         pWeightImag2[k] =
-             -sin(k * PI / (2.0 * dct_table_size_fft)) /
-             sqrt(2.0 * dct_table_size_fft);
+   c = dct_costab(size);
+   for (k = 0; k < m; k++) {
+      sum = 0.0;
+      if (inverse) {
+         /* y[k] = sum_n w_n x[n] cos(PI n (2k + 1) / (2 size)) */
+         step = 2 * k + 1;
+         for (n = 1, j = step; n < size; n++) {
+            sum += x[n] * c[j];
+            if ((j += step) >= size4)
+               j -= size4;
+         }
+         y[k] = w0 * x[0] + w * sum;
+      } else {
+         /* y[k] = w_k sum_n x[n] cos(PI k (2n + 1) / (2 size)) */
+         step = 2 * k;
+         for (n = 0, j = k; n < size; n++) {
+            sum += x[n] * c[j];
+            if ((j += step) >= size4)
+               j -= size4;
+         }
+         y[k] = ((k == 0) ? w0 : w) * sum;
       }
-      pWeightReal2[0] /= sqrt(2.0);
-      pWeightImag2[0] /= sqrt(2.0);
    }
-
-   return (0);
 }
 
-int dct_create_table(const int nSize)
+/* forward transform by N point FFT (size is a power of 2) */
+static void dct_fft(const double *re, const double *im, double *yr,
+                    double *yi, const int size, const int m)
 {
-   register int k;
-
-   if (nSize == dct_table_size) {
-      /* no needs to resize workspace. */
-      return (0);
-   } else {
-      /* release resources to resize workspace. */
-      if (dct_workspace != NULL) {
-         free(dct_workspace);
-         dct_workspace = NULL;
+   int k, j, n;
+   double *vr, *vi, *c, ar, ai, br, bi, w0 = sqrt(1.0 / size),
+       w = sqrt(2.0 / size), wk;
+
+   vr = dct_work(2 * size);
+   vi = vr + size;
+   for (n = 0; n < size / 2; n++) {
+      vr[n] = re[2 * n];
+      vr[size - 1 - n] = re[2 * n + 1];
+      vi[n] = (im != NULL) ? im[2 * n] : 0.0;
+      vi[size - 1 - n] = (im != NULL) ? im[2 * n + 1] : 0.0;
+   }
+   fft(vr, vi, size);
+
+   c = dct_costab(size);
+   for (k = 0; k < m; k++) {
+      j = (size - k) % size;
+      wk = (k == 0) ? w0 : w;
+      /* spectra of the real (a) and imaginary (b) parts */
+      ar = 0.5 * (vr[k] + vr[j]);
+      ai = 0.5 * (vi[k] - vi[j]);
+      yr[k] = wk * (c[k] * ar + c[size - k] * ai);
+      if (yi != NULL) {
+         br = 0.5 * (vi[k] + vi[j]);
+         bi = 0.5 * (vr[j] - vr[k]);
+         yi[k] = wk * (c[k] * br + c[size - k] * bi);
       }
-      pLocalReal = NULL;
-      pLocalImag = NULL;
-      pWeightReal = NULL;
-      pWeightImag = NULL;
    }
+}
+
+/* inverse transform by N point FFT (size is a power of 2) */
+static void idct_fft(const double *re, const double *im, double *yr,
+                     double *yi, const int size, const int m)
+{
+   int k, j, n;
+   double *vr, *vi, *c, dr, di, er, ei, s0 = sqrt((double) size),
+       s = sqrt(size / 2.0), sk;
 
-   /* getting resources. */
-   if (nSize <= 0) {
-      dct_table_size = 0;
-      return (0);
-   } else {
-      dct_table_size = nSize;
-      dct_workspace = dgetmem(dct_table_size * 6);
-      pWeightReal = dct_workspace;
-      pWeightImag = dct_workspace + dct_table_size;
-      pLocalReal = dct_workspace + (2 * dct_table_size);
-      pLocalImag = dct_workspace + (4 * dct_table_size);
-
-      for (k = 0; k < dct_table_size; k++) {
-         pWeightReal[k] =
-             cos(k * PI / (2.0 * dct_table_size)) / sqrt(2.0 * dct_table_size);
-         pWeightImag[k] =
-             -sin(k * PI / (2.0 * dct_table_size)) / sqrt(2.0 * dct_table_size);
+   vr = dct_work(2 * size);
+   vi = vr + size;
+   c = dct_costab(size);
+   for (k = 0; k < size; k++) {
+      /* V[k] = exp(i PI k / (2 size)) (D[k] - i D[size - k]) */
+      sk = (k == 0) ? s0 : s;
+      dr = sk * re[k];
+      di = (im != NULL) ? sk * im[k] : 0.0;
+      if (k > 0) {
+         j = size - k;
+         dr += s * ((im != NULL) ? im[j] : 0.0);
+         di -= s * re[j];
       }
-      pWeightReal[0] /= sqrt(2.0);
-      pWeightImag[0] /= sqrt(2.0);
+      er = c[k];
+      ei = c[size - k];
+      vr[k] = er * dr - ei * di;
+      vi[k] = ei * dr + er * di;
    }
+   ifft(vr, vi, size);
 
-   return (0);
+   for (n = 0; n < m; n++) {
+      j = (n % 2 == 0) ? n / 2 : size - 1 - n / 2;
+      yr[n] = vr[j];
+      if (yi != NULL)
+         yi[n] = vi[j];
+   }
 }
 
-int dct_based_on_fft(double *pReal, double *pImag, const double *pInReal,
-                     const double *pInImag)
+static Boolean dct_pow2(const int size)
+{
+   return (size >= 4 && (size & (size - 1)) == 0);
+}
+
+static void dct_apply(const double *re, const double *im, double *yr,
+                      double *yi, const int size, const int m,
+                      const Boolean dftmode, const Boolean inverse)
+{
+   /* the kernel is real: the imaginary input only affects yi */
+   if (yi == NULL)
+      im = NULL;
+
+   if (size <= DCT_DIRECT || dftmode || !dct_pow2(size)) {
+      dct_direct(re, yr, size, m, inverse);
+      if (yi != NULL)
+         dct_direct(im, yi, size, m, inverse);
+   } else if (inverse)
+      idct_fft(re, im, yr, yi, size, m);
+   else
+      dct_fft(re, im, yr, yi, size, m);
+}
+
+int dft(double *pReal, double *pImag, const int nDFTLength)
 {
-   register int n, k;
+   int k, n, j, size4 = 4 * nDFTLength;
+   double *pTempReal, *pTempImag, *c, TempReal, TempImag, cs, sn;
 
+   c = dct_costab(nDFTLength);
+   pTempReal = dct_work(2 * nDFTLength);
+   pTempImag = pTempReal + nDFTLength;
 
-   for (n = 0; n < dct_table_size_fft; n++) {
-      pLocalReal2[n] = pInReal[n];
-      pLocalImag2[n] = pInImag[n];
-      pLocalReal2[dct_table_size_fft + n] = pInReal[dct_table_size_fft - 1 - n];
-      pLocalImag2[dct_table_size_fft + n] = pInImag[dct_table_size_fft - 1 - n];
+   for (k = 0; k < nDFTLength; k++) {
+      pTempReal[k] = pReal[k];
+      pTempImag[k] = pImag[k];
    }
 
+   for (k = 0; k < nDFTLength; k++) {
+      TempReal = 0;
+      TempImag = 0;
+      /* cos(2 PI n k / N) = c[4 j], sin(2 PI n k / N) = c[N - 4 j] */
+      for (n = 0, j = 0; n < nDFTLength; n++) {
+         cs = c[4 * j];
+         sn = c[(nDFTLength - 4 * j + size4) % size4];
+         TempReal += pTempReal[n] * cs + pTempImag[n] * sn;
+         TempImag += -pTempReal[n] * sn + pTempImag[n] * cs;
+         if ((j += k) >= nDFTLength)
+            j -= nDFTLength;
+      }
+      pReal[k] = TempReal;
+      pImag[k] = TempImag;
+   }
 
-   fft(pLocalReal2, pLocalImag2, dct_table_size_fft * 2);       /* double input */
+   return (0);
+}
 
+int dct_create_table_fft(const int nSize)
+{
+   dct_table_size_fft = (nSize > 0) ? nSize : 0;
 
-   for (k = 0; k < dct_table_size_fft; k++) {
-      pReal[k] =
-          pLocalReal2[k] * pWeightReal2[k] - pLocalImag2[k] * pWeightImag2[k];
-      pImag[k] =
-          pLocalReal2[k] * pWeightImag2[k] + pLocalImag2[k] * pWeightReal2[k];
-   }
+   return (0);
+}
+
+int dct_create_table(const int nSize)
+{
+   dct_table_size = (nSize > 0) ? nSize : 0;
 
    return (0);
 }
 
-int dct_based_on_dft(double *pReal, double *pImag, const double *pInReal,
+int dct_based_on_fft(double *pReal, double *pImag, const double *pInReal,
                      const double *pInImag)
 {
-   register int n, k;
+   dct_apply(pInReal, pInImag, pReal, pImag, dct_table_size_fft,
+             dct_table_size_fft, FA, FA);
 
-   for (n = 0; n < dct_table_size; n++) {
-      pLocalReal[n] = pInReal[n];
-      pLocalImag[n] = pInImag[n];
-      pLocalReal[dct_table_size + n] = pInReal[dct_table_size - 1 - n];
-      pLocalImag[dct_table_size + n] = pInImag[dct_table_size - 1 - n];
-   }
-
-   dft(pLocalReal, pLocalImag, dct_table_size * 2);
+   return (0);
+}
 
-   for (k = 0; k < dct_table_size; k++) {
-      pReal[k] =
-          pLocalReal[k] * pWeightReal[k] - pLocalImag[k] * pWeightImag[k];
-      pImag[k] =
-          pLocalReal[k] * pWeightImag[k] + pLocalImag[k] * pWeightReal[k];
-   }
+int dct_based_on_dft(double *pReal, double *pImag, const double *pInReal,
+                     const double *pInImag)
+{
+   dct_apply(pInReal, pInImag, pReal, pImag, dct_table_size, dct_table_size,
+             TR, FA);
 
    return (0);
 }
@@ -243,50 +346,13 @@ int dct_based_on_dft(double *pReal, double *pImag, const double *pInReal,
 void dct(double *in, double *out, const int size, const int m,
          const Boolean dftmode, const Boolean compmode)
 {
-   int k, i, j, iter;
-   double *pReal, *pImag;
-   double *x, *y;
-   double *x2, *y2;
-
-   x = dgetmem(2 * size);
-   y = x + size;
-   pReal = dgetmem(2 * size);
-   pImag = pReal + size;
-   x2 = dgetmem(2 * size);
-   y2 = x2 + size;
-
-   for (k = 0; k < size; k++) {
-      x[k] = in[k];
-      y[k] = in[k + size];
-      x2[k] = x[k];
-      y2[k] = y[k];
-   }
-
-   iter = 0;
-   i = size;
-   while ((i /= 2) != 0) {
-      iter++;
-   }
-   j = 1;
-   for (i = 1; i <= iter; i++) {
-      j *= 2;
-   }
-   if (size != j || dftmode) {
-      dct_create_table(size);
-      dct_based_on_dft(pReal, pImag, x2, y2);
-   } else {
-      dct_create_table_fft(size);
-      dct_based_on_fft(pReal, pImag, x2, y2);
-   }
-
-   for (k = 0; k < m; k++) {
-      out[k] = pReal[k];
-      if (compmode == TR) {
-         out[k + size] = pImag[k];
-      }
-   }
+   dct_apply(in, in + size, out, compmode ? out + size : NULL, size, m,
+             dftmode, FA);
+}
 
-   free(x);
-   free(x2);
-   free(pReal);
+void idct(double *in, double *out, const int size, const int m,
+          const Boolean dftmode, const Boolean compmode)
+{
+   dct_apply(in, in + size, out, compmode ? out + size : NULL, size, m,
+             dftmode, TR);
 }
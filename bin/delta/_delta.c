@@ -0,0 +1,175 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Streaming Delta Calculation
+
+    int  delta_init(s, window, leng)
+    int  delta_push(s, x, y)
+    int  delta_flush(s, y)
+    void delta_free(s)
+
+    DELTASTREAM *s      : stream
+    DELTAWINDOW *window : regression windows (window 0 is static)
+    int         leng    : length of vector
+    double      *x      : input vector (leng)
+    double      *y      : output vector (win_size * leng)
+
+    return value of delta_push, delta_flush :
+                   1 -> y holds the next output frame
+                   0 -> no frame available
+
+    Only the last (win_max_width) frames are kept in a ring
+    buffer, so that memory does not depend on the number of
+    frames.  Frame t is emitted once frame t + (right width) has
+    been pushed; delta_flush() emits the remaining frames after
+    the last input.  As in delta and vc, frames outside the
+    sequence are replaced by the first or the last frame.
+
+    The nonzero window coefficients are collected in a tap table
+    at initialization, and each tap is applied as a scaled vector
+    addition over the whole feature dimension.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+int delta_init(DELTASTREAM * s, const DELTAWINDOW * window, const int leng)
+{
+   int d, j, k;
+
+   s->leng = leng;
+   s->nwin = (int) window->win_size;
+   s->maxl = s->maxr = 0;
+   for (d = 0, k = 0; d < s->nwin; d++) {
+      if (-window->win_l_width[d] > s->maxl)
+         s->maxl = -window->win_l_width[d];
+      if (window->win_r_width[d] > s->maxr)
+         s->maxr = window->win_r_width[d];
+      k += window->win_r_width[d] - window->win_l_width[d] + 1;
+   }
+   s->size = s->maxl + s->maxr + 1;
+   s->ring = dgetmem(s->size * leng);
+
+   s->tap_win = (int *) getmem((size_t) (2 * k), sizeof(int));
+   s->tap_shift = s->tap_win + k;
+   s->tap_coef = dgetmem(k);
+   for (d = 0, s->ntap = 0; d < s->nwin; d++)
+      for (j = window->win_l_width[d]; j <= window->win_r_width[d]; j++) {
+         if (window->win_coefficient[d][j] == 0.0)
+            continue;
+         s->tap_win[s->ntap] = d;
+         s->tap_shift[s->ntap] = j;
+         s->tap_coef[s->ntap] = window->win_coefficient[d][j];
+         s->ntap++;
+      }
+
+   s->nin = s->nout = 0;
+
+   return (0);
+}
+
+static void delta_frame(DELTASTREAM * s, double *y)
+{
+   int k, l;
+   const int leng = s->leng;
+   long t = s->nout, src;
+   double c, *row, *yd;
+
+   fillz(y, sizeof(*y), s->nwin * leng);
+
+   for (k = 0; k < s->ntap; k++) {
+      src = t + s->tap_shift[k];
+      if (src < 0)
+         src = 0;
+      if (src >= s->nin)
+         src = s->nin - 1;
+      row = s->ring + (src % s->size) * leng;
+      yd = y + s->tap_win[k] * leng;
+      c = s->tap_coef[k];
+      for (l = 0; l < leng; l++)
+         yd[l] += c * row[l];
+   }
+
+   s->nout++;
+}
+
+int delta_push(DELTASTREAM * s, const double *x, double *y)
+{
+   movem((double *) x, s->ring + (s->nin % s->size) * s->leng, sizeof(*x),
+         s->leng);
+   s->nin++;
+
+   if (s->nin - s->nout > s->maxr) {
+      delta_frame(s, y);
+      return (1);
+   }
+
+   return (0);
+}
+
+int delta_flush(DELTASTREAM * s, double *y)
+{
+   if (s->nout >= s->nin)
+      return (0);
+
+   delta_frame(s, y);
+
+   return (1);
+}
+
+void delta_free(DELTASTREAM * s)
+{
+   free(s->ring);
+   free(s->tap_win);
+   free(s->tap_coef);
+}
@@ -197,11 +197,10 @@ void get_coef(double *input, double *output, int dw_num,
               int *win_size_forward, int *win_size_backward, int poly_order,
               double floor)
 {
-   int i, j, k, l, t, d, ind = 0, index = 0, width = 0, input_val = 0,
-       num_points = 0, num_order = 0, max_points = 0,
-       max_degrees = 0, factorial = 1;
-   double *poly_coef = NULL, *b = NULL, **p = NULL, *tmpvec = NULL,
-       **inverse = NULL, **AA = NULL, **A = NULL;
+   int i, j, k, l, t, d, index = 0, num_points = 0, num_order = 0,
+       max_points = 0, max_degrees = 0, factorial = 1, *src = NULL;
+   double *taps = NULL, *out = NULL, *row = NULL, **inverse = NULL,
+       **AA = NULL, **A = NULL, *p = NULL;
    Boolean boundary_begin = FA, boundary_end = FA;
 
    max_points = win_size_forward[0] + win_size_backward[0] + 1;
@@ -216,10 +215,9 @@ void get_coef(double *input, double *output, int dw_num,
    AA = ddgetmem(max_degrees + 1, max_degrees + 1);
    A = ddgetmem(max_points, max_degrees + 1);
    inverse = ddgetmem(max_degrees + 1, max_degrees + 1);
-   poly_coef = dgetmem(max_degrees + 1);
-   b = dgetmem(max_points);
-   p = ddgetmem(total, max_points + 1);
-   tmpvec = dgetmem(max_degrees + 1);
+   taps = dgetmem(max_points);
+   p = dgetmem(max_points);
+   src = (int *) getmem(max_points, sizeof(int));
 
    for (d = 0; d < dw_num - 1; d++) {
       if (magic_flag == TR) {
@@ -244,6 +242,11 @@ void get_coef(double *input, double *output, int dw_num,
          num_order = poly_order;
       }
 
+      /* calculate factorial */
+      for (i = 1, factorial = 1; i <= d + 1; i++) {
+         factorial *= i;
+      }
+
       /* calculate regression coefficients for each frame */
       for (t = 0; t < total; t++) {
          boundary_begin = boundary_end = FA;
@@ -251,19 +254,21 @@ void get_coef(double *input, double *output, int dw_num,
             index = t + i;
             if (index < 0) {
                boundary_begin = TR;
-               width = i;
+               p[i + win_size_backward[d]] = i;
+               src[i + win_size_backward[d]] = position[0];
             } else if (index >= total) {
                boundary_end = TR;
-               width = i;
+               p[i + win_size_backward[d]] = i;
+               src[i + win_size_backward[d]] = position[total - 1];
             } else {
-               width = position[index] - position[t];
+               p[i + win_size_backward[d]] = position[index] - position[t];
+               src[i + win_size_backward[d]] = position[index];
             }
-            p[t][i + win_size_backward[d]] = width;
          }
 
          for (i = 0; i < num_points; i++) {
             for (j = 0; j < num_order + 1; j++) {
-               A[i][j] = pow(p[t][i], j);
+               A[i][j] = pow(p[i], j);
             }
          }
          for (i = 0; i < num_order + 1; i++) {
@@ -281,70 +286,61 @@ void get_coef(double *input, double *output, int dw_num,
          }
          invert(AA, inverse, num_order + 1);
 
-         /* for each dimension of feature vector */
-         for (l = 0; l < length; l++) {
-            for (i = -win_size_backward[d]; i <= win_size_forward[d]; i++) {
-               index = t + i;
-               if (index < 0) {
-                  input_val = input[length * position[0] + l];
-               } else if (index >= total) {
-                  input_val = input[length * position[total - 1] + l];
-               } else {
-                  input_val = input[length * position[index] + l];
-               }
-               b[i + win_size_backward[d]] = input_val;
+         /* (d + 1)-th polynomial coefficient as FIR taps over the points */
+         for (i = 0; i < num_points; i++) {
+            taps[i] = 0.0;
+            for (j = 0; j < num_order + 1; j++) {
+               taps[i] += inverse[d + 1][j] * A[i][j];
             }
+            taps[i] *= factorial;
+         }
 
-            fillz(tmpvec, sizeof(*tmpvec), num_order + 1);
-            for (i = 0; i < num_order + 1; i++) {
-               for (j = 0; j < num_points; j++) {
-                  tmpvec[i] += A[j][i] * b[j];
-               }
-            }
-            fillz(poly_coef, sizeof(*poly_coef), num_order + 1);
-            for (i = 0; i < num_order + 1; i++) {
-               for (j = 0; j < num_order + 1; j++) {
-                  poly_coef[i] += inverse[i][j] * tmpvec[j];
-               }
+         out = output + dw_num * length * position[t] + (d + 1) * length;
+         row = input + length * position[t];
+
+         if (d == 0) {
+            /* output static */
+            for (l = 0; l < length; l++) {
+               output[dw_num * length * position[t] + l] = row[l];
             }
+         }
 
-            if (d == 0) {
-               /* output static */
-               ind = dw_num * length * position[t] + l;
-               output[ind] = input[length * position[t] + l];
-               /* output delta */
-               ind += length;
-               if (boundary_begin == TR && win_size_backward[d] == 1) {
-                  output[ind]
-                      = (input[length * position[t + 1] + l]
-                         - input[length * position[t] + l])
-                      / (position[t + 1] - position[t]);
-               } else if (boundary_end == TR && win_size_forward[d] == 1) {
-                  output[ind]
-                      = (input[length * position[t] + l]
-                         - input[length * position[t - 1] + l])
-                      / (position[t] - position[t - 1]);
-               } else {
-                  output[ind] = poly_coef[1];
-               }
-            } else {
-               /* output delta-delta or higher order (greater than 2) dynamic feature */
-               ind = dw_num * length * position[t] + (d + 1) * length + l;
-               if (boundary_begin == TR && win_size_backward[d] == 1) {
-                  output[ind] = 0.0;
-               } else if (boundary_end == TR && win_size_forward[d] == 1) {
-                  output[ind] = 0.0;
-               } else {
-                  /* calculate factorial */
-                  for (i = 1, factorial = 1; i <= d + 1; i++) {
-                     factorial *= i;
-                  }
-                  output[ind] = (double) factorial *poly_coef[d + 1];
+         if (boundary_begin == TR && win_size_backward[d] == 1) {
+            for (l = 0; l < length; l++) {
+               out[l] = (d == 0)
+                   ? (input[length * position[t + 1] + l] - row[l])
+                   / (position[t + 1] - position[t]) : 0.0;
+            }
+         } else if (boundary_end == TR && win_size_forward[d] == 1) {
+            for (l = 0; l < length; l++) {
+               out[l] = (d == 0)
+                   ? (row[l] - input[length * position[t - 1] + l])
+                   / (position[t] - position[t - 1]) : 0.0;
+            }
+         } else {
+            /* apply taps to the whole vector at once */
+            for (l = 0; l < length; l++) {
+               out[l] = 0.0;
+            }
+            for (i = 0; i < num_points; i++) {
+               row = input + length * src[i];
+               for (l = 0; l < length; l++) {
+                  out[l] += taps[i] * row[l];
                }
             }
          }
       }
    }
+
+   free(AA[0]);
+   free(AA);
+   free(A[0]);
+   free(A);
+   free(inverse[0]);
+   free(inverse);
+   free(taps);
+   free(p);
+   free(src);
 }
 
 int main(int argc, char *argv[])
@@ -352,7 +348,7 @@ int main(int argc, char *argv[])
    FILE *fp = stdin, *fpc = NULL;
    char *coef = NULL;
    double floor = FLOOR, *x = NULL, *dx = NULL, **dw_coef = NULL;
-   int i, j, l, d, t, tj, fsize, leng = LENG, total = T, win_buf = 0,
+   int i, j, l, d, t, fsize, leng = LENG, total = T, win_buf = 0,
        poly_order = POLYNOMIAL_ORDER;
    int dw_num = 1, **dw_width = NULL, dw_calccoef = -1, dw_coeflen = 1,
        dw_leng = 1;
@@ -360,6 +356,8 @@ int main(int argc, char *argv[])
    int non_magic_num, win_size_forward[2] = { 1, 1 }, win_size_backward[2] = {
    1, 1};
    float_list *top = NULL, *cur = NULL, *prev = NULL, *tmpf = NULL;
+   DELTAWINDOW window;
+   DELTASTREAM ds;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -643,6 +641,29 @@ int main(int argc, char *argv[])
       }
    }
 
+   if (dw_calccoef == 0 || dw_calccoef == 1) {
+      /* calculate delta and delta-delta frame by frame */
+      window.win_size = dw_num;
+      window.win_l_width = (int *) getmem(dw_num, sizeof(int));
+      window.win_r_width = (int *) getmem(dw_num, sizeof(int));
+      window.win_coefficient = dw_coef;
+      for (d = 0; d < dw_num; d++) {
+         window.win_l_width[d] = dw_width[d][0];
+         window.win_r_width[d] = dw_width[d][1];
+      }
+      delta_init(&ds, &window, leng);
+
+      x = dgetmem(leng);
+      dx = dgetmem(dw_num * leng);
+      while (freadf(x, sizeof(*x), leng, fp) == leng)
+         if (delta_push(&ds, x, dx))
+            fwritef(dx, sizeof(*dx), dw_num * leng, stdout);
+      while (delta_flush(&ds, dx))
+         fwritef(dx, sizeof(*dx), dw_num * leng, stdout);
+
+      return (0);
+   }
+
    /* -- Count number of input vectors and read -- */
    x = dgetmem(leng);
    top = prev = (float_list *) getmem(1, sizeof(float_list));
@@ -670,27 +691,7 @@ int main(int argc, char *argv[])
       }
    }
 
-   if (dw_calccoef == 0 || dw_calccoef == 1) {
-      /* calculate delta and delta-delta */
-      for (t = 0; t < total; t++) {
-         for (d = 0; d < dw_num; d++) {
-            for (j = dw_width[d][0]; j <= dw_width[d][1]; j++) {
-               tj = t + j;
-               if (tj < 0)
-                  tj = 0;
-               if (!(tj < total))
-                  tj = total - 1;
-               for (l = 0; l < leng; l++)
-                  dx[dw_num * leng * t + leng * d + l] +=
-                      dw_coef[d][j] * x[leng * tj + l];
-            }
-         }
-      }
-
-      /* output static, delta, delta-delta */
-      fwritef(dx, sizeof(*dx), dw_num * total * leng, stdout);
-
-   } else if (dw_calccoef == 2) {
+   if (dw_calccoef == 2) {
       int *position = (int *) getmem(total, sizeof(int));
 
       /* skip magic number */
@@ -1293,10 +1293,8 @@ void calc_local_cost(Dtw_Table * table)
       for (i = 0; i < data[0].total; i++) {
          for (j = 0; j < data[1].total; j++) {
             if (cell[i][j].is_region == PATH_OK) {
-               for (d = 0, sum = 0.0; d < tdd; d++) {
-                  sum += pow((data[0].input[i * tdd + d] -
-                              data[1].input[j * tdd + d]), 2);
-               }
+               sum = simd_dist2(data[0].input + i * tdd,
+                                data[1].input + j * tdd, tdd);
                cell[i][j].local = sqrt(sum);
             }
          }
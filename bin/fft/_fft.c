@@ -55,6 +55,11 @@
    
                 return : success = 0
                          fault   = -1
+
+                int   fftf(x, y, m);
+
+                float version of fft() with its own float
+                SIN table, for FLOAT32 builds
        Naohiro Isshiki          Dec.1995    modified   
 ********************************************************/
 
@@ -70,6 +75,8 @@
 
 double *_sintbl = 0;
 int maxfftsize = 0;
+float *_sintblf = 0;
+int maxfftsizef = 0;
 
 static int checkm(const int m)
 {
@@ -188,3 +195,108 @@ int fft(double *x, double *y, const int m)
 
    return (0);
 }
+
+int fftf(float *x, float *y, const int m)
+{
+   int j, lmx, li;
+   float *xp, *yp;
+   float *sinp, *cosp;
+   int lf, lix, tblsize;
+   int mv2, mm1;
+   float t1, t2;
+   double arg;
+   int checkm(const int);
+
+   /**************
+   * RADIX-2 FFT *
+   **************/
+
+   if (checkm(m))
+      return (-1);
+
+   /***********************
+   * SIN table generation *
+   ***********************/
+
+   if ((_sintblf == 0) || (maxfftsizef < m)) {
+      tblsize = m - m / 4 + 1;
+      arg = PI / m * 2;
+      if (_sintblf != 0)
+         free(_sintblf);
+      _sintblf = sinp = fgetmem(tblsize);
+      *sinp++ = 0;
+      for (j = 1; j < tblsize; j++)
+         *sinp++ = sin(arg * (double) j);
+      _sintblf[m / 2] = 0;
+      maxfftsizef = m;
+   }
+
+   lf = maxfftsizef / m;
+   lmx = m;
+
+   for (;;) {
+      lix = lmx;
+      lmx /= 2;
+      if (lmx <= 1)
+         break;
+      sinp = _sintblf;
+      cosp = _sintblf + maxfftsizef / 4;
+      for (j = 0; j < lmx; j++) {
+         xp = &x[j];
+         yp = &y[j];
+         for (li = lix; li <= m; li += lix) {
+            t1 = *(xp) - *(xp + lmx);
+            t2 = *(yp) - *(yp + lmx);
+            *(xp) += *(xp + lmx);
+            *(yp) += *(yp + lmx);
+            *(xp + lmx) = *cosp * t1 + *sinp * t2;
+            *(yp + lmx) = *cosp * t2 - *sinp * t1;
+            xp += lix;
+            yp += lix;
+         }
+         sinp += lf;
+         cosp += lf;
+      }
+      lf += lf;
+   }
+
+   xp = x;
+   yp = y;
+   for (li = m / 2; li--; xp += 2, yp += 2) {
+      t1 = *(xp) - *(xp + 1);
+      t2 = *(yp) - *(yp + 1);
+      *(xp) += *(xp + 1);
+      *(yp) += *(yp + 1);
+      *(xp + 1) = t1;
+      *(yp + 1) = t2;
+   }
+
+   /***************
+   * bit reversal *
+   ***************/
+   j = 0;
+   xp = x;
+   yp = y;
+   mv2 = m / 2;
+   mm1 = m - 1;
+   for (lmx = 0; lmx < mm1; lmx++) {
+      if ((li = lmx - j) < 0) {
+         t1 = *(xp);
+         t2 = *(yp);
+         *(xp) = *(xp + li);
+         *(yp) = *(yp + li);
+         *(xp + li) = t1;
+         *(yp + li) = t2;
+      }
+      li = mv2;
+      while (li <= j) {
+         j -= li;
+         li /= 2;
+      }
+      j += li;
+      xp = x + j;
+      yp = y + j;
+   }
+
+   return (0);
+}
@@ -53,6 +53,10 @@
         double  x[];   real part of data      
         double  y[];   working area         
         int     m;     number of data(radix 2)      
+
+        int   fftrf(x, y, m)
+
+        float version of fftr(), for FLOAT32 builds
                 Naohiro Isshiki    Dec.1995   modified
 ********************************************************/
 
@@ -68,6 +72,8 @@
 
 extern double *_sintbl;
 extern int maxfftsize;
+extern float *_sintblf;
+extern int maxfftsizef;
 
 int fftr(double *x, double *y, const int m)
 {
@@ -144,3 +150,79 @@ int fftr(double *x, double *y, const int m)
 
    return (0);
 }
+
+int fftrf(float *x, float *y, const int m)
+{
+   int i, j;
+   float *xp, *yp, *xq;
+   float *yq;
+   int mv2, n, tblsize;
+   float xt, yt, *sinp, *cosp;
+   double arg;
+
+   mv2 = m / 2;
+
+   /* separate even and odd  */
+   xq = xp = x;
+   yp = y;
+   for (i = mv2; --i >= 0;) {
+      *xp++ = *xq++;
+      *yp++ = *xq++;
+   }
+
+   if (fftf(x, y, mv2) == -1)    /* m / 2 point fft */
+      return (-1);
+
+
+   /***********************
+   * SIN table generation *
+   ***********************/
+
+   if ((_sintblf == 0) || (maxfftsizef < m)) {
+      tblsize = m - m / 4 + 1;
+      arg = PI / m * 2;
+      if (_sintblf != 0)
+         free(_sintblf);
+      _sintblf = sinp = fgetmem(tblsize);
+      *sinp++ = 0;
+      for (j = 1; j < tblsize; j++)
+         *sinp++ = sin(arg * (double) j);
+      _sintblf[m / 2] = 0;
+      maxfftsizef = m;
+   }
+
+   n = maxfftsizef / m;
+   sinp = _sintblf;
+   cosp = _sintblf + maxfftsizef / 4;
+
+   xp = x;
+   yp = y;
+   xq = xp + m;
+   yq = yp + m;
+   *(xp + mv2) = *xp - *yp;
+   *xp = *xp + *yp;
+   *(yp + mv2) = *yp = 0;
+
+   for (i = mv2, j = mv2 - 2; --i; j -= 2) {
+      ++xp;
+      ++yp;
+      sinp += n;
+      cosp += n;
+      yt = *yp + *(yp + j);
+      xt = *xp - *(xp + j);
+      *(--xq) = (*xp + *(xp + j) + *cosp * yt - *sinp * xt) * 0.5f;
+      *(--yq) = (*(yp + j) - *yp + *sinp * yt + *cosp * xt) * 0.5f;
+   }
+
+   xp = x + 1;
+   yp = y + 1;
+   xq = x + m;
+   yq = y + m;
+
+   for (i = mv2; --i;) {
+      *xp++ = *(--xq);
+      *yp++ = -(*(--yq));
+   }
+
+   return (0);
+}
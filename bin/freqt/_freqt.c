@@ -49,12 +49,19 @@
     Frequency Transformation
 
         void   freqt(c1, m1, c2, m2, a)
+        void   freqt_batch(c1, m1, c2, m2, a, nfrm)
 
         double   *c1   : minimum phase sequence
         int      m1    : order of minimum phase sequence
         double   *c2   : warped sequence
         int      m2    : order of warped sequence
         double   a     : all-pass constant
+        int      nfrm  : number of frames (c1 and c2 must not overlap)
+
+    The transformation is linear, so its (m1+1) x (m2+1) matrix is
+    built once per (m1, m2, a) and kept in the warptab() registry.
+    A frame is then warped by one vector-matrix product, and
+    freqt_batch() warps nfrm frames by one matrix product.
 
 ***************************************************************/
 
@@ -67,39 +74,73 @@
 #  include <SPTK.h>
 #endif
 
+static double *freqt_table(const int m1, const int m2, const double a)
+{
+   int i, j, isnew;
+   double b, *t, *g, *d;
+
+   t = warptab(WARP_FREQT, m1, m2, 0, a, 0.0, (m1 + 1) * (m2 + 1), &isnew);
+   if (!isnew)
+      return (t);
+
+   /* row j: response to unit c1[j], which enters the recursion j steps
+      before the end */
+   b = 1 - a * a;
+   fillz(t, sizeof(*t), m2 + 1);
+   t[0] = 1.0;
+   for (j = 1; j <= m1; j++) {
+      d = t + (j - 1) * (m2 + 1);
+      g = d + (m2 + 1);
+      g[0] = a * d[0];
+      if (1 <= m2)
+         g[1] = b * d[0] + a * d[1];
+      for (i = 2; i <= m2; i++)
+         g[i] = d[i - 1] + a * (d[i] - g[i - 1]);
+   }
+
+   return (t);
+}
+
 void freqt(double *c1, const int m1, double *c2, const int m2, const double a)
 {
    int i, j;
-   double b;
-   static double *d = NULL, *g;
+   double *t, *r, c;
+   static double *g = NULL;
    static int size;
 
-   if (d == NULL) {
+   if (g == NULL) {
       size = m2;
-      d = dgetmem(size + size + 2);
-      g = d + size + 1;
+      g = dgetmem(size + 1);
    }
 
    if (m2 > size) {
-      free(d);
+      free(g);
       size = m2;
-      d = dgetmem(size + size + 2);
-      g = d + size + 1;
+      g = dgetmem(size + 1);
    }
 
-   b = 1 - a * a;
-   fillz(g, sizeof(*g), m2 + 1);
+   t = freqt_table(m1, m2, a);
 
-   for (i = -m1; i <= 0; i++) {
-      if (0 <= m2)
-         g[0] = c1[-i] + a * (d[0] = g[0]);
-      if (1 <= m2)
-         g[1] = b * d[0] + a * (d[1] = g[1]);
-      for (j = 2; j <= m2; j++)
-         g[j] = d[j - 1] + a * ((d[j] = g[j]) - g[j - 1]);
+   fillz(g, sizeof(*g), m2 + 1);
+   for (j = 0, r = t; j <= m1; j++, r += m2 + 1) {
+      c = c1[j];
+      for (i = 0; i <= m2; i++)
+         g[i] += c * r[i];
    }
 
    movem(g, c2, sizeof(*g), m2 + 1);
 
    return;
 }
+
+void freqt_batch(double *c1, const int m1, double *c2, const int m2,
+                 const double a, const int nfrm)
+{
+   double *t;
+
+   t = freqt_table(m1, m2, a);
+   mat_gemm(nfrm, m2 + 1, m1 + 1, 1.0, c1, m1 + 1, t, m2 + 1, 0.0, c2,
+            m2 + 1);
+
+   return;
+}
@@ -63,7 +63,7 @@
 *               warped sequence                                         *
 *                   , c~(0), c~(1), ..., c~(N),                         *
 *       require:                                                        *
-*               freqt()                                                 *
+*               freqt_batch()                                           *
 *                                                                       *
 ************************************************************************/
 
@@ -95,6 +95,7 @@ static char *rcs_id = "$Id: freqt.c,v 1.23 2014/12/11 08:30:35 uratec Exp $";
 #define ORDERC2 25
 #define ALPHA1 0.0
 #define ALPHA2 0.35
+#define BLOCK 256               /* number of frames warped at a time */
 
 /*  Command Name  */
 char *cmnd;
@@ -133,7 +134,7 @@ void usage(int status)
 
 int main(int argc, char **argv)
 {
-   int m1 = ORDERC1, m2 = ORDERC2;
+   int m1 = ORDERC1, m2 = ORDERC2, n;
    FILE *fp = stdin;
    double *c1, *c2, a1 = ALPHA1, a2 = ALPHA2, a;
 
@@ -170,14 +171,14 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   c1 = dgetmem(m1 + m2 + 2);
-   c2 = c1 + m1 + 1;
+   c1 = dgetmem(BLOCK * (m1 + m2 + 2));
+   c2 = c1 + BLOCK * (m1 + 1);
 
    a = (a2 - a1) / (1 - a1 * a2);
 
-   while (freadf(c1, sizeof(*c1), m1 + 1, fp) == m1 + 1) {
-      freqt(c1, m1, c2, m2, a);
-      fwritef(c2, sizeof(*c2), m2 + 1, stdout);
+   while ((n = freadf(c1, sizeof(*c1), BLOCK * (m1 + 1), fp) / (m1 + 1)) > 0) {
+      freqt_batch(c1, m1, c2, m2, a, n);
+      fwritef(c2, sizeof(*c2), n * (m2 + 1), stdout);
    }
 
    return 0;
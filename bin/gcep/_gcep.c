@@ -49,6 +49,8 @@
     Generalized Cepstral Analysis
 
         int gcep(xw, flng, gc, m, g, itr1, itr2, d, etype, e, f, itype);
+        int gcep_warm(xw, flng, gc, m, g, itr1, itr2, d, etype, e, f,
+                      itype, w);
 
         double    *xw   : input sequence
         int       flng  : frame length
@@ -66,6 +68,8 @@
         double    f     : mimimum value of the determinant
                          of the normal matrix
         int      itype : input data type
+        CepWarm  *w    : warm start (or NULL)
+                         (see cepwarm_init() in _mcep.c)
 
         return value :    0 -> completed by end condition
                           -1-> completed by maximum iteration
@@ -89,7 +93,16 @@ int gcep(double *xw, const int flng, double *gc, const int m, const double g,
          const int itr1, const int itr2, const double d, const int etype,
          const double e, const double f, const int itype)
 {
-   int i, j, flag = 0;
+   return (gcep_warm(xw, flng, gc, m, g, itr1, itr2, d, etype, e, f, itype,
+                     NULL));
+}
+
+int gcep_warm(double *xw, const int flng, double *gc, const int m,
+              const double g, const int itr1, const int itr2, const double d,
+              const int etype, const double e, const double f,
+              const int itype, CepWarm * w)
+{
+   int i, j, pass, iter = 0, flag = 0;
    double t, s, eps = 0.0, min, max, dd = 0.0;
    static double *x = NULL, *y, *cr, *ci, *rr, *hr, *hi, *er, *ei;
    static int size;
@@ -192,64 +205,85 @@ int gcep(double *xw, const int flng, double *gc, const int m, const double g,
       }
    }
 
-   for (i = 0; i < flng; i++)
-      cr[i] = log(x[i]);
-
-   /*  initial value of generalized cepstrum  */
-   ifftr(cr, y, flng);          /*  x : IFFT[x]  */
-   cr[0] = exp(cr[0] / 2);
-   gc2gc(cr, m, 0.0, gc, m, g); /*  gc : generalized cepstrum  */
-
-   /*  Newton-Raphson method  */
-   for (j = 1; j <= itr2; j++) {
-      fillz(cr, sizeof(*cr), flng);
-      movem(&gc[1], &cr[1], sizeof(*cr), m);
-      fftr(cr, ci, flng);       /*  cr+jci : FFT[gc]  */
-
-      for (i = 0; i < flng; i++) {
-         t = x[i] / agexp(g, cr[i], ci[i]);
-         cr[i] = 1 + g * cr[i];
-         ci[i] = g * ci[i];
-         s = cr[i] * cr[i] + ci[i] * ci[i];
-         rr[i] = t / s;
-         hr[i] = (cr[i] * cr[i] - ci[i] * ci[i]) * t / (s * s);
-         hi[i] = 2 * cr[i] * ci[i] * t / (s * s);
-         er[i] = cr[i] * t / s;
-         ei[i] = ci[i] * t / s;
+   /*  pass 0 : from previous frame, pass 1 : from periodogram  */
+   for (pass = (cepwarm_ready(w, m)) ? 0 : 1; pass < 2; pass++) {
+      if (pass == 0)
+         movem(w->prev, gc, sizeof(*gc), m + 1);
+      else {
+         for (i = 0; i < flng; i++)
+            cr[i] = log(x[i]);
+
+         /*  initial value of generalized cepstrum  */
+         ifftr(cr, y, flng);    /*  x : IFFT[x]  */
+         cr[0] = exp(cr[0] / 2);
+         gc2gc(cr, m, 0.0, gc, m, g);   /*  gc : generalized cepstrum  */
       }
 
-      ifftr(rr, y, flng);       /*  rr : r(k)  */
-      ifft(hr, hi, flng);       /*  hr : h(k)  */
-      ifft(er, ei, flng);       /*  er : e(k)  */
-      s = gc[0];                /*  gc[0] : gain  */
-
-      for (i = 1, t = 0.0; i <= m; i++)
-         t += er[i] * gc[i];
-
-      t = er[0] + g * t;
-      t = sqrt(fabs(t));
+      /*  Newton-Raphson method  */
+      flag = 0;
+      dd = 0.0;
+      for (j = 1; j <= itr2; j++) {
+         fillz(cr, sizeof(*cr), flng);
+         movem(&gc[1], &cr[1], sizeof(*cr), m);
+         fftr(cr, ci, flng);    /*  cr+jci : FFT[gc]  */
+
+         for (i = 0; i < flng; i++) {
+            t = x[i] / agexp(g, cr[i], ci[i]);
+            cr[i] = 1 + g * cr[i];
+            ci[i] = g * ci[i];
+            s = cr[i] * cr[i] + ci[i] * ci[i];
+            rr[i] = t / s;
+            hr[i] = (cr[i] * cr[i] - ci[i] * ci[i]) * t / (s * s);
+            hi[i] = 2 * cr[i] * ci[i] * t / (s * s);
+            er[i] = cr[i] * t / s;
+            ei[i] = ci[i] * t / s;
+         }
 
-      if (j >= itr1) {
-         if (fabs((t - dd) / t) < d) {
-            flag = 1;
-            break;
+         ifftr(rr, y, flng);    /*  rr : r(k)  */
+         ifft(hr, hi, flng);    /*  hr : h(k)  */
+         ifft(er, ei, flng);    /*  er : e(k)  */
+         s = gc[0];             /*  gc[0] : gain  */
+
+         for (i = 1, t = 0.0; i <= m; i++)
+            t += er[i] * gc[i];
+
+         t = er[0] + g * t;
+         t = sqrt(fabs(t));
+
+         if (j >= itr1) {
+            if (fabs((t - dd) / t) < d) {
+               flag = 1;
+               break;
+            }
+            dd = t;
+         } else if (pass == 0)
+            dd = t;             /*  dd has no meaning before 1st iteration  */
+
+         for (i = 2; i <= m + m; i++)
+            hr[i] *= 1 + g;
+
+         if (theq(rr, &hr[2], &y[1], &er[1], m, f)) {
+            if (pass == 0)
+               break;
+            fprintf(stderr, "gcep : Error in theq() at %dth iteration!\n", j);
+            stats_frame(iter + j, TR);
+            return 3;
          }
-         dd = t;
-      }
 
-      for (i = 2; i <= m + m; i++)
-         hr[i] *= 1 + g;
+         gc[0] = t;
 
-      if (theq(rr, &hr[2], &y[1], &er[1], m, f)) {
-         fprintf(stderr, "gcep : Error in theq() at %dth iteration!\n", j);
-         return 3;
+         for (i = 1; i <= m; i++)
+            gc[i] += y[i];
       }
+      iter += (j <= itr2) ? j : itr2;
 
-      gc[0] = t;
-
-      for (i = 1; i <= m; i++)
-         gc[i] += y[i];
+      /*  restart from periodogram unless converged  */
+      if (pass == 1 || (flag && cepwarm_valid(gc, m)))
+         break;
+      w->fallback = TR;
    }
+   cepwarm_done(w, gc, m);
+   stats_frame(iter, !flag);
 
    if (flag)
       return (0);
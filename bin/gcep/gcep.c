@@ -71,6 +71,10 @@
 *               -E E     :  floor in db calculated per frame [N/A]      *
 *               -f f     :  mimimum value of the determinant            *
 *                           of the normal matrix             [0.000001] *
+*               -w       :  start from the generalized       [FALSE]    *
+*                           cepstrum of the previous frame              *
+*               --stats  :  write statistics of iterations   [FALSE]    *
+*                           to stderr as JSON lines                     *
 *       infile:                                                         *
 *               data sequence                                           *
 *                   , x(0), x(1), ..., x(L-1),                          *
@@ -82,7 +86,7 @@
 *               value of e must be e>=0                                 *
 *               value of E must be E<0                                  *
 *       require:                                                        *
-*               gcep()                                                  *
+*               gcep_warm(), cepwarm_init(), stats_open()               *
 *                                                                       *
 ************************************************************************/
 
@@ -121,6 +125,8 @@ static char *rcs_id = "$Id: gcep.c,v 1.36 2014/12/11 08:30:36 uratec Exp $";
 #define END 0.001
 #define EPS 0.0
 #define MINDET 0.000001
+#define WARM FA
+#define STATS FA
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -165,6 +171,12 @@ void usage(int status)
    fprintf(stderr, "       -f f  : mimimum value of the determinant [%g]\n",
            MINDET);
    fprintf(stderr, "               of the normal matrix\n");
+   fprintf(stderr, "       -w    : start from the generalized       [%s]\n",
+           BOOL[WARM]);
+   fprintf(stderr, "               cepstrum of the previous frame\n");
+   fprintf(stderr, "       --stats : write statistics of iterations [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               to stderr as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr, "       windowed sequence (%s)                   [stdin]\n",
@@ -189,6 +201,8 @@ int main(int argc, char **argv)
    int m = ORDER, flng = FLENG, ilng = FLENG, itr1 = MINITR,
        itr2 = MAXITR, itype = ITYPE, etype = ETYPE, norm = NORM, flag = 0;
    FILE *fp = stdin;
+   Boolean warm = WARM, stats = STATS;
+   CepWarm w;
    double *gc, *x, g = GAMMA, end = END, e = EPS, f = MINDET;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
@@ -251,6 +265,16 @@ int main(int argc, char **argv)
             f = atof(*++argv);
             --argc;
             break;
+         case 'w':
+            warm = 1 - warm;
+            break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -268,14 +292,23 @@ int main(int argc, char **argv)
    x = dgetmem(flng + m + 1);
    gc = x + flng;
 
+   cepwarm_init(&w, warm);
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
    while (freadf(x, sizeof(*x), ilng, fp) == ilng) {
-
-      flag = gcep(x, flng, gc, m, g, itr1, itr2, end, etype, e, f, itype);
-
+      stats_stage("analysis");
+      flag =
+          gcep_warm(x, flng, gc, m, g, itr1, itr2, end, etype, e, f, itype,
+                    &w);
       if (!norm)
          ignorm(gc, gc, m, g);
+      stats_stage("write");
       fwritef(gc, sizeof(*gc), m + 1, stdout);
+      stats_stage("read");
    }
+   stats_close();
+
+   cepwarm_free(&w);
 
    return 0;
 }
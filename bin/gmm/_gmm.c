@@ -48,6 +48,9 @@
 
     GMM output prob calculation functions
 
+    log_outpf() scores float data in float against the copy of
+    the means and (inverse) variances made by prepareFloat_GMM().
+
 *****************************************************************/
 
 #include <stdio.h>
@@ -60,39 +63,23 @@
 #  include <SPTK.h>
 #endif
 
-int choleski(double **cov, double **S, const int L);
-
 double cal_det(double **var, const int D)
 {
-   int i, j, l;
-   double ldet = 0.0, **tri;
-
-   tri = (double **) malloc(sizeof(double *) * D);
-   for (l = 0; l < D; l++)
-      tri[l] = dgetmem(D);
+   int i, j;
+   double ldet, *tri;
 
+   tri = dgetmem(D * D);
    for (i = 0; i < D; i++)
-      for (j = 0; j < D; j++)
-         tri[i][j] = 0.0;
-
-   if (choleski(var, tri, D)) {
-      for (l = 0; l < D; l++)
-         ldet += log(tri[l][l]);
+      for (j = 0; j <= i; j++)
+         tri[i * D + j] = var[i][j];
 
-      for (l = 0; l < D; l++) {
-         free(tri[l]);
-      }
-      free(tri);
-
-      return (2.0 * ldet);
-   } else {
-      for (l = 0; l < D; l++) {
-         free(tri[l]);
-      }
-      free(tri);
+   ldet = 0.0;
+   if (mat_chol(tri, D, D) == 0)
+      for (i = 0; i < D; i++)
+         ldet += log(tri[i * D + i]);
+   free(tri);
 
-      return 0;
-   }
+   return (2.0 * ldet);
 }
 
 double cal_gconst(double *var, const int D)
@@ -122,84 +109,19 @@ double cal_gconstf(double **var, const int D)
    return (gconst);
 }
 
-void cal_tri_inv(double **S, double **S_inv, const int L)
-{
-   int i, j, k;
-
-   for (i = 0; i < L; i++) {
-      S_inv[i][i] = 1.0 / S[i][i];
-   }
-   for (i = 1; i < L; i++)
-      for (j = i - 1; j >= 0; j--)
-         for (k = j; k < i; k++) {
-            S_inv[i][j] = S_inv[i][j] - S[i][k] * S_inv[k][j] / S[i][i];
-         }
-}
-
-int choleski(double **cov, double **S, const int L)
-{
-   int i, j, k;
-   double tmp;
-
-   for (i = 0; i < L; i++) {
-      for (j = 0; j < i; j++) {
-         tmp = cov[i][j];
-         for (k = 0; k < j; k++)
-            tmp -= S[i][k] * S[j][k];
-         S[i][j] = tmp / S[j][j];
-      }
-      tmp = cov[i][i];
-      for (k = 0; k < i; k++)
-         tmp -= S[i][k] * S[i][k];
-      if (tmp <= 0) {
-         return 0;
-      }
-      S[i][i] = sqrt(tmp);
-   }
-   return 1;
-}
-
+/* inv must be allocated by ddgetmem() so that its rows are contiguous */
 void cal_inv(double **cov, double **inv, const int L)
 {
-   int i, j, k;
-   double **S, **S_inv;
-
-   S = (double **) malloc(sizeof(double *) * L);
-   S_inv = (double **) malloc(sizeof(double *) * L);
-
-   for (i = 0; i < L; i++) {
-      S[i] = dgetmem(L);
-      S_inv[i] = dgetmem(L);
-   }
-
-   for (i = 0; i < L; i++) {
-      for (j = 0; j < L; j++) {
-         S[i][j] = 0.0;
-         S_inv[i][j] = 0.0;
-         inv[i][j] = 0.0;
-      }
-   }
-
-   if (choleski(cov, S, L) == 0)
-      return;
-   cal_tri_inv(S, S_inv, L);
+   int i, j;
 
    for (i = 0; i < L; i++)
-      for (j = 0; j < L; j++) {
-         if (i > j)
-            for (k = i; k < L; k++)
-               inv[i][j] = inv[i][j] + S_inv[k][i] * S_inv[k][j];
-         else
-            for (k = j; k < L; k++)
-               inv[i][j] = inv[i][j] + S_inv[k][i] * S_inv[k][j];
-      }
+      for (j = 0; j < L; j++)
+         inv[i][j] = cov[i][j];
 
-   for (i = 0; i < L; i++) {
-      free(S[i]);
-      free(S_inv[i]);
-   }
-   free(S);
-   free(S_inv);
+   if (mat_spdinv(inv[0], L, L, NULL) != 0)
+      for (i = 0; i < L; i++)
+         for (j = 0; j < L; j++)
+            inv[i][j] = 0.0;
 }
 
 void fillz_GMM(GMM * gmm)
@@ -233,10 +155,7 @@ double log_wgd(const GMM * gmm, const int m, const int L, const double *dat)
    sum = gmm->gauss[m].gconst;
 
    if (gmm->full != TR) {
-      for (l = 0; l < L; l++) {
-         tmp = dat[l] - gmm->gauss[m].mean[l];
-         sum += (tmp * tmp) / gmm->gauss[m].var[l];
-      }
+      sum += simd_wdist2(dat, gmm->gauss[m].mean, gmm->gauss[m].var, L);
    } else {
       diff = dgetmem(L);
       for (l = 0; l < L; l++) {
@@ -296,6 +215,7 @@ int alloc_GMM(GMM * gmm, const int M, const int L, const Boolean full)
    gmm->full = full;
    gmm->weight = dgetmem(M);
    gmm->gauss = (Gauss *) getmem(sizeof(Gauss), M);
+   gmm->fparam = NULL;
    for (m = 0; m < M; m++) {
       gmm->gauss[m].mean = dgetmem(L);
 
@@ -388,6 +308,76 @@ int prepareGconst_GMM(GMM * gmm)
    return (0);
 }
 
+/* float means and inverse variances (or inverse covariances) */
+int prepareFloat_GMM(GMM * gmm)
+{
+   int m, l, ll, L = gmm->dim, stride;
+   float *p;
+
+   stride = (gmm->full != TR) ? L + L : L + L * L;
+   if (gmm->fparam != NULL)
+      free(gmm->fparam);
+   gmm->fparam = fgetmem(gmm->nmix * stride);
+
+   for (m = 0; m < gmm->nmix; m++) {
+      p = gmm->fparam + m * stride;
+      for (l = 0; l < L; l++)
+         p[l] = gmm->gauss[m].mean[l];
+      p += L;
+      if (gmm->full != TR) {
+         for (l = 0; l < L; l++)
+            p[l] = 1.0 / gmm->gauss[m].var[l];
+      } else {
+         for (l = 0; l < L; l++)
+            for (ll = 0; ll < L; ll++)
+               p[l * L + ll] = gmm->gauss[m].inv[l][ll];
+      }
+   }
+
+   return (0);
+}
+
+double log_outpf(const GMM * gmm, const int L, const float *dat)
+{
+   int m, l, ll, stride;
+   float *mean, *prec, sum, tmp;
+   double logb;
+   static float *diff = NULL;
+   static int size = 0;
+
+   stride = (gmm->full != TR) ? L + L : L + L * L;
+   if (gmm->full == TR && L > size) {
+      if (diff != NULL)
+         free(diff);
+      diff = fgetmem(L);
+      size = L;
+   }
+
+   for (m = 0, logb = LZERO; m < gmm->nmix; m++) {
+      mean = gmm->fparam + m * stride;
+      prec = mean + L;
+      sum = 0.0f;
+      if (gmm->full != TR) {
+         for (l = 0; l < L; l++) {
+            tmp = dat[l] - mean[l];
+            sum += tmp * tmp * prec[l];
+         }
+      } else {
+         for (l = 0; l < L; l++)
+            diff[l] = dat[l] - mean[l];
+         for (l = 0; l < L; l++) {
+            for (ll = 0, tmp = 0.0f; ll < L; ll++)
+               tmp += diff[ll] * prec[l * L + ll];       /* symmetric */
+            sum += tmp * diff[l];
+         }
+      }
+      logb = log_add_in_gmm(logb, log(gmm->weight[m])
+                            - 0.5 * (gmm->gauss[m].gconst + sum));
+   }
+
+   return (logb);
+}
+
 int floorWeight_GMM(GMM * gmm, double floor)
 {
    int m;
@@ -452,6 +442,9 @@ int free_GMM(GMM * gmm)
    }
    free(gmm->gauss);
    free(gmm->weight);
+   if (gmm->fparam != NULL)
+      free(gmm->fparam);
+   gmm->fparam = NULL;
    gmm->nmix = 0;
    gmm->dim = 0;
    gmm->full = FA;
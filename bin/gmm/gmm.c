@@ -73,6 +73,8 @@
  *                              where (B1 + B2 + ... + Bb) = l                   *
  *               -c1   : inter-block correlation                      [FALSE]    * 
  *               -c2   : full covariance in each block                [FALSE]    *
+ *               --stats : write statistics of iterations to          [FALSE]    *
+ *                         stderr as JSON lines                                  *
  *       infile:                                                                 *
  *               training data sequence                               [stdin]    *
  *       stdout:                                                                 *
@@ -191,6 +193,9 @@ void usage(int status)
            "       -c1   : inter-block correlation                     [FALSE]\n");
    fprintf(stderr,
            "       -c2   : full covariance in each block               [FALSE]\n");
+   fprintf(stderr,
+           "       --stats : write statistics of iterations to         [FALSE]\n");
+   fprintf(stderr, "               stderr as JSON lines\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr,
            "       training data sequence (float)                      [stdin]\n");
@@ -238,7 +243,8 @@ int main(int argc, char **argv)
        0;
    void cal_inv(double **cov, double **inv, const int L);
    float_list *top, *cur, *prev, *tmpf, *tmpff;
-   Boolean block_full = FA, block_corr = FA, multiple_dim = FA, full_cov = FA;
+   Boolean block_full = FA, block_corr = FA, multiple_dim = FA, full_cov = FA,
+       stats = FA;
    int cov_dim = 0, dim_list[1024];
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
@@ -318,6 +324,11 @@ int main(int argc, char **argv)
                block_full = TR - block_full;
             }
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
          default:
             fprintf(stderr, "%s: Illegal option \"%s\".\n", cmnd, *argv);
             usage(1);
@@ -364,6 +375,9 @@ int main(int argc, char **argv)
       usage(1);
    }
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
+
    /* -- Count number of input vectors and read -- */
    dat = dgetmem(L);
    top = prev = (float_list *) getmem(1, sizeof(float_list));
@@ -401,6 +415,7 @@ int main(int argc, char **argv)
    }
 
    /* Initialization of GMM parameters */
+   stats_stage("init");
    alloc_GMM(&gmm, M, L, full);
    alloc_GMM(&tgmm, M, L, full);
 
@@ -567,6 +582,7 @@ int main(int argc, char **argv)
    }                            /* end of initialization */
 
    /* EM training of GMM parameters */
+   stats_stage("em");
    for (i = 0; (i <= Imax) && ((i <= Imin) || (fabs(change) > E)); i++) {
       fillz_GMM(&tgmm);
       fillz(sum, sizeof(double), M);
@@ -829,9 +845,12 @@ int main(int argc, char **argv)
       }
       floorVar_GMM(&gmm, V);
    }
+   stats_frame(i, fabs(change) > E);
 
    /*  Output GMM parameters */
+   stats_stage("write");
    save_GMM(&gmm, stdout);
+   stats_close();
 
    return (0);
 }
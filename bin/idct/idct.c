@@ -94,14 +94,6 @@ char *BOOL[] = { "FALSE", "TRUE" };
 /*  Command Name  */
 char *cmnd;
 
-/* workspace */
-static int dct_table_size = 0;
-static double *dct_workspace = NULL;
-static double *pLocalReal = NULL;
-static double *pLocalImag = NULL;
-static double *pWeightReal = NULL;
-static double *pWeightImag = NULL;
-
 Boolean dftmode = DFTMODE;
 int size = SIZE;
 
@@ -136,93 +128,10 @@ int usage(void)
    exit(1);
 }
 
-int idct_create_table(const int nSize)
-{
-   int k;
-
-   if (nSize == dct_table_size) {
-      /* no need to resize workspace */
-      return (0);
-   } else {
-      /* release resources to resize workspace */
-      if (dct_workspace != NULL) {
-         free(dct_workspace);
-         dct_workspace = NULL;
-      }
-      pLocalReal = NULL;
-      pLocalImag = NULL;
-      pWeightReal = NULL;
-      pWeightImag = NULL;
-   }
-
-   if (nSize <= 0) {
-      dct_table_size = 0;
-      fprintf(stderr, "DCT size must be positive!\n");
-      return (-1);
-   } else {
-      dct_table_size = nSize;
-      dct_workspace = dgetmem(dct_table_size * 8);
-      pWeightReal = dct_workspace;
-      pWeightImag = dct_workspace + 2 * dct_table_size;
-      pLocalReal = dct_workspace + (4 * dct_table_size);
-      pLocalImag = dct_workspace + (6 * dct_table_size);
-
-      for (k = 0; k < 2 * dct_table_size; k++) {
-         pWeightReal[k] = cos(k * PI / (2.0 * dct_table_size))
-             / sqrt(2.0 * dct_table_size);
-         pWeightImag[k] = -sin(k * PI / (2.0 * dct_table_size))
-             / sqrt(2.0 * dct_table_size);
-      }
-      pWeightReal[0] *= sqrt(2.0);
-      pWeightImag[0] *= sqrt(2.0);
-   }
-
-   return (0);
-}
-
-int idct(double *pReal, double *pImag,
-         const double *pInReal, const double *pInImag, int PowerOf2)
-{
-   int k, n;
-   double rtemp, itemp;
-
-   for (n = 1; n < dct_table_size; n++) {
-      pLocalReal[n] = pInReal[n];
-      pLocalImag[n] = pInImag[n];
-      pLocalReal[dct_table_size + n] = -pInReal[dct_table_size - n];
-      pLocalImag[dct_table_size + n] = -pInImag[dct_table_size - n];
-   }
-   pLocalReal[0] = pInReal[0];
-   pLocalImag[0] = pInImag[0];
-   pLocalReal[dct_table_size] = 0.0;
-   pLocalImag[dct_table_size] = 0.0;
-
-   /* 1/2 sample shift in the temporal domain */
-   for (k = 0; k < 2 * dct_table_size; k++) {
-      rtemp = pLocalReal[k];
-      itemp = pLocalImag[k];
-      pLocalReal[k] = rtemp * pWeightReal[k] - itemp * pWeightImag[k];
-      pLocalImag[k] = rtemp * pWeightImag[k] + itemp * pWeightReal[k];
-   }
-
-   if (size != PowerOf2 || dftmode) {
-      dft(pLocalReal, pLocalImag, dct_table_size * 2);
-   } else {
-      fft(pLocalReal, pLocalImag, dct_table_size * 2);
-   }
-
-   for (k = 0; k < dct_table_size; k++) {
-      pReal[k] = pLocalReal[k];
-      pImag[k] = pLocalImag[k];
-   }
-
-   return (0);
-}
-
 int main(int argc, char *argv[])
 {
    char *s, *infile = NULL, c;
-   int i, j, iter, size2;
+   int size2;
    double *x, *y, *pReal, *pImag;
    FILE *fp;
    Boolean comp = COMPLEX;
@@ -264,6 +173,11 @@ int main(int argc, char *argv[])
       fp = stdin;
    }
 
+   if (size <= 0) {
+      fprintf(stderr, "%s : DCT size must be positive!\n", cmnd);
+      usage();
+   }
+
    /* memory allocation */
    x = dgetmem(size2 = size + size);
    y = x + size;
@@ -281,13 +195,8 @@ int main(int argc, char *argv[])
          }
       }
 
-      /* decide wheather 'size' is a power of 2 or not */
-      for (iter = 0, i = size; (i /= 2) != 0; iter++);
-      for (i = 1, j = 1; i <= iter; i++, j *= 2);
-
       /* IDCT-II (DCT-III) routine */
-      idct_create_table(size);
-      idct(pReal, pImag, (const double *) x, (const double *) y, j);
+      idct(x, pReal, size, size, dftmode, comp);
 
       /* output IDCT sequence */
       fwritef(pReal, sizeof(*pReal), size, stdout);
@@ -64,6 +64,9 @@
        double delta   :   splitting factor
        double end     :   end condition
 
+       Each doubling of the codebook is reported to stats_frame() with
+       its number of centroid updates.
+
 ***********************************************************************************************/
 
 #include <stdio.h>
@@ -211,6 +214,7 @@ void lbg(double *x, const int l, const int tnum, double *icb, int icbsize,
                }
             }
       }
+      stats_frame((it <= iter) ? it : iter, it > iter);
       if (icbsize == ecbsize)
          break;
    }
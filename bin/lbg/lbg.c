@@ -72,6 +72,8 @@
 *                (level 2)                                                    *
 *                -d d      :  end condition                     [0.0001]      *
 *                -r r      :  splitting factor                  [0.0001]      *
+*                --stats   :  write statistics of iterations    [FALSE]       *
+*                             to stderr as JSON lines                         *
 *       infile:                                                               *
 *                training vector (stdin)                                      *
 *                        x(0), x(1), ... x(t*l-1)                             *
@@ -91,7 +93,7 @@
 *              codebook size (s and e) must be power of 2                     *
 *              -t option can be omitted, when input from redirect             *
 *      require:                                                               *
-*              lbg(), vq()                                                    *
+*              lbg(), vq(), stats_open()                                      *
 *                                                                             *
 ******************************************************************************/
 
@@ -186,6 +188,8 @@ void usage(int status)
    fprintf(stderr, "     (level 2)\n");
    fprintf(stderr, "       -d d  : end condition             [%g]\n", END);
    fprintf(stderr, "       -r r  : splitting factor          [%g]\n", DELTA);
+   fprintf(stderr, "       --stats : write statistics of iterations [FALSE]\n");
+   fprintf(stderr, "               to stderr as JSON lines\n");
    fprintf(stderr, "  stdin:\n");
    fprintf(stderr, "       data sequence (%s)\n", FORMAT);
    fprintf(stderr, "  stdout:\n");
@@ -215,6 +219,7 @@ int main(int argc, char **argv)
    double delta = DELTA, minerr = END, *x, *cb, *icb;
    double *p;
    float_list *top, *cur, *prev, *tmpf, *tmpff;
+   Boolean stats = FA;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -267,6 +272,13 @@ int main(int argc, char **argv)
             iter = atoi(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -276,6 +288,9 @@ int main(int argc, char **argv)
       } else
          fpi = getfp(*argv, "wb");
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
+
    /* -- Count number of input vectors and read -- */
    x = dgetmem(l);
    top = prev = (float_list *) malloc(sizeof(float_list));
@@ -330,9 +345,11 @@ int main(int argc, char **argv)
       }
    }
 
+   stats_stage("analysis");
    lbg(x, l, tnum, icb, icbsize, cb, ecbsize, iter, mintnum, seed, centup,
        delta, minerr);
 
+   stats_stage("write");
    fwritef(cb, sizeof(*cb), csize, stdout);
 
    if (fpi != NULL) {
@@ -342,6 +359,7 @@ int main(int argc, char **argv)
 
       fwritex(tindex, sizeof(*tindex), tnum, fpi);
    }
+   stats_close();
 
    return (0);
 }
@@ -99,10 +99,8 @@ static double lmafir(double x, double *c, const int m, double *d, const int m1,
    for (i = m - 1; i >= 1; i--)
       d[i] = d[i - 1];
    d[0] = x;
-   for (x = 0.0, i = m1; i <= m2; i++)
-      x += c[i] * d[i - 1];
 
-   return (x);
+   return (simd_dot(c + m1, d + m1 - 1, m2 - m1 + 1));
 }
 
 double lmadf(double x, double *c, const int m, const int pd, double *d)
@@ -48,7 +48,9 @@
 
     LPC Analysis Using Levinson-Durbin method
 
-       int lpc(x, flng, a, m);
+       int lpc(x, flng, a, m, f);
+       int lpc_batch(x, flng, nfrm, a, m, f, flag);
+       int lpcf(xf, flng, af, m, f);
 
        double  *x   : input sequence
        int     flng : flame length
@@ -61,10 +63,31 @@
                        -1 -> abnormally completed
                        -2 -> unstable LPC
 
+       lpc_batch() analyzes nfrm consecutive frames of x and
+       writes nfrm sets of m+1 coefficients to a.
+
+       int     nfrm : number of frames
+       int     *flag: return value of lpc() for each frame
+                      (may be NULL)
+
+       return value :  -1 if any frame is singular, else
+                       -2 if any frame is unstable, else 0
+
+       Autocorrelations of orders up to LPC_FFTORDER are
+       computed directly and higher ones by FFT.  The
+       Levinson-Durbin recursion is run for LPC_LANES frames
+       in lockstep with the frames in the innermost loops.
+       The coefficients of a singular frame are undefined.
+
+       lpcf() takes and returns float.  The autocorrelation is
+       computed in float and the recursion, which is only O(m^2),
+       in double.
+
 ******************************************************************/
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 #if defined(WIN32)
 #  include "SPTK.h"
@@ -93,3 +116,185 @@ int lpc(double *x, const int flng, double *a, const int m, const double f)
 
    return (flag);
 }
+
+int lpcf(float *x, const int flng, float *a, const int m, const double f)
+{
+   int i, k, flag;
+   float r0, r1;
+   static double *r = NULL;
+   static int size;
+
+   if (r == NULL || m > size) {
+      if (r != NULL)
+         free(r);
+      r = dgetmem(m + 1 + m + 1);
+      size = m;
+   }
+
+   /* two lags at a time as in acorr() */
+   for (k = 0; k + 1 <= m; k += 2) {
+      r0 = r1 = 0.0f;
+      for (i = 0; i < flng - k - 1; i++) {
+         r0 += x[i] * x[i + k];
+         r1 += x[i] * x[i + k + 1];
+      }
+      r0 += x[i] * x[i + k];
+      r[k] = r0;
+      r[k + 1] = r1;
+   }
+   for (; k <= m; k++) {
+      for (i = 0, r0 = 0.0f; i < flng - k; i++)
+         r0 += x[i] * x[i + k];
+      r[k] = r0;
+   }
+   flag = levdur(r, r + m + 1, m, f);
+   for (k = 0; k <= m; k++)
+      a[k] = r[m + 1 + k];
+
+   return (flag);
+}
+
+#define LPC_LANES 4
+#define LPC_FFTORDER 64
+
+static void acorr_fft(double *x, const int flng, double *r, const int m,
+                      double *re, double *im, const int fftl)
+{
+   int i;
+
+   for (i = 0; i < flng; i++)
+      re[i] = x[i];
+   for (; i < fftl; i++)
+      re[i] = 0.0;
+   fftr(re, im, fftl);
+   for (i = 0; i < fftl; i++) {
+      re[i] = re[i] * re[i] + im[i] * im[i];
+   }
+   fftr(re, im, fftl);
+   for (i = 0; i <= m; i++)
+      r[i] = re[i] / fftl;
+
+   return;
+}
+
+/* r, c and a hold LPC_LANES interleaved frames: x[k * LPC_LANES + lane] */
+static void levdur_lanes(double *r, double *c, double *a, const int m,
+                         const double eps, int *flag)
+{
+   int l, k, j;
+   double rmd[LPC_LANES], mue[LPC_LANES], *ak, *ck, *cl, *rl;
+
+   for (j = 0; j < LPC_LANES; j++) {
+      flag[j] = 0;
+      rmd[j] = r[j];
+      if (((rmd[j] < 0.0) ? -rmd[j] : rmd[j]) <= eps || rmd[j] != rmd[j])
+         flag[j] = -1;
+      a[j] = c[j] = 0.0;
+   }
+
+   for (l = 1; l <= m; l++) {
+      rl = r + l * LPC_LANES;
+      for (j = 0; j < LPC_LANES; j++)
+         mue[j] = -rl[j];
+      for (k = 1; k < l; k++) {
+         ck = c + k * LPC_LANES;
+         rl = r + (l - k) * LPC_LANES;
+         for (j = 0; j < LPC_LANES; j++)
+            mue[j] -= ck[j] * rl[j];
+      }
+      for (j = 0; j < LPC_LANES; j++)
+         mue[j] = mue[j] / rmd[j];
+
+      for (k = 1; k < l; k++) {
+         ak = a + k * LPC_LANES;
+         ck = c + k * LPC_LANES;
+         cl = c + (l - k) * LPC_LANES;
+         for (j = 0; j < LPC_LANES; j++)
+            ak[j] = ck[j] + mue[j] * cl[j];
+      }
+      ak = a + l * LPC_LANES;
+      for (j = 0; j < LPC_LANES; j++) {
+         ak[j] = mue[j];
+         rmd[j] = (1.0 - mue[j] * mue[j]) * rmd[j];
+         if (flag[j] == -1)
+            continue;
+         if (((rmd[j] < 0.0) ? -rmd[j] : rmd[j]) <= eps || rmd[j] != rmd[j])
+            flag[j] = -1;
+         else if (((mue[j] < 0.0) ? -mue[j] : mue[j]) >= 1.0)
+            flag[j] = -2;
+      }
+
+      for (k = 0; k < (l + 1) * LPC_LANES; k++)
+         c[k] = a[k];
+   }
+   for (j = 0; j < LPC_LANES; j++)
+      a[j] = sqrt(rmd[j]);
+
+   return;
+}
+
+int lpc_batch(double *x, const int flng, const int nfrm, double *a,
+              const int m, const double f, int *flag)
+{
+   int t, j, k, n, nl, fftl = 0, lflag[LPC_LANES], ret = 0;
+   double eps = f, *r, *c, *aa, *re = NULL, *im = NULL, *at;
+   static double *buf = NULL;
+   static int size = 0;
+
+   if (m >= LPC_FFTORDER)
+      for (fftl = 2; fftl < flng + m; fftl *= 2);
+
+   n = 3 * (m + 1) * LPC_LANES + 2 * fftl;
+   if (n > size) {
+      if (buf != NULL)
+         free(buf);
+      buf = dgetmem(n);
+      size = n;
+   }
+   r = buf;
+   c = r + (m + 1) * LPC_LANES;
+   aa = c + (m + 1) * LPC_LANES;
+   if (fftl > 0) {
+      re = aa + (m + 1) * LPC_LANES;
+      im = re + fftl;
+   }
+
+   if (eps < 0.0)
+      eps = 1.0e-6;
+
+   for (t = 0; t < nfrm; t += LPC_LANES) {
+      nl = (nfrm - t < LPC_LANES) ? nfrm - t : LPC_LANES;
+
+      /* autocorrelation of each frame, using its output slot as scratch */
+      for (j = 0; j < LPC_LANES; j++) {
+         if (j < nl) {
+            at = a + (t + j) * (m + 1);
+            if (fftl > 0)
+               acorr_fft(x + (t + j) * flng, flng, at, m, re, im, fftl);
+            else
+               acorr(x + (t + j) * flng, flng, at, m);
+            for (k = 0; k <= m; k++)
+               r[k * LPC_LANES + j] = at[k];
+         } else {
+            for (k = 0; k <= m; k++)
+               r[k * LPC_LANES + j] = (k == 0) ? 1.0 : 0.0;
+         }
+      }
+
+      levdur_lanes(r, c, aa, m, eps, lflag);
+
+      for (j = 0; j < nl; j++) {
+         at = a + (t + j) * (m + 1);
+         for (k = 0; k <= m; k++)
+            at[k] = aa[k * LPC_LANES + j];
+         if (flag != NULL)
+            flag[t + j] = lflag[j];
+         if (lflag[j] == -1)
+            ret = -1;
+         else if (lflag[j] == -2 && ret == 0)
+            ret = -2;
+      }
+   }
+
+   return (ret);
+}
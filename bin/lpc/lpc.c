@@ -62,7 +62,7 @@
 *               LP Coefficeints                                         *
 *                       , K, a(1), ..., a(m),                           *
 *       require:                                                        *
-*               lpc()                                                   *
+*               lpc_batch()                                             *
 *                                                                       *
 ************************************************************************/
 
@@ -93,6 +93,7 @@ static char *rcs_id = "$Id: lpc.c,v 1.27 2014/12/11 08:30:39 uratec Exp $";
 #define ORDER 25
 #define FLNG 256
 #define MINDET 0.000001
+#define BLOCK 64                /* number of frames analyzed at a time */
 
 /*  Command Name  */
 char *cmnd;
@@ -130,7 +131,7 @@ void usage(int status)
 
 int main(int argc, char **argv)
 {
-   int m = ORDER, l = FLNG, flag, t = 0;
+   int m = ORDER, l = FLNG, t = 0, n, i, *flags;
    FILE *fp = stdin;
    double *x, *a, f = MINDET;
 
@@ -162,27 +163,29 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   x = dgetmem(l + m + 1);
-   a = x + l;
-
-   while (freadf(x, sizeof(*x), l, fp) == l) {
-      flag = lpc(x, l, a, m, f);
-      switch (flag) {
-      case -1:
-         fprintf(stderr,
-                 "%s : The coefficient matrix of the normal equation is singular at %dth frame!\n",
-                 cmnd, t);
-         exit(1);
-         break;
-      case -2:
-         fprintf(stderr,
-                 "%s : Extracted LPC coefficients become unstable at %dth frame!\n",
-                 cmnd, t);
-         break;
-      }
+   x = dgetmem(BLOCK * (l + m + 1));
+   a = x + BLOCK * l;
+   flags = (int *) getmem(BLOCK, sizeof(*flags));
+
+   while ((n = freadf(x, sizeof(*x), BLOCK * l, fp) / l) > 0) {
+      lpc_batch(x, l, n, a, m, f, flags);
+      for (i = 0; i < n; i++, t++) {
+         switch (flags[i]) {
+         case -1:
+            fprintf(stderr,
+                    "%s : The coefficient matrix of the normal equation is singular at %dth frame!\n",
+                    cmnd, t);
+            exit(1);
+            break;
+         case -2:
+            fprintf(stderr,
+                    "%s : Extracted LPC coefficients become unstable at %dth frame!\n",
+                    cmnd, t);
+            break;
+         }
 
-      fwritef(a, sizeof(*a), m + 1, stdout);
-      t++;
+         fwritef(a + i * (m + 1), sizeof(*a), m + 1, stdout);
+      }
    }
 
    return (0);
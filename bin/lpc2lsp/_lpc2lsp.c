@@ -48,7 +48,9 @@
 
     Transformation LPC to LSP
 
-        int    lpc2lsp(lpc, lsp, order, numsp, maxp, maxq, eps)
+        int    lpc2lsp(lpc, lsp, order, numsp, maxitr, eps)
+        int    lpc2lsp_batch(lpc, lsp, order, nfrm, numsp, maxitr,
+                             eps, flag)
 
         double *lpc   : LPC
         double *lsp   : LSP
@@ -56,10 +58,28 @@
         int    numsp  : split number of unit circle
         int    maxitr : maximum number of interpolation
         double eps    : end condition for interpolation
+        int    nfrm   : number of frames
+        int    *flag  : return value of lpc2lsp() for each frame
+                        (may be NULL)
 
         return value
                    0  : completed normally
-                   -1 : completed irregularly
+                   -1 : completed irregularly (in any frame)
+
+    The sum and difference polynomials are evaluated as Chebyshev
+    series by the Clenshaw recurrence.  Each root bracketed by a
+    sign change is refined by the Illinois variant of regula falsi.
+
+    lpc2lsp_batch() converts nfrm frames (order+1 LPC and order
+    LSP per frame).  From the second frame on, the LSPs of the
+    previous frame split [-1, 1] into one interval per root; if
+    each polynomial changes sign on every one of its intervals,
+    then each interval holds exactly one root, because the number
+    of intervals equals the degree.  Only otherwise is the unit
+    circle scanned at numsp points.
+
+    The number of regula falsi steps spent on each frame is
+    reported to stats_frame().
 
 *****************************************************************/
 
@@ -73,6 +93,8 @@
 #  include <SPTK.h>
 #endif
 
+static int nitr;                /* refinement steps of the current frame */
+
 static double chebpoly(const double x, double *c, const int mh)
 {
    int i;
@@ -89,52 +111,32 @@ static double chebpoly(const double x, double *c, const int mh)
    return (b[0]);
 }
 
-int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
-            const int maxitr, const double eps)
+static void lsppoly(double *lpc, const int order, double *c1, double *c2,
+                    int *mh1, int *mh2)
 {
    int i;
    double *p1, *p2;
-   int mh1, mh2, mh, mm, itr, flag_odd;
-   double delta, x0, x1, g0, g1, x, y;
-   static double *c1 = NULL, *c2;
-   static int size_order;
 
-   delta = 1.0 / (double) numsp;
-
-   flag_odd = 0;
    if (order % 2 == 0)
-      mh1 = mh2 = order / 2;
+      *mh1 = *mh2 = order / 2;
    else {
-      mh1 = (order + 1) / 2;
-      mh2 = (order - 1) / 2;
-      flag_odd = 1;
-   }
-
-   if (c1 == NULL) {
-      c1 = dgetmem(2 * (mh1 + 1));
-      c2 = c1 + (mh1 + 1);
-      size_order = order;
-   }
-   if (order > size_order) {
-      free(c1);
-      c1 = dgetmem(2 * (mh1 + 1));
-      c2 = c1 + (mh1 + 1);
-      size_order = order;
+      *mh1 = (order + 1) / 2;
+      *mh2 = (order - 1) / 2;
    }
 
    /* calculate symmetric and antisymmetrica polynomials */
    p1 = lpc + 1;
    p2 = lpc + order;
-   c1[mh1] = c2[mh2] = 1.0;
-   if (flag_odd) {
-      c2[mh2 + 1] = 0.0;
-      for (i = mh2 - 1; i >= 0; i--) {
+   c1[*mh1] = c2[*mh2] = 1.0;
+   if (order % 2 != 0) {
+      c2[*mh2 + 1] = 0.0;
+      for (i = *mh2 - 1; i >= 0; i--) {
          c1[i + 1] = *p1 + *p2;
          c2[i] = *p1++ - *p2-- + c2[i + 2];
       }
       c1[0] = *p1 + *p2;
    } else {
-      for (i = mh1 - 1; i >= 0; i--) {
+      for (i = *mh1 - 1; i >= 0; i--) {
          c1[i] = *p1 + *p2 - c1[i + 1];
          c2[i] = *p1++ - *p2-- + c2[i + 1];
       }
@@ -142,7 +144,50 @@ int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
    c1[0] *= 0.5;
    c2[0] *= 0.5;
 
-   /* root search */
+   return;
+}
+
+/* root in [x1, x0] where g0 = c(x0) and g1 = c(x1) differ in sign */
+static double refine(double *c, const int mh, double x0, double g0,
+                     double x1, double g1, const int maxitr, const double eps)
+{
+   int itr, side = 0;
+   double x, y;
+
+   for (itr = 0; itr < maxitr; itr++) {
+      nitr++;
+      x = (g1 * x0 - g0 * x1) / (g1 - g0);
+      y = chebpoly(x, c, mh);
+      if (y == 0.0 || fabs(y) <= eps)
+         return (x);
+
+      if (y * g0 < 0.0) {
+         x1 = x;
+         g1 = y;
+         if (side == -1)
+            g0 *= 0.5;
+         side = -1;
+      } else {
+         x0 = x;
+         g0 = y;
+         if (side == 1)
+            g1 *= 0.5;
+         side = 1;
+      }
+   }
+
+   return ((g1 * x0 - g0 * x1) / (g1 - g0));
+}
+
+static int scan(double *c1, double *c2, const int mh1, const int mh2,
+                double *lsp, const int order, const int numsp,
+                const int maxitr, const double eps)
+{
+   int mh, mm;
+   double *p1, delta, x, g0, g1;
+
+   delta = 1.0 / (double) numsp;
+
    p1 = c1;
    mh = mh1;
    g0 = chebpoly(1.0, p1, mh);
@@ -152,27 +197,10 @@ int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
       g1 = chebpoly(x, p1, mh);
 
       if (g0 * g1 <= 0.0) {
-         x0 = x + delta;
-         x1 = x;
-
-         itr = 0;
-         do {
-            x = (x0 + x1) / 2.0;
-            y = chebpoly(x, p1, mh);
-
-            if (y * g0 < 0.0) {
-               x1 = x;
-               g1 = y;
-            } else {
-               x0 = x;
-               g0 = y;
-            }
-
-            itr++;
-         }
-         while ((fabs(y) > eps) && (itr < maxitr));
-
-         x = (g1 * x0 - g0 * x1) / (g1 - g0);
+         if (g0 == 0.0)
+            x += delta;
+         else if (g1 != 0.0)
+            x = refine(p1, mh, x + delta, g0, x, g1, maxitr, eps);
          lsp[mm] = acos(x) / PI2;
 
          mm++;
@@ -193,3 +221,116 @@ int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
    }
    return (-1);
 }
+
+/* track roots within the intervals given by the LSPs in lsp */
+static int track(double *c1, double *c2, const int mh1, const int mh2,
+                 double *lsp, double *b, const int order, const int maxitr,
+                 const double eps)
+{
+   int k, mh;
+   double *p, *g, x;
+
+   g = b + order + 1;
+
+   for (k = 1; k < order; k++)
+      if (lsp[k] <= lsp[k - 1])
+         return (-1);
+   if (lsp[0] <= 0.0 || lsp[order - 1] >= 0.5)
+      return (-1);
+
+   b[0] = 1.0;
+   for (k = 1; k < order; k++)
+      b[k] = 0.5 * (cos(PI2 * lsp[k - 1]) + cos(PI2 * lsp[k]));
+   b[order] = -1.0;
+
+   /* every interval must be a bracket before anything is written */
+   for (k = 0; k < order; k++) {
+      p = (k % 2 == 0) ? c1 : c2;
+      mh = (k % 2 == 0) ? mh1 : mh2;
+      g[2 * k] = chebpoly(b[k], p, mh);
+      g[2 * k + 1] = chebpoly(b[k + 1], p, mh);
+      if (g[2 * k] * g[2 * k + 1] >= 0.0)
+         return (-1);
+   }
+
+   /* the intervals are wider than a grid step, so allow more steps */
+   for (k = 0; k < order; k++) {
+      p = (k % 2 == 0) ? c1 : c2;
+      mh = (k % 2 == 0) ? mh1 : mh2;
+      x = refine(p, mh, b[k], g[2 * k], b[k + 1], g[2 * k + 1], 2 * maxitr,
+                 eps);
+      lsp[k] = acos(x) / PI2;
+   }
+
+   return (0);
+}
+
+int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
+            const int maxitr, const double eps)
+{
+   int mh1, mh2, f;
+   static double *c1 = NULL, *c2;
+   static int size_order;
+
+   if (c1 == NULL) {
+      c1 = dgetmem(2 * (order / 2 + 2));
+      c2 = c1 + (order / 2 + 2);
+      size_order = order;
+   }
+   if (order > size_order) {
+      free(c1);
+      c1 = dgetmem(2 * (order / 2 + 2));
+      c2 = c1 + (order / 2 + 2);
+      size_order = order;
+   }
+
+   lsppoly(lpc, order, c1, c2, &mh1, &mh2);
+
+   nitr = 0;
+   f = scan(c1, c2, mh1, mh2, lsp, order, numsp, maxitr, eps);
+   stats_frame(nitr, f != 0);
+
+   return (f);
+}
+
+int lpc2lsp_batch(double *lpc, double *lsp, const int order, const int nfrm,
+                  const int numsp, const int maxitr, const double eps,
+                  int *flag)
+{
+   int t, k, mh1, mh2, f, ret = 0;
+   double *l;
+   static double *c1 = NULL, *c2, *b;
+   static int size_order;
+
+   if (c1 == NULL || order > size_order) {
+      if (c1 != NULL)
+         free(c1);
+      c1 = dgetmem(2 * (order / 2 + 2) + 3 * order + 1);
+      c2 = c1 + (order / 2 + 2);
+      b = c2 + (order / 2 + 2);
+      size_order = order;
+   }
+
+   for (t = 0; t < nfrm; t++) {
+      lsppoly(lpc + t * (order + 1), order, c1, c2, &mh1, &mh2);
+      l = lsp + t * order;
+
+      nitr = 0;
+      f = -1;
+      if (t > 0) {
+         for (k = 0; k < order; k++)
+            l[k] = l[k - order];
+         f = track(c1, c2, mh1, mh2, l, b, order, maxitr, eps);
+      }
+      if (f != 0)
+         f = scan(c1, c2, mh1, mh2, l, order, numsp, maxitr, eps);
+      stats_frame(nitr, f != 0);
+
+      if (flag != NULL)
+         flag[t] = f;
+      if (f != 0)
+         ret = -1;
+   }
+
+   return (ret);
+}
@@ -64,6 +64,8 @@
 *               -n n  :  split number of unit circle             [128]   *
 *               -p p  :  maximum number of interpolation         [4]     *
 *               -d d  :  end condition of interpolation          [1e-6]  *
+*               --stats : write statistics of iterations to      [FALSE] *
+*                         stderr as JSON lines                           *
 *      infile:                                                           *
 *               LP coefficients                                          *
 *                       , K, a(1), ..., a(m),                            *
@@ -76,7 +78,7 @@
 *               LSP                                                      *
 *                       , f(1), ..., f(m),                               *
 *      require:                                                          *
-*              lpc2lsp()                                                 *
+*              lpc2lsp_batch(), stats_open()                             *
 *                                                                        *
 *************************************************************************/
 
@@ -113,6 +115,8 @@ static char *rcs_id = "$Id: lpc2lsp.c,v 1.35 2014/12/11 08:30:39 uratec Exp $";
 #define END      1e-6
 #define GAIN     TR
 #define LOGGAIN  FA
+#define STATS    FA
+#define BLOCK    256            /* number of frames converted at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -157,6 +161,10 @@ void usage(int status)
    fprintf(stderr,
            "       -d d  : end condition of interpolation          [%g]\n",
            END);
+   fprintf(stderr,
+           "       --stats : write statistics of iterations to     [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               stderr as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr,
@@ -175,10 +183,10 @@ void usage(int status)
 
 int main(int argc, char **argv)
 {
-   int m = ORDER, otype = OTYPE, n = SPNUM, p = MAXITR, i;
+   int m = ORDER, otype = OTYPE, n = SPNUM, p = MAXITR, i, t, nfrm;
    FILE *fp = stdin;
-   double *a, *lsp, end = END, sampling = SAMPLING;
-   Boolean gain = GAIN, loggain = LOGGAIN;
+   double *a, *lsp, *l, *k, end = END, sampling = SAMPLING;
+   Boolean gain = GAIN, loggain = LOGGAIN, stats = STATS;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -218,6 +226,13 @@ int main(int argc, char **argv)
          case 'L':
             loggain = 1 - loggain;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -227,29 +242,39 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   lsp = dgetmem(m + m + 1);
-   a = lsp + m;
-
-   while (freadf(a, sizeof(*a), m + 1, fp) == m + 1) {
-      lpc2lsp(a, lsp, m, n, p, end);
-
-      if (otype == 0)
-         for (i = 0; i < m; i++)
-            lsp[i] *= PI2;
-      else if (otype == 2 || otype == 3)
-         for (i = 0; i < m; i++)
-            lsp[i] *= sampling;
-      if (otype == 3)
-         for (i = 0; i < m; i++)
-            lsp[i] *= 1000;
-
-      if (gain) {
-         if (loggain)
-            *a = log(*a);
-         fwritef(a, sizeof(*a), 1, stdout);
+   lsp = dgetmem(BLOCK * (m + m + 1));
+   a = lsp + BLOCK * m;
+
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
+   while ((nfrm = freadf(a, sizeof(*a), BLOCK * (m + 1), fp) / (m + 1)) > 0) {
+      stats_stage("analysis");
+      lpc2lsp_batch(a, lsp, m, nfrm, n, p, end, NULL);
+
+      stats_stage("write");
+      for (t = 0; t < nfrm; t++) {
+         l = lsp + t * m;
+         if (otype == 0)
+            for (i = 0; i < m; i++)
+               l[i] *= PI2;
+         else if (otype == 2 || otype == 3)
+            for (i = 0; i < m; i++)
+               l[i] *= sampling;
+         if (otype == 3)
+            for (i = 0; i < m; i++)
+               l[i] *= 1000;
+
+         if (gain) {
+            k = a + t * (m + 1);
+            if (loggain)
+               *k = log(*k);
+            fwritef(k, sizeof(*k), 1, stdout);
+         }
+         fwritef(l, sizeof(*l), m, stdout);
       }
-      fwritef(lsp, sizeof(*lsp), m, stdout);
+      stats_stage("read");
    }
+   stats_close();
 
    return (0);
 }
@@ -47,12 +47,25 @@
 
     Transform LSP to spectrum
 
-        void   lsp2sp(lsp, m, x, l)
+        void   lsp2sp(lsp, m, x, l, gain)
+        void   lsp2sp_batch(lsp, m, x, l, gain, nfrm)
+        void   lsp2sp_warp(lsp, m, w, x, l, gain, nfrm)
 
         double   *lsp  : LSP
         int      m   : order of LSP
+        double   *w  : frequencies of the l bins
         double   *x  : real part of spectrum
         double   l   : FFT length
+        int      gain: 1 if lsp[0] is the gain
+        int      nfrm: number of frames
+
+    The log amplitude of each bin is evaluated from the products
+    of (cos(w) - cos(lsp)), which are kept normalized with frexp()
+    so that only one logarithm is taken per polynomial and bin.
+    cos(w) and the terms depending only on w are computed once
+    per call and cos(lsp) once per frame, so lsp2sp_batch()
+    amortizes them over nfrm frames.  lsp2sp_warp() leaves out
+    the gain and takes arbitrary frequencies (used by mgclsp2sp).
 
 ***************************************************************/
 
@@ -94,37 +107,122 @@ double log_add(double x, double y)
       return lmax + log_conv(exp(lmin - lmax) + 1.0);
 }
 
-void lsp2sp(double *lsp, const int m, double *x, const int l, const int gain)
+/* 2 log |prod_i (cw - cl[2i])|, i = 0, ..., n-1 */
+static double lsplog(const double *cl, const int n, const double cw,
+                     const double ln2)
 {
-   int i, p;
-   double w, eq1, eq2, ap = 0.0;
+   int i, e, ex = 0, nz = 0;
+   double f, p = 1.0;
+
+   for (i = 0; i < n; i++) {
+      f = cw - cl[i + i];
+      if (f == 0.0) {
+         nz++;
+         continue;
+      }
+      p *= f;
+      if ((i & 7) == 7) {
+         p = frexp(p, &e);
+         ex += e;
+      }
+   }
 
+   return 2.0 * (log(fabs(p)) + ex * ln2 + nz * LZERO);
+}
+
+void lsp2sp_warp(double *lsp, const int m, const double *w, double *x,
+                 const int l, const int gain, const int nfrm)
+{
+   int i, n, p;
+   double *cl, *cw, *h1, *h2, ln2, ap;
+   static double *buf = NULL;
+   static int size, msize;
+
+   if (buf == NULL) {
+      buf = dgetmem(3 * l + m);
+      size = l;
+      msize = m;
+   }
+   if (l > size || m > msize) {
+      free(buf);
+      size = (l > size) ? l : size;
+      msize = (m > msize) ? m : msize;
+      buf = dgetmem(3 * size + msize);
+   }
+   cw = buf;
+   h1 = cw + size;
+   h2 = h1 + size;
+   cl = h2 + size;
+
+   ln2 = log(2.0);
    for (p = 0; p < l; p++) {
-      eq1 = 0.0;
-      eq2 = 0.0;
-      w = p * (M_PI / (l - 1));
+      cw[p] = cos(w[p]);
+      if (m % 2 == 0) {
+         h1[p] = 2 * log_conv(cos(w[p] / 2));
+         h2[p] = 2 * log_conv(sin(w[p] / 2));
+      } else {
+         h1[p] = 0.0;
+         h2[p] = 2 * log_conv(sin(w[p]));
+      }
+   }
+
+   for (n = 0; n < nfrm; n++, lsp += m + gain, x += l) {
+      for (i = 0; i < m; i++)
+         cl[i] = cos(lsp[i + gain]);
 
       if (m % 2 == 0) {
-         for (i = 0; i < m / 2; i++) {
-            eq1 += 2 * log_conv(cos(w) - cos(lsp[2 * i + gain]));
-            eq2 += 2 * log_conv(cos(w) - cos(lsp[2 * i + 1 + gain]));
+         for (p = 0; p < l; p++) {
+            ap = m * ln2 + log_add(lsplog(cl, m / 2, cw[p], ln2) + h1[p],
+                                   lsplog(cl + 1, m / 2, cw[p], ln2) + h2[p]);
+            x[p] = -0.5 * ap;
          }
-         eq1 += 2 * log_conv(cos(w / 2));
-         eq2 += 2 * log_conv(sin(w / 2));
-
-         ap = m * log(2) + log_add(eq1, eq2);
       } else {
-         for (i = 0; i < (m + 1) / 2; i++)
-            eq1 += 2 * log_conv(cos(w) - cos(lsp[2 * i + gain]));
-         for (i = 0; i < (m - 1) / 2; i++)
-            eq2 += 2 * log_conv(cos(w) - cos(lsp[2 * i + 1 + gain]));
-         eq2 += 2 * log_conv(sin(w));
-
-         ap = (m - 1) * log(2) + log_add(eq1, eq2);
+         for (p = 0; p < l; p++) {
+            ap = (m - 1) * ln2
+                + log_add(lsplog(cl, (m + 1) / 2, cw[p], ln2) + h1[p],
+                          lsplog(cl + 1, (m - 1) / 2, cw[p], ln2) + h2[p]);
+            x[p] = -0.5 * ap;
+         }
       }
+   }
+
+   return;
+}
+
+void lsp2sp_batch(double *lsp, const int m, double *x, const int l,
+                  const int gain, const int nfrm)
+{
+   int n, p;
+   static double *w = NULL;
+   static int size, len = 0;
 
-      x[p] = -0.5 * ap;
-      if (gain == 1)
-         x[p] += lsp[0];
+   if (w == NULL) {
+      w = dgetmem(l);
+      size = l;
+   }
+   if (l > size) {
+      free(w);
+      w = dgetmem(l);
+      size = l;
+      len = 0;
    }
+   if (l != len) {
+      for (p = 0; p < l; p++)
+         w[p] = p * (M_PI / (l - 1));
+      len = l;
+   }
+
+   lsp2sp_warp(lsp, m, w, x, l, gain, nfrm);
+
+   if (gain == 1)
+      for (n = 0; n < nfrm; n++)
+         for (p = 0; p < l; p++)
+            x[n * l + p] += lsp[n * (m + 1)];
+
+   return;
+}
+
+void lsp2sp(double *lsp, const int m, double *x, const int l, const int gain)
+{
+   lsp2sp_batch(lsp, m, x, l, gain, 1);
 }
@@ -109,6 +109,7 @@ static char *rcs_id = "$Id: lsp2sp.c,v 1.6 2014/12/11 08:30:40 uratec Exp $";
 #define GAIN 1
 #define LENG 256
 #define OTYPE 0
+#define BLOCK 64                /* number of frames transformed at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -170,8 +171,8 @@ int main(int argc, char **argv)
    int leng = LENG, m = ORDER, itype = ITYPE, otype = OTYPE, gain = GAIN;
    FILE *fp = stdin;
    double logk, sampling = SAMPLING;
-   double *x, *lsp;
-   int i, no, loggain = 1;
+   double *x, *lsp, *lp;
+   int i, j, n, no, loggain = 1;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -227,47 +228,49 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   lsp = dgetmem(m + gain);
    no = leng / 2 + 1;
-   x = dgetmem(no);
+   x = dgetmem(BLOCK * (no + m + gain));
+   lsp = x + BLOCK * no;
    logk = 20.0 / log(10.0);
 
-   while (freadf(lsp, sizeof(*lsp), m + gain, fp) == m + gain) {
+   while ((n =
+           freadf(lsp, sizeof(*lsp), BLOCK * (m + gain), fp) / (m + gain)) > 0) {
+      for (j = 0; j < n; j++) {
+         lp = lsp + j * (m + gain);
+         if (itype == 1)
+            for (i = gain; i < m + gain; i++)
+               lp[i] *= PI2;
+         else if (itype == 2 || itype == 3) {
+            for (i = gain; i < m + gain; i++)
+               lp[i] = lp[i] / sampling * PI2;
+         }
 
-      if (itype == 1)
-         for (i = gain; i < m + gain; i++)
-            lsp[i] *= PI2;
-      else if (itype == 2 || itype == 3) {
-         for (i = gain; i < m + gain; i++)
-            lsp[i] = lsp[i] / sampling * PI2;
+         if (loggain == 0)
+            *lp = log(*lp);
       }
 
-      if (loggain == 0)
-         *lsp = log(*lsp);
-
-      lsp2sp(lsp, m, x, no, gain);
+      lsp2sp_batch(lsp, m, x, no, gain, n);
 
       switch (otype) {
       case 1:
          break;
       case 2:
-         for (i = no; i--;)
+         for (i = n * no; i--;)
             x[i] = exp(x[i]);
          break;
       case 3:
-         for (i = no; i--;)
+         for (i = n * no; i--;)
             x[i] = exp(2 * x[i]);
          break;
       default:
-         for (i = no; i--;)
+         for (i = n * no; i--;)
             x[i] *= logk;
          break;
       }
-      fwritef(x, sizeof(*x), no, stdout);
+      fwritef(x, sizeof(*x), n * no, stdout);
    }
 
    free(x);
-   free(lsp);
 
    return (0);
 }
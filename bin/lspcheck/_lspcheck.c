@@ -94,6 +94,11 @@ int lspcheck(double *lsp, const int ord)
        int        ord : order of LSP
        double     min : minimal distance between two consecutive LSPs
 
+    Violating pairs are moved apart symmetrically, pass by pass.
+    If the LSPs are still unstable after TH passes, the distances
+    are enforced by one forward and one backward pass so that the
+    result is always ordered.
+
 *****************************************************************/
 
 void lsparrange(double *lsp, int ord, double min)
@@ -122,8 +127,22 @@ void lsparrange(double *lsp, int ord, double min)
       }
 
       if (!flag)
-         break;
+         return;
    }
+   if (lspcheck(lsp, ord) == 0)
+      return;
+
+   /* still unstable after pairwise adjustment: enforce distances directly */
+   if (lsp[0] < min)
+      lsp[0] = min;
+   for (i = 1; i < ord; i++)
+      if (lsp[i] < lsp[i - 1] + min)
+         lsp[i] = lsp[i - 1] + min;
+   if (lsp[ord - 1] > 0.5 - min)
+      lsp[ord - 1] = 0.5 - min;
+   for (i = ord - 2; i >= 0; i--)
+      if (lsp[i] > lsp[i + 1] - min)
+         lsp[i] = lsp[i + 1] - min;
 
    return;
 }
@@ -90,7 +90,7 @@ int mcep(double *xw, const int flng, double *mc, const int m, const double a,
          const int itr1, const int itr2, const double dd, const int etype,
          const double e, const double f, const int itype)
 {
-   int i, j;
+   int i, j, iter;
    int flag = 0, f2, m2;
    double t, s, eps = 0.0, min, max;
    static double *x = NULL, *y, *c, *d, *al, *b;
@@ -198,9 +198,9 @@ int mcep(double *xw, const int flng, double *mc, const int m, const double a,
       if (x[i] <= 0.0) {
          fprintf(stderr,
                  "mcep : periodogram has '0', use '-e' option to floor it!\n");
-	 return 4;
+         stats_frame(0, TR);
+         return 4;
       }
-      c[i] = log(x[i]);
    }
 
    /*  1, (-a), (-a)^2, ..., (-a)^M  */
@@ -208,6 +208,9 @@ int mcep(double *xw, const int flng, double *mc, const int m, const double a,
    for (i = 1; i <= m; i++)
       al[i] = -a * al[i - 1];
 
+   for (i = 0; i < flng; i++)
+      c[i] = log(x[i]);
+
    /*  initial value of cepstrum  */
    ifftr(c, y, flng);           /*  c : IFFT[x]  */
 
@@ -247,12 +250,16 @@ int mcep(double *xw, const int flng, double *mc, const int m, const double a,
 
       if (theq(c, y, d, b, m + 1, f)) {
          fprintf(stderr, "mcep : Error in theq() at %dth iteration !\n", j);
+         stats_frame(j, TR);
          return 3;
       }
 
       for (i = 0; i <= m; i++)
          mc[i] += d[i];
    }
+   iter = (j <= itr2) ? j : itr2;
+
+   stats_frame(iter, !flag);
 
    if (flag)
       return (0);
@@ -261,6 +268,94 @@ int mcep(double *xw, const int flng, double *mc, const int m, const double a,
 
 }
 
+/***************************************************************
+
+    Warm Start of Iterative Cepstral Analysis
+
+        void cepwarm_init(w, on)
+        void cepwarm_free(w)
+
+        CepWarm *w  : state kept between frames
+        Boolean on  : start each frame from the coefficients of
+                      the previous frame
+
+    When w->on is TR, gcep_warm() and mgcep_warm() start from
+    the solution of the previous frame, which is usually close
+    to that of the current frame, and fall back to the usual
+    initial value if it does not converge.  A frame that falls
+    back is marked as restarted in its stats_frame() record.
+    mcep() has no warm start: its initial value from the
+    periodogram is closer than the previous solution, and the
+    end condition on r(0) can stop a warm start far from the
+    optimum.
+
+***************************************************************/
+
+void cepwarm_init(CepWarm * w, const Boolean on)
+{
+   w->on = on;
+   w->m = -1;
+   w->prev = NULL;
+   w->size = 0;
+   w->fallback = FA;
+}
+
+void cepwarm_free(CepWarm * w)
+{
+   if (w->prev != NULL)
+      free(w->prev);
+   w->prev = NULL;
+   w->size = 0;
+   w->m = -1;
+}
+
+/* previous solution is available */
+int cepwarm_ready(CepWarm * w, const int m)
+{
+   if (w == NULL)
+      return (0);
+   w->fallback = FA;
+
+   return (w->on && w->m == m);
+}
+
+/* all coefficients are finite */
+int cepwarm_valid(const double *c, const int m)
+{
+   int i;
+
+   for (i = 0; i <= m; i++)
+      if (c[i] != c[i] || fabs(c[i]) > 1.0e+30)
+         return (0);
+
+   return (1);
+}
+
+/* keep the solution for the next frame; call before stats_frame() */
+void cepwarm_done(CepWarm * w, const double *c, const int m)
+{
+   if (w == NULL)
+      return;
+
+   if (w->fallback)
+      stats_restart();
+
+   if (!w->on)
+      return;
+   if (!cepwarm_valid(c, m)) {
+      w->m = -1;
+      return;
+   }
+   if (m + 1 > w->size) {
+      if (w->prev != NULL)
+         free(w->prev);
+      w->size = m + 1;
+      w->prev = dgetmem(w->size);
+   }
+   movem((double *) c, w->prev, sizeof(*c), m + 1);
+   w->m = m;
+}
+
 /***************************************************************
 
     Frequency Transformation for Calculating Coefficients
@@ -69,6 +69,8 @@
 *               -E E     :  floor in db calculated per frame[N/A]       *
 *               -f f     :  minimum value of the determinant            *
 *                           of the normal matrix            [0.000001]  *
+*               --stats  :  write statistics of iterations  [FALSE]     *
+*                           to stderr as JSON lines                     *
 *       infile:                                                         *
 *               windowed sequence (if q==0)                             *
 *                       , x(0), x(1), ..., x(L-1),                      *
@@ -81,7 +83,7 @@
 *               value of e must be e>=0                                 *
 *               value of E must be E<0                                  *
 *       require:                                                        *
-*               mcep()                                                  *
+*               mcep(), stats_open()                                    *
 *                                                                       *
 ************************************************************************/
 
@@ -119,9 +121,11 @@ static char *rcs_id = "$Id: mcep.c,v 1.34 2014/12/11 08:30:40 uratec Exp $";
 #define END 0.001
 #define EPS 0.0
 #define MINDET 0.000001
+#define STATS FA
 
 /*  Command Name  */
 char *cmnd;
+char *BOOL[] = { "FALSE", "TRUE" };
 
 
 void usage(int status)
@@ -159,6 +163,9 @@ void usage(int status)
    fprintf(stderr, "       -f f  : minimum value of the determinant [%g]\n",
            MINDET);
    fprintf(stderr, "               of the normal matrix\n");
+   fprintf(stderr, "       --stats : write statistics of iterations [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               to stderr as JSON lines\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr, "       windowed sequences (%s)              [stdin]\n",
            FORMAT);
@@ -182,6 +189,7 @@ int main(int argc, char **argv)
    int m = ORDER, flng = FLENG, ilng = FLENG, itr1 = MINITR, itr2 =
        MAXITR, itype = ITYPE, etype = ETYPE, flag = 0;
    FILE *fp = stdin;
+   Boolean stats = STATS;
    double *mc, *x, a = ALPHA, end = END, e = EPS, f = MINDET;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
@@ -233,6 +241,13 @@ int main(int argc, char **argv)
             f = atof(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -250,10 +265,16 @@ int main(int argc, char **argv)
    x = dgetmem(flng + m + 1);
    mc = x + flng;
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
    while (freadf(x, sizeof(*x), ilng, fp) == ilng) {
+      stats_stage("analysis");
       flag = mcep(x, flng, mc, m, a, itr1, itr2, end, etype, e, f, itype);
+      stats_stage("write");
       fwritef(mc, sizeof(*mc), m + 1, stdout);
+      stats_stage("read");
    }
+   stats_close();
 
    return (0);
 }
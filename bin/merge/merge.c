@@ -167,11 +167,10 @@ void usage(int status)
 int main(int argc, char **argv)
 {
    FILE *fp2 = NULL, *fp1 = stdin;
-   int start = START, leng1 = LENG1, leng2 = LENG2, i, j, flag = 1;
+   int start = START, leng1 = LENG1, leng2 = LENG2, i, k, n, flag = 1;
    size_t size = sizeof(float);
    Boolean write = WRITE;
-   char *y, c, *s;
-   long double x;
+   char *x, *y, c, *s;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -282,30 +281,30 @@ int main(int argc, char **argv)
       usage(1);
    }
 
-   y = (char *) dgetmem(leng2 * size);
+   x = (char *) getmem(leng1 + leng2, size);
+   y = x + leng1 * size;
 
    for (;;) {
-      for (j = start, i = leng1; j-- && i--;) {
-         if (freadx(&x, size, 1, fp1) != 1)
-            break;
-         fwritex(&x, size, 1, stdout);
-      }
-      for (j = leng2; j--;)
-         if (write) {
-            if (freadx(&x, size, 1, fp1) != 1)
-               break;
-            i--;
-         }
+      /* the leading min(start, leng1) items; i is left as the item-wise
+         loop "for (j = start, i = leng1; j-- && i--;)" would leave it */
+      k = (start >= 0 && start < leng1) ? start : leng1;
+      n = freadx(x, size, k, fp1);
+      fwritex(x, size, n, stdout);
+      if (n < k)
+         i = leng1 - n - 1;
+      else
+         i = (start >= 0 && start <= leng1) ? leng1 - start : -1;
+      if (write)
+         i -= freadx(x, size, leng2, fp1);
       if (freadx(y, size, leng2, fp2) != leng2)
          if (!flag)
             break;
 
       fwritex(y, size, leng2, stdout);
       flag = 0;
-      for (; i-- > 0;) {
-         if (freadx(&x, size, 1, fp1) != 1)
-            break;
-         fwritex(&x, size, 1, stdout);
+      if (i > 0) {
+         n = freadx(x, size, i, fp1);
+         fwritex(x, size, n, stdout);
       }
    }
 
@@ -51,8 +51,21 @@
         void mfcc(in, mc, sampleFreq, alpha, eps, wlng, flng
                   m, n, ceplift, dftmode, usehamming);
 
-        double  *in        : input sequence
+        int  mfcc_init(s, sampleFreq, alpha, eps, wlng, flng,
+                       m, n, ceplift, usehamming);
+        void mfcc_batch(s, in, nfrm, mc);
+        void mfcc_batchf(s, inf, nfrm, mcf);
+        void mfcc_logmel(s, in, nfrm, fb);
+        void mfcc_free(s);
+
+        MFCC    *s         : extractor
+        double  *in        : input sequence (nfrm x wlng for mfcc_batch)
         double  *mc        : mel-frequency cepstral coefficients
+                             (m + 1 per frame: mc(1), ..., mc(m-1),
+                              C0, energy)
+        double  *fb        : log mel filter bank outputs
+                             (n + 1 per frame: channels 1, ..., n,
+                              energy)
         double  sampleFreq : sample frequency
         double  alpha      : pre-emphasis coefficient
         double  eps        : epsilon
@@ -60,10 +73,27 @@
         int     flng       : frame length for fft
         int     m          : order of cepstrum
         int     n          : number of channel for mel-filter bank
+        int     nfrm       : number of frames
         int     ceplift    : liftering coefficients
-        Boolean dftmode    : use dft
+        Boolean dftmode    : use dft (not used; the DCT is a matrix product)
         Boolean usehamming : use hamming window
 
+        return value of mfcc_init : 0 -> normally completed
+                                   -1 -> invalid FFT length
+
+    mfcc_init() computes everything that depends only on the
+    configuration: the channel and weight of each FFT bin of the
+    mel filter bank, the window, the DCT-II matrix and the
+    liftering weights.  mfcc_batch() then does no allocation
+    except growing its work buffers to the number of frames; the
+    filter bank is applied as a sparse product (two channels per
+    bin) and the DCT of all frames as one matrix product.  mfcc()
+    keeps an extractor for the last configuration.
+
+    mfcc_batchf() takes and returns float and runs the per-sample
+    stages up to the filter bank, including the FFT, in float;
+    the logarithm and the DCT of the n channels stay in double.
+
 ******************************************************************/
 
 #include <stdio.h>
@@ -97,10 +127,7 @@ double sample_mel(int sample, int num, double fs)
 
 double cal_energy(double *x, const int leng)
 {
-   int k;
-   double energy = 0.0;
-   for (k = 0; k < leng; k++)
-      energy += x[k] * x[k];
+   double energy = simd_dot(x, x, leng);
 
    return ((energy <= 0) ? EZERO : log(energy));
 }
@@ -200,58 +227,282 @@ void lifter(double *x, double *y, const int m, const int leng)
    }
 }
 
+int mfcc_init(MFCC * s, const double sampleFreq, const double alpha,
+              const double eps, const int wlng, const int flng, const int m,
+              const int n, const int ceplift, const Boolean usehamming)
+{
+   int j, k, no, chanNum = 0;
+   double *countMel, maxMel, kMel;
+
+   if (flng < 2 || (flng & (flng - 1)) != 0)
+      return (-1);
+
+   s->wlng = wlng;
+   s->flng = flng;
+   s->m = m;
+   s->n = n;
+   s->alpha = alpha;
+   s->eps = eps;
+
+   /* sparse mel filter bank as in fbank() */
+   no = flng / 2;
+   s->chan = (int *) getmem((size_t) no, sizeof(*s->chan));
+   s->wgt = dgetmem(no);
+   countMel = dgetmem(n + 1);
+   maxMel = freq_mel(sampleFreq / 2.0);
+   for (k = 0; k <= n; k++)
+      countMel[k] = (double) (k + 1) / (double) (n + 1) * maxMel;
+   for (k = 1; k < no; k++) {
+      kMel = sample_mel(k - 1, no, sampleFreq);
+      while (countMel[chanNum] < kMel && chanNum <= n)
+         chanNum++;
+      s->chan[k] = chanNum;
+      s->wgt[k] = (countMel[chanNum] - kMel) / (countMel[0]);
+   }
+   free(countMel);
+
+   if (usehamming) {
+      s->win = dgetmem(wlng);
+      for (k = 0; k < wlng; k++)
+         s->win[k] = 1.0;
+      window(HAMMING, s->win, wlng, 0);
+   } else
+      s->win = NULL;
+
+   /* DCT-II (orthonormal) of the channels and liftering */
+   s->dctm = dgetmem(n * m + m);
+   s->lift = s->dctm + n * m;
+   for (j = 0; j < n; j++)
+      for (k = 0; k < m; k++)
+         s->dctm[j * m + k] = sqrt(((k == 0) ? 1.0 : 2.0) / n)
+             * cos(PI * k * (2 * j + 1) / (2.0 * n));
+   for (k = 0; k < m; k++)
+      s->lift[k] = (ceplift > 0) ?
+          1.0 + (double) ceplift / 2.0 * sin(PI * (double) k /
+                                             (double) ceplift) : 1.0;
+
+   s->re = dgetmem(flng + flng + wlng);
+   s->im = s->re + flng;
+   s->fre = NULL;
+   s->fb = NULL;
+   s->size = 0;
+
+   return (0);
+}
+
+static void mfcc_grow(MFCC * s, const int nfrm)
+{
+   int n = s->n, m = s->m;
+
+   if (nfrm > s->size) {
+      if (s->fb != NULL)
+         free(s->fb);
+      s->size = nfrm;
+      s->fb = dgetmem(nfrm * (n + 2 + m + 2));
+      s->dc = s->fb + nfrm * (n + 2);
+      s->c0 = s->dc + nfrm * m;
+      s->en = s->c0 + nfrm;
+   }
+}
+
+/* log filter bank (fb), C0 and energy of nfrm frames */
+static void mfcc_analyze(MFCC * s, const double *in, const int nfrm)
+{
+   int t, k, fnum, no = s->flng / 2, n = s->n, len;
+   double *px = s->im + s->flng, *f, sp;
+
+   mfcc_grow(s, nfrm);
+   len = (s->wlng < s->flng) ? s->wlng : s->flng;
+
+   for (t = 0; t < nfrm; t++, in += s->wlng) {
+      s->en[t] = cal_energy((double *) in, s->wlng);
+      pre_emph((double *) in, px, s->alpha, s->wlng);
+      if (s->win != NULL)
+         for (k = 0; k < s->wlng; k++)
+            px[k] = px[k] * s->win[k];
+      for (k = 0; k < len; k++)
+         s->re[k] = px[k];
+      for (; k < s->flng; k++)
+         s->re[k] = 0.0;
+      fftr(s->re, s->im, s->flng);
+
+      /* channels 0 and n + 1 only collect the edges */
+      f = s->fb + t * (n + 2);
+      for (k = 0; k < n + 2; k++)
+         f[k] = 0.0;
+      for (k = 1; k < no; k++) {
+         sp = sqrt(s->re[k] * s->re[k] + s->im[k] * s->im[k]);
+         fnum = s->chan[k];
+         if (fnum > 0)
+            f[fnum] += sp * s->wgt[k];
+         if (fnum <= n)
+            f[fnum + 1] += (1 - s->wgt[k]) * sp;
+      }
+
+      s->c0[t] = 0.0;
+      for (k = 1; k <= n; k++) {
+         if (f[k] < s->eps)
+            f[k] = s->eps;
+         f[k] = log(f[k]);
+         s->c0[t] += f[k];
+      }
+      s->c0[t] *= sqrt(2.0 / (double) n);
+   }
+}
+
+void mfcc_batch(MFCC * s, const double *in, const int nfrm, double *mc)
+{
+   int t, k, n = s->n, m = s->m;
+   double *y;
+
+   mfcc_analyze(s, in, nfrm);
+   mat_gemm(nfrm, m, n, 1.0, s->fb + 1, n + 2, s->dctm, m, 0.0, s->dc, m);
+
+   for (t = 0; t < nfrm; t++, mc += m + 1) {
+      y = s->dc + t * m;
+      for (k = 0; k < m - 1; k++)
+         mc[k] = s->lift[k + 1] * y[k + 1];
+      mc[m - 1] = s->c0[t];
+      mc[m] = s->en[t];
+   }
+}
+
+/* float version of mfcc_analyze() */
+static void mfcc_analyzef(MFCC * s, const float *in, const int nfrm)
+{
+   int t, k, fnum, no = s->flng / 2, n = s->n, len;
+   float *re, *im, *px, *win, *wgt, *fb, sp, e, alpha = s->alpha;
+   double *f;
+
+   mfcc_grow(s, nfrm);
+   if (s->fre == NULL) {
+      s->fre = fgetmem(s->flng + s->flng + s->wlng + s->wlng + no + n + 2);
+      win = s->fre + s->flng + s->flng + s->wlng;
+      wgt = win + s->wlng;
+      for (k = 0; k < s->wlng; k++)
+         win[k] = (s->win != NULL) ? s->win[k] : 1.0;
+      for (k = 1; k < no; k++)
+         wgt[k] = s->wgt[k];
+   }
+   re = s->fre;
+   im = re + s->flng;
+   px = im + s->flng;
+   win = px + s->wlng;
+   wgt = win + s->wlng;
+   fb = wgt + no;
+   len = (s->wlng < s->flng) ? s->wlng : s->flng;
+
+   for (t = 0; t < nfrm; t++, in += s->wlng) {
+      for (k = 0, e = 0.0f; k < s->wlng; k++)
+         e += in[k] * in[k];
+      s->en[t] = (e <= 0) ? EZERO : log(e);
+      px[0] = in[0] * (1.0f - alpha);
+      for (k = 1; k < s->wlng; k++)
+         px[k] = in[k] - in[k - 1] * alpha;
+      if (s->win != NULL)
+         for (k = 0; k < s->wlng; k++)
+            px[k] = px[k] * win[k];
+      for (k = 0; k < len; k++)
+         re[k] = px[k];
+      for (; k < s->flng; k++)
+         re[k] = 0.0f;
+      fftrf(re, im, s->flng);
+
+      for (k = 0; k < n + 2; k++)
+         fb[k] = 0.0f;
+      for (k = 1; k < no; k++) {
+         sp = sqrt(re[k] * re[k] + im[k] * im[k]);
+         fnum = s->chan[k];
+         if (fnum > 0)
+            fb[fnum] += sp * wgt[k];
+         if (fnum <= n)
+            fb[fnum + 1] += (1 - wgt[k]) * sp;
+      }
+
+      f = s->fb + t * (n + 2);
+      s->c0[t] = 0.0;
+      for (k = 1; k <= n; k++) {
+         f[k] = (fb[k] < s->eps) ? s->eps : fb[k];
+         f[k] = log(f[k]);
+         s->c0[t] += f[k];
+      }
+      s->c0[t] *= sqrt(2.0 / (double) n);
+   }
+}
+
+void mfcc_batchf(MFCC * s, const float *in, const int nfrm, float *mc)
+{
+   int t, k, n = s->n, m = s->m;
+   double *y;
+
+   mfcc_analyzef(s, in, nfrm);
+   mat_gemm(nfrm, m, n, 1.0, s->fb + 1, n + 2, s->dctm, m, 0.0, s->dc, m);
+
+   for (t = 0; t < nfrm; t++, mc += m + 1) {
+      y = s->dc + t * m;
+      for (k = 0; k < m - 1; k++)
+         mc[k] = s->lift[k + 1] * y[k + 1];
+      mc[m - 1] = s->c0[t];
+      mc[m] = s->en[t];
+   }
+}
+
+void mfcc_logmel(MFCC * s, const double *in, const int nfrm, double *fb)
+{
+   int t, k, n = s->n;
+   double *f;
+
+   mfcc_analyze(s, in, nfrm);
+   for (t = 0; t < nfrm; t++, fb += n + 1) {
+      f = s->fb + t * (n + 2);
+      for (k = 0; k < n; k++)
+         fb[k] = f[k + 1];
+      fb[n] = s->en[t];
+   }
+}
+
+void mfcc_free(MFCC * s)
+{
+   free(s->chan);
+   free(s->wgt);
+   if (s->win != NULL)
+      free(s->win);
+   free(s->dctm);
+   free(s->re);
+   if (s->fre != NULL)
+      free(s->fre);
+   s->fre = NULL;
+   if (s->fb != NULL)
+      free(s->fb);
+   s->fb = NULL;
+   s->size = 0;
+}
+
 void mfcc(double *in, double *mc, const double sampleFreq, const double alpha,
           const double eps, const int wlng, const int flng, const int m,
           const int n, const int ceplift, const Boolean dftmode,
           const Boolean usehamming)
 {
-   static double *x = NULL, *px, *wx, *sp, *fb, *dc;
-   double energy = 0.0, c0 = 0.0;
-   int k;
-
-   if (x == NULL) {
-      x = dgetmem(wlng + wlng + flng + flng + n + 1 + m + 1);
-      px = x + wlng;
-      wx = px + wlng;
-      sp = wx + flng;
-      fb = sp + flng;
-      dc = fb + n + 1;
-   } else {
-      free(x);
-      x = dgetmem(wlng + wlng + flng + flng + n + 1 + m + 1);
-      px = x + wlng;
-      wx = px + wlng;
-      sp = wx + flng;
-      fb = sp + flng;
-      dc = fb + n + 1;
+   static MFCC s;
+   static int init = 0, last_ceplift;
+   static double last_fs;
+   static Boolean last_hamming;
+
+   if (!init || s.wlng != wlng || s.flng != flng || s.m != m || s.n != n
+       || s.alpha != alpha || s.eps != eps || last_fs != sampleFreq
+       || last_ceplift != ceplift || last_hamming != usehamming) {
+      if (init)
+         mfcc_free(&s);
+      if (mfcc_init(&s, sampleFreq, alpha, eps, wlng, flng, m, n, ceplift,
+                    usehamming) < 0) {
+         fprintf(stderr, "mfcc : FFT length must be a power of 2!\n");
+         exit(1);
+      }
+      init = 1;
+      last_fs = sampleFreq;
+      last_ceplift = ceplift;
+      last_hamming = usehamming;
    }
 
-   movem(in, x, sizeof(*in), wlng);
-   /* calculate energy */
-   energy = cal_energy(x, wlng);
-   pre_emph(x, px, alpha, wlng);
-   /* apply hamming window */
-   if (usehamming)
-      window(HAMMING, px, wlng, 0);
-   for (k = 0; k < wlng; k++)
-      wx[k] = px[k];
-   spec(wx, sp, flng);
-   fbank(sp, fb, eps, sampleFreq, flng, n);
-   /* calculate 0'th coefficient */
-   for (k = 1; k <= n; k++)
-      c0 += fb[k];
-   c0 *= sqrt(2.0 / (double) n);
-   dct(fb + 1, dc, n, m, dftmode, 0);
-
-   /* liftering */
-   if (ceplift > 0)
-      lifter(dc, mc, m, ceplift);
-   else
-      movem(dc, mc, sizeof(*dc), m);
-
-   for (k = 0; k < m - 1; k++)
-      mc[k] = mc[k + 1];
-   mc[m - 1] = c0;
-   mc[m] = energy;
-
+   mfcc_batch(&s, in, 1, mc);
 }
@@ -75,9 +75,12 @@
 *               coefficient C0 is output as follows,                     *
 *                   , mc(0), mc(1), ..., mc(m-1), E (C0)                 *
 *               if Both -E and -0 option is given, C0 is output before E *
+*       notes:                                                           *
+*               built with FLOAT32, the analysis is done in float by     *
+*               mfcc_batchf()                                            *
 *                                                                        *
 *       require:                                                         *
-*               mfcc()                                                   *
+*               mfcc_init(), mfcc_batch(), mfcc_batchf()                 *
 *                                                                        *
 *************************************************************************/
 
@@ -117,6 +120,7 @@ static char *rcs_id = "$Id: mfcc.c,v 1.11 2014/12/11 08:30:41 uratec Exp $";
 #define ALPHA 0.97
 #define LIFT 22
 #define WTYPE 0
+#define BLOCK 256               /* number of frames analyzed at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -194,10 +198,14 @@ void usage(int status)
 int main(int argc, char **argv)
 {
    int m = ORDER, l = WLNG, L = -1, n = CHANNEL, lift = LIFT, wtype =
-       WTYPE, num = 0;
-   double eps = EPS, fs = SAMPLEFREQ, alpha = ALPHA, *x, *mc;
+       WTYPE, num = 0, i, k;
+   double eps = EPS, fs = SAMPLEFREQ, alpha = ALPHA, *x, *mc, *y;
+#ifdef FLOAT32
+   float *xf, *mcf;
+#endif
    FILE *fp = stdin;
    Boolean dftmode = DFTMODE, czero = CZERO, usehamming = USEHAMMING;
+   MFCC s;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -273,15 +281,34 @@ int main(int argc, char **argv)
    if (wtype == 0)
       usehamming = 1 - usehamming;
 
-   x = dgetmem(l + m + 2);
-   mc = x + l;
+   if (mfcc_init(&s, fs, alpha, eps, l, L, m + 1, n, lift, usehamming) < 0) {
+      fprintf(stderr, "%s : FFT length must be a power of 2!\n", cmnd);
+      usage(1);
+   }
 
-   while (freadf(x, sizeof(*x), l, fp) == l) {
+   x = dgetmem(BLOCK * (l + m + 2));
+   mc = x + BLOCK * l;
+#ifdef FLOAT32
+   xf = fgetmem(BLOCK * (l + m + 2));
+   mcf = xf + BLOCK * l;
+#endif
 
-      mfcc(x, mc, fs, alpha, eps, l, L, m + 1, n, lift, dftmode, usehamming);
-      if (!czero)
-         mc[m] = mc[m + 1];
-      fwritef(mc, sizeof(*mc), m + num, stdout);
+   while ((k = freadf(x, sizeof(*x), BLOCK * l, fp) / l) > 0) {
+#ifdef FLOAT32
+      for (i = 0; i < k * l; i++)
+         xf[i] = x[i];
+      mfcc_batchf(&s, xf, k, mcf);
+      for (i = 0; i < k * (m + 2); i++)
+         mc[i] = mcf[i];
+#else
+      mfcc_batch(&s, x, k, mc);
+#endif
+      for (i = 0; i < k; i++) {
+         y = mc + i * (m + 2);
+         if (!czero)
+            y[m] = y[m + 1];
+         fwritef(y, sizeof(*y), m + num, stdout);
+      }
    }
 
    return 0;
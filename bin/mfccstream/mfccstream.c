@@ -0,0 +1,543 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/*************************************************************************
+*                                                                        *
+*    Streaming MFCC Front End                                            *
+*                                                                        *
+*       usage:                                                           *
+*               mfccstream [ options ] [ infile ] > stdout               *
+*       options:                                                         *
+*               -a  a    :  pre-emphasis coefficient             [0.97]  *
+*               -c  c    :  liftering coefficient                [22]    *
+*               -e  e    :  flooring value for calculating log(x)[1.0]   *
+*               -s  s    :  sampling frequency (kHz)             [16.0]  *
+*               -l  l    :  frame length                         [256]   *
+*               -p  p    :  frame period                         [100]   *
+*               -L  L    :  frame length for fft                 [2^n]   *
+*               -m  m    :  order of cepstrum                    [12]    *
+*               -n  n    :  order of channel for mel-filter bank [20]    *
+*               -w  w    :  type of window                       [0]     *
+*               -N       :  no center start point                [FALSE] *
+*               -E       :  output energy                        [FALSE] *
+*               -0       :  output 0'th static coefficient       [FALSE] *
+*               -o  o    :  output format                        [0]     *
+*                             0 (MFCC)                                   *
+*                             1 (log mel filter bank)                    *
+*               -r  r W1 (W2) : width of regression windows      [N/A]   *
+*                             appended as delta (delta-delta)            *
+*               -v  v    :  cepstral mean and variance normalization [0] *
+*                             0 (none)                                   *
+*                             1 (mean, whole utterance)                  *
+*                             2 (mean and variance, whole utterance)     *
+*                             3 (mean, running)                          *
+*                             4 (mean and variance, running)             *
+*               -T       :  print time spent in each stage       [FALSE] *
+*       infile:                                                          *
+*               waveform                                                 *
+*                   , x(0), x(1), ...,                                   *
+*       stdout:                                                          *
+*               static features (normalized when -v is given),           *
+*               followed by delta (and delta-delta) features             *
+*       notes:                                                           *
+*               Framing is that of frame, the static features are those  *
+*               of mfcc (or its filter bank) and -r is that of delta.    *
+*               Running normalization uses the statistics of frames up   *
+*               to the current one and keeps the delay at the width of   *
+*               the regression windows; whole utterance normalization    *
+*               holds the output until the end of the input.             *
+*       require:                                                         *
+*               pipeline_init(), pipeline_push(), pipeline_flush(),      *
+*               mfcc_init(), mfcc_batch(), mfcc_logmel(), delta_init(),  *
+*               delta_push(), delta_flush(), accum_Moments(),            *
+*               cov_Moments()                                            *
+*                                                                        *
+*************************************************************************/
+
+static char *rcs_id = "$Id$";
+
+
+/*  Standard C Libraries  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#else
+#  include <strings.h>
+#  ifndef HAVE_STRRCHR
+#     define strrchr rindex
+#  endif
+#endif
+
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+/*  Default Values  */
+#define ORDER 12
+#define WLNG 256
+#define FPERIOD 100
+#define EPS 1.0
+#define CHANNEL 20
+#define CZERO FA
+#define ENERGY FA
+#define SAMPLEFREQ 16.0
+#define ALPHA 0.97
+#define LIFT 22
+#define WTYPE 0
+#define NOCTR FA
+#define OTYPE 0
+#define CMVN 0
+#define TIMING FA
+#define BLOCK 4096              /* number of samples read at a time */
+
+char *BOOL[] = { "FALSE", "TRUE" };
+
+/*  Command Name  */
+char *cmnd;
+
+/*  Stages  */
+enum { T_INPUT, T_FRAME, T_FEATURE, T_CMVN, T_DELTA, T_OUTPUT, NSTAGE };
+char *stage_name[] =
+    { "input", "framing", "features", "normalization", "delta", "output" };
+
+static double elapse[NSTAGE];
+static clock_t tick;
+
+static int dim, nwin = 1, cmvn;
+static Boolean usedelta = FA;
+static Moments stat;
+static DELTASTREAM ds;
+static double *sd, *dy;
+
+void usage(int status)
+{
+   fprintf(stderr, "\n");
+   fprintf(stderr, " %s - streaming MFCC front end\n", cmnd);
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  usage:\n");
+   fprintf(stderr, "       %s [ options ] [ infile ] > stdout\n", cmnd);
+   fprintf(stderr, "  options:\n");
+   fprintf(stderr,
+           "       -a a          : pre-emphasis coefficient              [%g]\n",
+           ALPHA);
+   fprintf(stderr,
+           "       -c c          : liftering coefficient                 [%d]\n",
+           LIFT);
+   fprintf(stderr,
+           "       -e e          : flooring value for calculating log(x) [%g]\n",
+           EPS);
+   fprintf(stderr, "                       in filterbank analysis\n");
+   fprintf(stderr, "                       if x < e, then x = e\n");
+   fprintf(stderr,
+           "       -s s          : sampling frequency (kHz)              [%.1f]\n",
+           SAMPLEFREQ);
+   fprintf(stderr,
+           "       -l l          : frame length                          [%d]\n",
+           WLNG);
+   fprintf(stderr,
+           "       -p p          : frame period                          [%d]\n",
+           FPERIOD);
+   fprintf(stderr,
+           "       -L L          : frame length for fft                  [2^n]\n");
+   fprintf(stderr, "                       default value 2^n satisfies l < 2^n\n");
+   fprintf(stderr,
+           "       -m m          : order of cepstrum                     [%d]\n",
+           ORDER);
+   fprintf(stderr,
+           "       -n n          : order of channel for mel-filter bank  [%d]\n",
+           CHANNEL);
+   fprintf(stderr,
+           "       -w w          : type of window                        [%d]\n",
+           WTYPE);
+   fprintf(stderr, "                         0 (hamming)\n");
+   fprintf(stderr, "                         1 (do not use a window function)\n");
+   fprintf(stderr,
+           "       -N            : no center start point                 [%s]\n",
+           BOOL[NOCTR]);
+   fprintf(stderr,
+           "       -E            : output energy                         [%s]\n",
+           BOOL[ENERGY]);
+   fprintf(stderr,
+           "       -0            : output 0'th static coefficient        [%s]\n",
+           BOOL[CZERO]);
+   fprintf(stderr,
+           "       -o o          : output format                         [%d]\n",
+           OTYPE);
+   fprintf(stderr, "                         0 (MFCC)\n");
+   fprintf(stderr, "                         1 (log mel filter bank)\n");
+   fprintf(stderr,
+           "       -r r W1 (W2)  : number and width of regression        [N/A]\n");
+   fprintf(stderr,
+           "                       windows for delta (delta-delta)\n");
+   fprintf(stderr,
+           "       -v v          : mean and variance normalization       [%d]\n",
+           CMVN);
+   fprintf(stderr, "                         0 (none)\n");
+   fprintf(stderr, "                         1 (mean, whole utterance)\n");
+   fprintf(stderr,
+           "                         2 (mean and variance, whole utterance)\n");
+   fprintf(stderr, "                         3 (mean, running)\n");
+   fprintf(stderr, "                         4 (mean and variance, running)\n");
+   fprintf(stderr,
+           "       -T            : print time spent in each stage        [%s]\n",
+           BOOL[TIMING]);
+   fprintf(stderr, "       -h            : print this message\n");
+   fprintf(stderr, "  infile:\n");
+   fprintf(stderr, "       waveform (%s)   [stdin]\n", FORMAT);
+   fprintf(stderr, "  stdout:\n");
+   fprintf(stderr, "       static and dynamic features (%s)\n", FORMAT);
+   fprintf(stderr, "  notes:\n");
+   fprintf(stderr, "       the static features are those of mfcc, or the\n");
+   fprintf(stderr,
+           "       filter bank outputs followed by energy (-E) when -o 1.\n");
+   fprintf(stderr,
+           "       with -v 1 or -v 2 output is held until the end of input.\n");
+#ifdef PACKAGE_VERSION
+   fprintf(stderr, "\n");
+   fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
+   fprintf(stderr, " CVS Info: %s", rcs_id);
+#endif
+   fprintf(stderr, "\n");
+   exit(status);
+}
+
+static void lap(const int k)
+{
+   clock_t t = clock();
+
+   elapse[k] += (double) (t - tick) / CLOCKS_PER_SEC;
+   tick = t;
+}
+
+static void normalize(double *v)
+{
+   int k;
+
+   if (cmvn == 3 || cmvn == 4) {
+      accum_Moments(&stat, v);
+      if (cmvn == 4) {
+         cov_Moments(&stat, sd);
+         for (k = 0; k < dim; k++)
+            sd[k] = sqrt(sd[k]);
+      }
+   }
+   for (k = 0; k < dim; k++) {
+      v[k] -= stat.mean[k];
+      if ((cmvn == 2 || cmvn == 4) && sd[k] > 0.0)
+         v[k] /= sd[k];
+   }
+}
+
+/* normalization, delta and output of one static feature vector */
+static void emit(double *v)
+{
+   int k;
+
+   if (cmvn > 0) {
+      normalize(v);
+      lap(T_CMVN);
+   }
+   if (usedelta) {
+      k = delta_push(&ds, v, dy);
+      lap(T_DELTA);
+      if (k)
+         fwritef(dy, sizeof(*dy), nwin * dim, stdout);
+   } else
+      fwritef(v, sizeof(*v), dim, stdout);
+   lap(T_OUTPUT);
+}
+
+int main(int argc, char **argv)
+{
+   int m = ORDER, l = WLNG, fprd = FPERIOD, L = -1, n = CHANNEL, lift =
+       LIFT, wtype = WTYPE, otype = OTYPE, num = 0, i, j, k,
+       nfrm, nout = 0, size = 0, a0, a1, a2;
+   int lw[3], rw[3];
+   double eps = EPS, fs = SAMPLEFREQ, alpha = ALPHA, *x, *fr, *feat =
+       NULL, *v, *utt = NULL, *coef[3];
+   char spec[64];
+   FILE *fp = stdin;
+   Boolean czero = CZERO, energy = ENERGY, noctr = NOCTR, timing =
+       TIMING, usehamming = FA;
+   MFCC s;
+   PIPELINE framer;
+   DELTAWINDOW window;
+
+   cmvn = CMVN;
+   if ((cmnd = strrchr(argv[0], '/')) == NULL)
+      cmnd = argv[0];
+   else
+      cmnd++;
+   while (--argc)
+      if (**++argv == '-') {
+         switch (*(*argv + 1)) {
+         case 'a':
+            alpha = atof(*++argv);
+            --argc;
+            break;
+         case 'c':
+            lift = atoi(*++argv);
+            --argc;
+            break;
+         case 'e':
+            eps = atof(*++argv);
+            --argc;
+            break;
+         case 's':
+            fs = atof(*++argv);
+            --argc;
+            break;
+         case 'l':
+            l = atoi(*++argv);
+            --argc;
+            break;
+         case 'p':
+            fprd = atoi(*++argv);
+            --argc;
+            break;
+         case 'L':
+            L = atoi(*++argv);
+            --argc;
+            break;
+         case 'm':
+            m = atoi(*++argv);
+            --argc;
+            break;
+         case 'n':
+            n = atoi(*++argv);
+            --argc;
+            break;
+         case 'w':
+            wtype = atoi(*++argv);
+            --argc;
+            break;
+         case 'o':
+            otype = atoi(*++argv);
+            --argc;
+            break;
+         case 'v':
+            cmvn = atoi(*++argv);
+            --argc;
+            break;
+         case 'r':
+            if (argc < 3 || (nwin = atoi(*++argv) + 1) < 2 || nwin > 3) {
+               fprintf(stderr,
+                       "%s : Number of regression windows must be 1 or 2!\n",
+                       cmnd);
+               usage(1);
+            }
+            --argc;
+            for (k = 1; k < nwin; k++) {
+               if (argc < 2 || (rw[k] = atoi(*++argv)) < 1) {
+                  fprintf(stderr,
+                          "%s : Width of regression window must be positive!\n",
+                          cmnd);
+                  usage(1);
+               }
+               lw[k] = -rw[k];
+               --argc;
+            }
+            usedelta = TR;
+            break;
+         case 'N':
+            noctr = 1 - noctr;
+            break;
+         case 'E':
+            energy = 1 - energy;
+            num++;
+            break;
+         case '0':
+            czero = 1 - czero;
+            num++;
+            break;
+         case 'T':
+            timing = 1 - timing;
+            break;
+         case 'h':
+            usage(0);
+         default:
+            fprintf(stderr, "%s : Invalid option '%c'!\n", cmnd, *(*argv + 1));
+            usage(1);
+         }
+      } else
+         fp = getfp(*argv, "rb");
+
+   if (otype < 0 || otype > 1) {
+      fprintf(stderr, "%s : Output format must be 0 or 1!\n", cmnd);
+      usage(1);
+   }
+   if (cmvn < 0 || cmvn > 4) {
+      fprintf(stderr, "%s : Normalization type must be 0, 1, 2, 3 or 4!\n",
+              cmnd);
+      usage(1);
+   }
+   if (l <= 0 || fprd <= 0) {
+      fprintf(stderr, "%s : Frame length and period must be positive!\n",
+              cmnd);
+      usage(1);
+   }
+
+   fs *= 1000;                  /* kHz -> Hz */
+   if (L < 0)
+      for (L = 2; L <= l; L *= 2) {
+      }
+   if (wtype == 0)
+      usehamming = 1 - usehamming;
+
+   if (mfcc_init(&s, fs, alpha, eps, l, L, m + 1, n, lift, usehamming) < 0) {
+      fprintf(stderr, "%s : FFT length must be a power of 2!\n", cmnd);
+      usage(1);
+   }
+   sprintf(spec, "frame -l %d -p %d%s", l, fprd, (noctr) ? " -n" : "");
+   pipeline_init(&framer, spec, FA);
+
+   /* static features */
+   dim = (otype == 0) ? m + num : n + ((energy) ? 1 : 0);
+   if (cmvn > 0) {
+      alloc_Moments(&stat, dim, FA);
+      sd = dgetmem(dim);
+   }
+
+   /* regression windows of delta */
+   if (usedelta) {
+      lw[0] = rw[0] = 0;
+      coef[0] = dgetmem(1);
+      coef[0][0] = 1.0;
+      for (k = 1; k < nwin; k++)
+         coef[k] = dgetmem(2 * rw[k] + 1) + rw[k];
+      for (a1 = 0, j = lw[1]; j <= rw[1]; a1 += j * j, j++);
+      for (j = lw[1]; j <= rw[1]; j++)
+         coef[1][j] = (double) j / (double) a1;
+      if (nwin > 2) {
+         for (a0 = a1 = a2 = 0, j = lw[2]; j <= rw[2];
+              a0++, a1 += j * j, a2 += j * j * j * j, j++);
+         for (j = lw[2]; j <= rw[2]; j++)
+            coef[2][j] = 2 * ((double) (a0 * j * j - a1)) /
+                ((double) (a2 * a0 - a1 * a1));
+      }
+      window.win_size = nwin;
+      window.win_l_width = lw;
+      window.win_r_width = rw;
+      window.win_coefficient = coef;
+      delta_init(&ds, &window, dim);
+      dy = dgetmem(nwin * dim);
+   }
+
+   x = dgetmem(BLOCK);
+   tick = clock();
+   for (;;) {
+      k = freadf(x, sizeof(*x), BLOCK, fp);
+      lap(T_INPUT);
+      if (k > 0)
+         nfrm = pipeline_push(&framer, x, k, &fr);
+      else
+         nfrm = pipeline_flush(&framer, &fr);
+      nfrm /= l;
+      lap(T_FRAME);
+
+      if (nfrm > size) {
+         if (feat != NULL)
+            free(feat);
+         size = nfrm;
+         feat = dgetmem(size * (m + n + 2));
+      }
+      if (otype == 0) {
+         mfcc_batch(&s, fr, nfrm, feat);
+         for (i = 0; i < nfrm; i++) {
+            v = feat + i * (m + 2);
+            if (!czero)
+               v[m] = v[m + 1];
+         }
+      } else
+         mfcc_logmel(&s, fr, nfrm, feat);
+      lap(T_FEATURE);
+
+      for (i = 0; i < nfrm; i++) {
+         v = feat + i * ((otype == 0) ? m + 2 : n + 1);
+         if (cmvn == 1 || cmvn == 2) {
+            /* hold the utterance until its statistics are known */
+            if (nout % 256 == 0)
+               utt = (double *) realloc(utt, (nout + 256) * dim * sizeof(*utt));
+            movem(v, utt + nout * dim, sizeof(*v), dim);
+            accum_Moments(&stat, v);
+            lap(T_CMVN);
+         } else
+            emit(v);
+         nout++;
+      }
+      if (k <= 0)
+         break;
+   }
+
+   if (cmvn == 1 || cmvn == 2) {
+      cov_Moments(&stat, sd);
+      for (k = 0; k < dim; k++)
+         sd[k] = sqrt(sd[k]);
+      for (i = 0; i < nout; i++)
+         emit(utt + i * dim);
+   }
+   if (usedelta) {
+      while (delta_flush(&ds, dy)) {
+         lap(T_DELTA);
+         fwritef(dy, sizeof(*dy), nwin * dim, stdout);
+         lap(T_OUTPUT);
+      }
+   }
+
+   if (timing) {
+      for (k = 0; k < NSTAGE; k++)
+         fprintf(stderr, "%s : %-13s %9.3f sec\n", cmnd, stage_name[k],
+                 elapse[k]);
+      fprintf(stderr, "%s : %d frames\n", cmnd, nout);
+   }
+
+   return (0);
+}
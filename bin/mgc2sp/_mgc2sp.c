@@ -49,6 +49,7 @@
     Transformation mel-generalized cepstrum to log spectrum
 
         void mgc2sp(mgc, m, a, g, sp, flng)
+        void mgc2sp_batch(mgc, m, a, g, x, y, flng, nfrm)
 
         double *mgc  : mel-generalize cepstrum
         int     m    : order of mel-generalized cepstrum
@@ -57,6 +58,14 @@
         double *x    : real part of spectrum
         double *y    : imaginary part of spectrum
         int     flng : FFT length
+        int     nfrm : number of frames
+
+    mgc2sp_batch() returns the first flng/2+1 bins of nfrm frames.
+    For g = 0 the spectrum is a linear function of the mel-cepstrum,
+    so the (m+1) x (flng/2+1) matrix of frequency warping followed
+    by the DFT is built once per (m, a, flng) and the whole batch
+    is transformed by one matrix product.  Other gammas are
+    transformed frame by frame.
 
 ***********************************************************************/
 
@@ -90,3 +99,71 @@ void mgc2sp(double *mgc, const int m, const double a, const double g, double *x,
 
    return;
 }
+
+static double *mgc2sp_table(const int m, const double a, const int flng)
+{
+   int j, no, isnew;
+   double *t, *c, *x;
+
+   no = flng / 2 + 1;
+   t = warptab(WARP_MGC2SP, m, flng / 2, flng, a, 0.0, (m + 1) * 2 * no,
+               &isnew);
+   if (!isnew)
+      return (t);
+
+   /* row j: spectrum of the warped unit impulse at j */
+   c = dgetmem(m + 1 + flng + flng);
+   x = c + m + 1;
+   for (j = 0; j <= m; j++) {
+      fillz(c, sizeof(*c), m + 1);
+      c[j] = 1.0;
+      if (a == 0.0) {
+         fillz(x, sizeof(*x), flng / 2 + 1);
+         if (j <= flng / 2)
+            x[j] = 1.0;
+      } else
+         freqt(c, m, x, flng / 2, -a);
+      c2sp(x, flng / 2, x, x + flng, flng);
+      movem(x, t + j * 2 * no, sizeof(*x), no);
+      movem(x + flng, t + j * 2 * no + no, sizeof(*x), no);
+   }
+   free(c);
+
+   return (t);
+}
+
+void mgc2sp_batch(double *mgc, const int m, const double a, const double g,
+                  double *x, double *y, const int flng, const int nfrm)
+{
+   int i, no;
+   double *t;
+   static double *buf = NULL;
+   static int size;
+
+   no = flng / 2 + 1;
+
+   if (g == 0.0) {
+      t = mgc2sp_table(m, a, flng);
+      mat_gemm(nfrm, no, m + 1, 1.0, mgc, m + 1, t, 2 * no, 0.0, x, no);
+      mat_gemm(nfrm, no, m + 1, 1.0, mgc, m + 1, t + no, 2 * no, 0.0, y, no);
+      return;
+   }
+
+   if (buf == NULL) {
+      buf = dgetmem(flng + flng);
+      size = flng;
+   }
+   if (flng > size) {
+      free(buf);
+      buf = dgetmem(flng + flng);
+      size = flng;
+   }
+
+   for (i = 0; i < nfrm; i++) {
+      mgc2sp(mgc + i * (m + 1), m, a, g, buf, buf + flng, flng);
+      movem(buf, x + i * no, sizeof(*buf), no);
+      movem(buf + flng, y + i * no, sizeof(*buf), no);
+   }
+
+   return;
+}
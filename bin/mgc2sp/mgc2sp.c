@@ -115,6 +115,7 @@ static char *rcs_id = "$Id: mgc2sp.c,v 1.31 2014/12/11 08:30:41 uratec Exp $";
 #define OTYPE  0
 #define PHASE  FA
 #define MULG  FA
+#define BLOCK  64               /* number of frames transformed at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -175,8 +176,8 @@ void usage(int status)
 
 int main(int argc, char **argv)
 {
-   int m = ORDER, l = LENG, otype = OTYPE, no, i;
-   double alpha = ALPHA, gamma = GAMMA, *c, *x, *y, logk;
+   int m = ORDER, l = LENG, otype = OTYPE, no, i, j, n;
+   double alpha = ALPHA, gamma = GAMMA, *c, *cp, *x, *y, logk;
    Boolean norm = NORM, phase = PHASE, mulg = MULG;
    FILE *fp = stdin;
 
@@ -232,51 +233,54 @@ int main(int argc, char **argv)
       } else
          fp = getfp(*argv, "rb");
 
-   x = dgetmem(l + l + m + 1);
-   y = x + l;
-   c = y + l;
-
    no = l / 2 + 1;
    logk = 20.0 / log(10.0);
 
-   while (freadf(c, sizeof(*c), m + 1, fp) == m + 1) {
-      if (norm)
-         ignorm(c, c, m, gamma);
-      else if (mulg) {
-         if (gamma == 0) {
-            fprintf(stderr,
-                    "%s : gamma for input mgc coefficients should not equal to 0 if you specify -u option!\n",
-                    cmnd);
-            usage(1);
+   x = dgetmem(BLOCK * (no + no + m + 1));
+   y = x + BLOCK * no;
+   c = y + BLOCK * no;
+
+   while ((n = freadf(c, sizeof(*c), BLOCK * (m + 1), fp) / (m + 1)) > 0) {
+      for (j = 0; j < n; j++) {
+         cp = c + j * (m + 1);
+         if (norm)
+            ignorm(cp, cp, m, gamma);
+         else if (mulg) {
+            if (gamma == 0) {
+               fprintf(stderr,
+                       "%s : gamma for input mgc coefficients should not equal to 0 if you specify -u option!\n",
+                       cmnd);
+               usage(1);
+            }
+            cp[0] = (cp[0] - 1.0) / gamma;
          }
-         c[0] = (c[0] - 1.0) / gamma;
-      }
 
-      if (mulg) {
-         if (gamma == 0) {
-            fprintf(stderr,
-                    "%s : gamma for input mgc coefficients should not equal to 0 if you specify -u option!\n",
-                    cmnd);
-            usage(1);
+         if (mulg) {
+            if (gamma == 0) {
+               fprintf(stderr,
+                       "%s : gamma for input mgc coefficients should not equal to 0 if you specify -u option!\n",
+                       cmnd);
+               usage(1);
+            }
+            for (i = m; i > 0; i--)
+               cp[i] /= gamma;
          }
-         for (i = m; i > 0; i--)
-            c[i] /= gamma;
       }
 
-      mgc2sp(c, m, alpha, gamma, x, y, l);
+      mgc2sp_batch(c, m, alpha, gamma, x, y, l, n);
 
       if (phase)
          switch (otype) {
          case 1:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i];
             break;
          case 2:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i] * 180 / PI;
             break;
          default:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = y[i] / PI;
             break;
       } else
@@ -284,20 +288,20 @@ int main(int argc, char **argv)
          case 1:
             break;
          case 2:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = exp(x[i]);
             break;
          case 3:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] = exp(2 * x[i]);
             break;
          default:
-            for (i = no; i--;)
+            for (i = n * no; i--;)
                x[i] *= logk;
             break;
          }
 
-      fwritef(x, sizeof(*x), no, stdout);
+      fwritef(x, sizeof(*x), n * no, stdout);
    }
 
    return (0);
@@ -49,6 +49,8 @@
    Mel-Generalized Cepstral Analysis
 
        int mgcep(xw, flng, b, m, a, g, n, itr1, itr2, dd, etype, e, f, itype);
+       int mgcep_warm(xw, flng, b, m, a, g, n, itr1, itr2, dd, etype, e, f,
+                      itype, w);
 
        double   *xw   : input sequence
        int      flng  : frame length
@@ -68,6 +70,8 @@
        double   f     : mimimum value of the determinant
                         of the normal matrix
        int      itype : input data type
+       CepWarm  *w    : warm start (or NULL)
+                        (see cepwarm_init() in _mcep.c)
 
        return value   : 0 -> completed by end condition
                         -1-> completed by maximum iteration
@@ -180,7 +184,16 @@ int mgcep(double *xw, int flng, double *b, const int m, const double a,
           const double dd, const int etype, const double e, const double f,
           const int itype)
 {
-   int i, j, flag = 0;
+   return (mgcep_warm(xw, flng, b, m, a, g, n, itr1, itr2, dd, etype, e, f,
+                      itype, NULL));
+}
+
+int mgcep_warm(double *xw, int flng, double *b, const int m, const double a,
+               const double g, const int n, const int itr1, const int itr2,
+               const double dd, const int etype, const double e,
+               const double f, const int itype, CepWarm * w)
+{
+   int i, j, pass, iter = 0, flag = 0;
    static double *x = NULL, *y, *d;
    static int size_x, size_c;
    double ep, epo, eps = 0.0, min, max;
@@ -273,46 +286,69 @@ int mgcep(double *xw, int flng, double *b, const int m, const double a,
       }
    }
 
-   /* initial value */
-   fillz(b, sizeof(*b), m + 1);
-   ep = newton(x, flng, b, m, a, -1.0, n, 0, f);
-   if (ep == -1) {
-     return 3;
-   }
-
-   if (g != -1.0) {
-      if (a != 0.0) {
-         ignorm(b, b, m, -1.0); /*  K, b'r(m)    -> br(m)         */
-         b2mc(b, b, m, a);      /*  br(m)        -> c~r(m)        */
-         gnorm(b, d, m, -1.0);  /*  c~r(m)       -> K~, c~'r(m)   */
-      } else
-         movem(b, d, sizeof(*b), m + 1);
-
-      gc2gc(d, m, -1.0, b, m, g);       /*  K~, c~'r(m)  -> K~, c~'r'(m)  */
-
-      if (a != 0.0) {
-         ignorm(b, b, m, g);    /*  K~, c~'r'(m) -> c~r(m)        */
-         mc2b(b, b, m, a);      /*  c~r(m)       -> br(m)         */
-         gnorm(b, b, m, g);     /*  br(m)        -> K, b'r'(m)    */
+   /*  pass 0 : from previous frame, pass 1 : from periodogram  */
+   pass = (g != -1.0 && cepwarm_ready(w, m)) ? 0 : 1;
+   for (; pass < 2; pass++) {
+      if (pass == 0) {
+         movem(w->prev, b, sizeof(*b), m + 1);
+         ep = 0.0;
+      } else {
+         /* initial value */
+         fillz(b, sizeof(*b), m + 1);
+         ep = newton(x, flng, b, m, a, -1.0, n, 0, f);
+         if (ep == -1) {
+            stats_frame(iter, TR);
+            return 3;
+         }
+         iter++;
+
+         if (g != -1.0) {
+            if (a != 0.0) {
+               ignorm(b, b, m, -1.0);   /*  K, b'r(m)    -> br(m)         */
+               b2mc(b, b, m, a);        /*  br(m)        -> c~r(m)        */
+               gnorm(b, d, m, -1.0);    /*  c~r(m)       -> K~, c~'r(m)   */
+            } else
+               movem(b, d, sizeof(*b), m + 1);
+
+            gc2gc(d, m, -1.0, b, m, g); /*  K~, c~'r(m)  -> K~, c~'r'(m)  */
+
+            if (a != 0.0) {
+               ignorm(b, b, m, g);      /*  K~, c~'r'(m) -> c~r(m)        */
+               mc2b(b, b, m, a);        /*  c~r(m)       -> br(m)         */
+               gnorm(b, b, m, g);       /*  br(m)        -> K, b'r'(m)    */
+            }
+         }
       }
-   }
 
-   /*  Newton-Raphson method  */
-   if (g != -1.0) {
-      for (j = 1; j <= itr2; j++) {
-         epo = ep;
-         ep = newton(x, flng, b, m, a, g, n, j, f);
-	 if (ep == -1) {
-	   return 3;
-	 }
-
-         if (j >= itr1)
-            if (fabs((epo - ep) / ep) < dd) {
-               flag = 1;
-               break;
+      /*  Newton-Raphson method  */
+      flag = 0;
+      if (g != -1.0) {
+         for (j = 1; j <= itr2; j++) {
+            epo = ep;
+            ep = newton(x, flng, b, m, a, g, n, j, f);
+            if (ep == -1) {
+               if (pass == 0)
+                  break;
+               stats_frame(iter + j, TR);
+               return 3;
             }
+
+            if (j >= itr1)
+               if (fabs((epo - ep) / ep) < dd) {
+                  flag = 1;
+                  break;
+               }
+         }
+         iter += (j <= itr2) ? j : itr2;
       }
+
+      /*  restart from periodogram unless converged  */
+      if (pass == 1 || (flag && cepwarm_valid(b, m)))
+         break;
+      w->fallback = TR;
    }
+   cepwarm_done(w, b, m);
+   stats_frame(iter, !flag && g != -1.0);
 
    if (flag)
       return (0);
@@ -79,6 +79,10 @@
 *                -E E     :  floor in db calculated per frame  [N/A]    *
 *                -f f     :  mimimum value of the determinant           *
 *                            of the normal matrix            [0.000001] *
+*                -w       :  start from the coefficients     [FALSE]    *
+*                            of the previous frame                      *
+*                --stats  :  write statistics of iterations  [FALSE]    *
+*                            to stderr as JSON lines                    *
 *       infile:                                                         *
 *                windowed sequence (if q==0)                            *
 *                        , x(0), x(1), ..., x(L-1),                     *
@@ -91,7 +95,7 @@
 *                value of e must be e>=0                                *
 *                value of E must be E<0                                 *
 *       require:                                                        *
-*                mgcep()                                                *
+*                mgcep_warm(), cepwarm_init(), stats_open()             *
 *                                                                       *
 ************************************************************************/
 
@@ -130,9 +134,12 @@ static char *rcs_id = "$Id: mgcep.c,v 1.41 2014/12/11 08:30:41 uratec Exp $";
 #define END    0.001
 #define EPS    0.0
 #define MINDET 0.000001
+#define WARM FA
+#define STATS FA
 
 /*  Command Name  */
 char *cmnd;
+char *BOOL[] = { "FALSE", "TRUE" };
 
 
 void usage(const int status)
@@ -181,6 +188,12 @@ void usage(const int status)
    fprintf(stderr, "       -f f  : mimimum value of the determinant  [%g]\n",
            MINDET);
    fprintf(stderr, "               of the normal matrix\n");
+   fprintf(stderr, "       -w    : start from the coefficients       [%s]\n",
+           BOOL[WARM]);
+   fprintf(stderr, "               of the previous frame\n");
+   fprintf(stderr, "       --stats : write statistics of iterations  [%s]\n",
+           BOOL[STATS]);
+   fprintf(stderr, "               to stderr as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr, "       windowed sequence or spectrum (%s)     [stdin]\n",
@@ -206,6 +219,8 @@ int main(int argc, char **argv)
    int m = ORDER, flng = FLENG, ilng = FLENG, itr1 = MINITR, itr2 = MAXITR, n =
        -1, flag = 0, otype = OTYPE, itype = ITYPE, etype = ETYPE, i;
    FILE *fp = stdin;
+   Boolean warm = WARM, stats = STATS;
+   CepWarm w;
    double *b, *x, a = ALPHA, g = GAMMA, end = END, e = EPS, f = MINDET;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
@@ -276,6 +291,16 @@ int main(int argc, char **argv)
             f = atof(*++argv);
             --argc;
             break;
+         case 'w':
+            warm = 1 - warm;
+            break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -295,10 +320,14 @@ int main(int argc, char **argv)
    x = dgetmem(flng + m + m + 2);
    b = x + flng;
 
+   cepwarm_init(&w, warm);
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
    while (freadf(x, sizeof(*x), ilng, fp) == ilng) {
-
-      flag = mgcep(x, flng, b, m, a, g, n, itr1, itr2, end, etype, e, f, itype);
-
+      stats_stage("analysis");
+      flag =
+          mgcep_warm(x, flng, b, m, a, g, n, itr1, itr2, end, etype, e, f,
+                     itype, &w);
       if (otype == 0 || otype == 1 || otype == 2 || otype == 4)
          ignorm(b, b, m, g);    /* K, b'r --> br  */
 
@@ -313,8 +342,13 @@ int main(int argc, char **argv)
          for (i = m; i >= 1; i--)
             b[i] *= g;
 
+      stats_stage("write");
       fwritef(b, sizeof(*b), m + 1, stdout);
+      stats_stage("read");
    }
+   stats_close();
+
+   cepwarm_free(&w);
 
    return (0);
 }
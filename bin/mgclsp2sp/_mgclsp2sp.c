@@ -47,7 +47,8 @@
 
     Transform mgc-lsp to spectrum
 
-        void   mgclsp2sp(a, g, lsp, m, x, l)
+        void   mgclsp2sp(a, g, lsp, m, x, l, gain)
+        void   mgclsp2sp_batch(a, g, lsp, m, x, l, gain, nfrm)
 
         double   a     : alpha
         double   g     : gamma
@@ -55,6 +56,11 @@
         int      m     : order of mgc-lsp
         double   *x    : real part of spectrum
         double   l     : FFT length
+        int      gain  : 1 if lsp[0] is the gain
+        int      nfrm  : number of frames
+
+    The warped frequencies of the l bins are kept between calls
+    and the log amplitude is evaluated by lsp2sp_warp().
 
 ***************************************************************/
 
@@ -101,39 +107,44 @@ double mel_conv(double a, double w)
    return w + 2.0 * atan(a * sin(w) / (1.0 - a * cos(w)));
 }
 
-void mgclsp2sp(double a, double g, double *lsp, const int m, double *x,
-               const int l, const int gain)
+void mgclsp2sp_batch(double a, double g, double *lsp, const int m, double *x,
+                     const int l, const int gain, const int nfrm)
 {
-   int i, p;
-   double w, eq1, eq2, ap = 0.0;
-
-   for (p = 0; p < l; p++) {
-      eq1 = 0.0;
-      eq2 = 0.0;
-      w = mel_conv(a, p * (M_PI / (l - 1)));
-
-      if (m % 2 == 0) {
-         for (i = 0; i < m / 2; i++) {
-            eq1 += 2.0 * log_conv_in_mgclsp2sp(cos(w) - cos(lsp[2 * i + gain]));
-            eq2 += 2.0 * log_conv_in_mgclsp2sp(cos(w) - cos(lsp[2 * i + 1 + gain]));
-         }
-         eq1 += 2.0 * log_conv_in_mgclsp2sp(cos(w / 2.0));
-         eq2 += 2.0 * log_conv_in_mgclsp2sp(sin(w / 2.0));
-
-         ap = m * log(2.0) + log_add_in_mgclsp2sp(eq1, eq2);
-      } else {
-         for (i = 0; i < (m + 1) / 2; i++)
-            eq1 += 2.0 * log_conv_in_mgclsp2sp(cos(w) - cos(lsp[2 * i + gain]));
-         for (i = 0; i < (m - 1) / 2; i++)
-            eq2 += 2.0 * log_conv_in_mgclsp2sp(cos(w) - cos(lsp[2 * i + 1 + gain]));
-         eq2 += 2.0 * log_conv_in_mgclsp2sp(sin(w));
-
-         ap = (m - 1.0) * log(2.0) + log_add_in_mgclsp2sp(eq1, eq2);
-      }
+   int n, p;
+   static double *w = NULL, alpha;
+   static int size, len = 0;
 
-      x[p] = -0.5 * ap;
-      x[p] *= -(1.0 / g);
-      if (gain == 1)
-         x[p] += lsp[0];
+   if (w == NULL) {
+      w = dgetmem(l);
+      size = l;
    }
+   if (l > size) {
+      free(w);
+      w = dgetmem(l);
+      size = l;
+      len = 0;
+   }
+   if (l != len || a != alpha) {
+      for (p = 0; p < l; p++)
+         w[p] = mel_conv(a, p * (M_PI / (l - 1)));
+      len = l;
+      alpha = a;
+   }
+
+   lsp2sp_warp(lsp, m, w, x, l, gain, nfrm);
+
+   for (n = 0; n < nfrm; n++)
+      for (p = 0; p < l; p++) {
+         x[n * l + p] *= -(1.0 / g);
+         if (gain == 1)
+            x[n * l + p] += lsp[n * (m + 1)];
+      }
+
+   return;
+}
+
+void mgclsp2sp(double a, double g, double *lsp, const int m, double *x,
+               const int l, const int gain)
+{
+   mgclsp2sp_batch(a, g, lsp, m, x, l, gain, 1);
 }
@@ -59,6 +59,11 @@
 
         return value : filtered data
 
+        float mlsadff(x, b, m, a, pd, d)
+
+        float version of mlsadf() with float coefficients and delay,
+        for FLOAT32 builds
+
 *****************************************************************/
 
 #include <stdio.h>
@@ -78,6 +83,13 @@ static double pade[] = { 1.0,
 };
 
 double *ppade_mlsadf;
+static float padef[] = { 1.0f,
+   1.0f, 0.0f,
+   1.0f, 0.0f, 0.0f,
+   1.0f, 0.0f, 0.0f, 0.0f,
+   1.0f, 0.4999273f, 0.1067005f, 0.01170221f, 0.0005656279f,
+   1.0f, 0.4999391f, 0.1107098f, 0.01369984f, 0.0009564853f, 0.00003041721f
+};
 
 static double mlsafir(double x, double *b, const int m, const double a,
                       double *d)
@@ -210,3 +222,82 @@ double mlsadft(double x, double *b, const int m, const double a, const int pd,
 
    return (x);
 }
+
+
+static float mlsafirf(float x, float *b, const int m, const float a, float *d)
+{
+   float y = 0.0f, aa;
+   int i;
+
+   aa = 1 - a * a;
+
+   d[0] = x;
+   d[1] = aa * d[0] + a * d[1];
+
+   for (i = 2; i <= m; i++) {
+      d[i] = d[i] + a * (d[i + 1] - d[i - 1]);
+      y += d[i] * b[i];
+   }
+
+   for (i = m + 1; i > 1; i--)
+      d[i] = d[i - 1];
+
+   return (y);
+}
+
+static float mlsadf1f(float x, float *b, const float a, const int pd,
+                      const float *ppade, float *d)
+{
+   float v, out = 0.0f, *pt, aa;
+   int i;
+
+   aa = 1 - a * a;
+   pt = &d[pd + 1];
+
+   for (i = pd; i >= 1; i--) {
+      d[i] = aa * pt[i - 1] + a * d[i];
+      pt[i] = d[i] * b[1];
+      v = pt[i] * ppade[i];
+
+      x += (1 & i) ? v : -v;
+      out += v;
+   }
+
+   pt[0] = x;
+   out += x;
+
+   return (out);
+}
+
+static float mlsadf2f(float x, float *b, const int m, const float a,
+                      const int pd, const float *ppade, float *d)
+{
+   float v, out = 0.0f, *pt;
+   int i;
+
+   pt = &d[pd * (m + 2)];
+
+   for (i = pd; i >= 1; i--) {
+      pt[i] = mlsafirf(pt[i - 1], b, m, a, &d[(i - 1) * (m + 2)]);
+      v = pt[i] * ppade[i];
+
+      x += (1 & i) ? v : -v;
+      out += v;
+   }
+
+   pt[0] = x;
+   out += x;
+
+   return (out);
+}
+
+float mlsadff(float x, float *b, const int m, const float a, const int pd,
+              float *d)
+{
+   const float *ppade = &padef[pd * (pd + 1) / 2];
+
+   x = mlsadf1f(x, b, a, pd, ppade, d);
+   x = mlsadf2f(x, b, m, a, pd, ppade, &d[2 * (pd + 1)]);
+
+   return (x);
+}
@@ -57,10 +57,14 @@
 *               -m m  : mean               [0.0]                        *
 *               -v v  : variance           [1.0]                        *
 *               -d d  : standard deviation [1.0]                        *
+*               -c    : use counter-based generator [FALSE]             *
+*               -j j  : skip first j values (with -c) [0]               *
 *       stdout:                                                         *
 *               random value (float)                                    *
 *       notice:                                                         *
 *               if l<0, generate infinite sequence                      *
+*               with -c, the i-th value depends only on the seed and i, *
+*               so 'nrand -c -j j' continues 'nrand -c -l j'            *
 *                                                                       *
 ************************************************************************/
 
@@ -94,6 +98,10 @@ static char *rcs_id = "$Id: nrand.c,v 1.24 2014/12/11 08:30:43 uratec Exp $";
 #define MEAN 0.0
 #define VAR  1.0
 #define SDEV 1.0
+#define SKIP 0
+#define BLEN 1024
+
+char *BOOL[] = { "FALSE", "TRUE" };
 
 /*  Command Name  */
 char *cmnd;
@@ -112,11 +120,16 @@ void usage(void)
    fprintf(stderr, "       -m m  : mean               [%g]\n", MEAN);
    fprintf(stderr, "       -v v  : variance           [%g]\n", VAR);
    fprintf(stderr, "       -d d  : standard deviation [%g]\n", SDEV);
+   fprintf(stderr, "       -c    : use counter-based generator [%s]\n",
+           BOOL[FA]);
+   fprintf(stderr, "       -j j  : skip first j values (with -c) [%d]\n",
+           SKIP);
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  stdout:\n");
    fprintf(stderr, "       random values (%s)\n", FORMAT);
    fprintf(stderr, "  notice:\n");
    fprintf(stderr, "       if l<0, generate infinite sequence\n");
+   fprintf(stderr, "       with -c, the i-th value depends only on the seed and i\n");
 #ifdef PACKAGE_VERSION
    fprintf(stderr, "\n");
    fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
@@ -130,9 +143,11 @@ void usage(void)
 int main(int argc, char *argv[])
 {
    char *str, flg;
-   int leng = LENG, seed = SEED, i;
-   unsigned long next = SEED;
-   double p, mean = MEAN, sdev = SDEV;
+   int leng = LENG, seed = SEED, i, n;
+   unsigned long next = SEED, skip = SKIP;
+   double p, mean = MEAN, sdev = SDEV, *buf;
+   Boolean counter = FA;
+   Philox g;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -142,7 +157,7 @@ int main(int argc, char *argv[])
    while (--argc) {
       if (*(str = *++argv) == '-') {
          flg = *++str;
-         if (*++str == '\0') {
+         if ((flg != 'c') && (*++str == '\0')) {
             str = *++argv;
             argc--;
          }
@@ -163,6 +178,12 @@ int main(int argc, char *argv[])
          case 'd':
             sdev = atof(str);
             break;
+         case 'c':
+            counter = TR;
+            break;
+         case 'j':
+            skip = (unsigned long) atol(str);
+            break;
          case 'h':
          default:
             usage();
@@ -171,6 +192,23 @@ int main(int argc, char *argv[])
          usage();
    }
 
+   if (counter) {
+      philox_init(&g, (unsigned long) seed);
+      philox_seek(&g, skip);
+      buf = dgetmem(BLEN);
+      while (leng != 0) {
+         n = (leng < 0 || leng > BLEN) ? BLEN : leng;
+         philox_normal(&g, buf, n);
+         for (i = 0; i < n; i++)
+            buf[i] = mean + sdev * buf[i];
+         fwritef(buf, sizeof(*buf), n, stdout);
+         if (leng > 0)
+            leng -= n;
+      }
+      free(buf);
+      return (0);
+   }
+
    if (seed != 1)
       next = srnd((unsigned int) seed);
 
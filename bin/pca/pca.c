@@ -57,8 +57,11 @@
 *                -i I  : number of iteration of Jacobi method        [10000]     *
 *                -e e  : threshold of convergence of Jacobi method   [0.000001]  *
 *                -v    : output eigenvectors and mean vector         [FALSE]     *
+*                -J    : use Jacobi method instead of Householder-QL [FALSE]     *
 *                -V fn : output eigenvalues and contribution ratio               *
 *                        (output filename = fn)                      [NULL]      *
+*                --stats : write statistics of iterations to         [FALSE]     *
+*                          stderr as JSON lines                                  *
 *                                                                                *
 *       infile:                                                                  *
 *                training vectors                                                *
@@ -76,7 +79,11 @@
 *                   mean_vec, evec(1), evec(2), ..., evec(N)                     *
 *                                                                                *
 *       notice:                                                                  *
-*                Calculation of PCA is based on jacobi method.                   *
+*                Mean and covariance are accumulated in a single pass, and       *
+*                the first N eigenvectors are computed by Householder            *
+*                tridiagonalization and QL method (Jacobi method if -J).         *
+*                Without -J, the sign of each eigenvector is chosen so that      *
+*                its component of the largest magnitude is positive.             *
 *                The Order of Output eigen values and contribution ration is:    *
 *                   eig_val-1, contri_ratio-1, ..., eig_val-N, contri_ratio-N    *
 *                                                                                *
@@ -114,11 +121,6 @@ typedef enum { FALSE = -1, TRUE = 1 } BOOL;
 /* Command Name */
 char *cmnd;
 
-typedef struct _float_list {
-   float *f;
-   struct _float_list *next;
-} float_list;
-
 void usage(int status)
 {
    fprintf(stderr, "\n");
@@ -141,10 +143,15 @@ void usage(int status)
            EPS);
    fprintf(stderr,
            "       -v    : output eigen vectors and mean vector          [FALSE]\n");
+   fprintf(stderr,
+           "       -J    : use Jacobi method instead of Householder-QL  [FALSE]\n");
    fprintf(stderr,
            "       -V fn : output eigen values and contribution ratio \n");
    fprintf(stderr,
            "               (output filename = fn)                        [FALSE]\n");
+   fprintf(stderr,
+           "       --stats : write statistics of iterations to           [FALSE]\n");
+   fprintf(stderr, "               stderr as JSON lines\n");
    fprintf(stderr, "       -h    : print this message\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr, "       training data set       [stdin]\n");
@@ -307,9 +314,10 @@ int jacobi(double **m, int n, double eps, double *e_val, double **e_vec,
 int main(int argc, char *argv[])
 {
    FILE *fp = stdin, *fp_eigen = NULL;
-   int i, j, k, n = PRICOMP_ORDER, leng = LENG, total = -1;
-   BOOL out_evecFlg = FALSE, out_evalFlg = FALSE;
-   double sum;
+   int i, j, n = PRICOMP_ORDER, leng = LENG;
+   BOOL out_evecFlg = FALSE, out_evalFlg = FALSE, use_jacobi = FALSE,
+       stats = FALSE;
+   double trace;
    double *buf = NULL;
    double *mean = NULL, **var = NULL;
    double eps = EPS;
@@ -317,7 +325,7 @@ int main(int argc, char *argv[])
    double **e_vec = NULL, *e_val = NULL;        /* eigenvector and eigenvalue */
    double *cont_rate = NULL;    /* contribution rate */
    double jacobi_conv;
-   float_list *top, *cur, *prev, *tmpf, *tmpff;
+   Moments mom;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -346,11 +354,21 @@ int main(int argc, char *argv[])
          case 'v':
             out_evecFlg = TRUE;
             break;
+         case 'J':
+            use_jacobi = TRUE;
+            break;
          case 'V':
             out_evalFlg = TRUE;
             fp_eigen = getfp(*++argv, "wb");
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TRUE;
+               break;
+            }
+            fprintf(stderr, "%s : Invalid option '%s'!\n", cmnd, *argv);
+            usage(EXIT_FAILURE);
          case 'h':
             usage(EXIT_SUCCESS);
          default:
@@ -366,84 +384,63 @@ int main(int argc, char *argv[])
       usage(EXIT_FAILURE);
    }
 
-   /* -- Count number of input vectors and read -- */
+   stats_open(cmnd, (stats == TRUE) ? stderr : NULL);
+   stats_stage("read");
+
+   /* -- Accumulate mean and covariance in a single pass -- */
    buf = dgetmem(leng);
-   top = prev = (float_list *) malloc(sizeof(float_list));
-   top->f = fgetmem(leng);
-   total = 0;
-   prev->next = NULL;
-   while (freadf(buf, sizeof(*buf), leng, fp) == leng) {
-      cur = (float_list *) malloc(sizeof(float_list));
-      cur->f = fgetmem(leng);
-      for (i = 0; i < leng; i++) {
-         cur->f[i] = (float) buf[i];
-      }
-      total++;
-      prev->next = cur;
-      cur->next = NULL;
-      prev = cur;
-   }
+   alloc_Moments(&mom, leng, TR);
+   while (freadf(buf, sizeof(*buf), leng, fp) == leng)
+      accum_Moments(&mom, buf);
    free(buf);
-   buf = dgetmem(total * leng);
-   for (i = 0, tmpf = top->next; tmpf != NULL; i++, tmpf = tmpff) {
-      for (j = 0; j < leng; j++) {
-         buf[i * leng + j] = tmpf->f[j];
-      }
-      tmpff = tmpf->next;
-      free(tmpf->f);
-      free(tmpf);
-   }
-   free(top);
 
 /* PCA */
-   /* allocate memory for mean vectors and covariance matrix */
-   mean = dgetmem(leng);
+   stats_stage("analysis");
+   mean = mom.mean;
    var = malloc_matrix(leng);
-
-   /* calculate mean vector */
-   for (i = 0; i < leng; i++) {
-      for (j = 0, sum = 0.0; j < total; j++)
-         sum += buf[i + j * leng];
-      mean[i] = sum / total;
-   }
-   /* calculate cov. mat. */
-   for (i = 0; i < leng; i++) {
-      for (j = 0; j < leng; j++) {
-         sum = 0.0;
-         for (k = 0; k < total; k++)
-            sum +=
-                (buf[i + k * leng] - mean[i]) * (buf[j + k * leng] - mean[j]);
-         var[i][j] = sum / total;
-      }
-   }
+   cov_Moments(&mom, var[0]);
 
    /* allocate memory for eigenvector and eigenvalue */
    e_vec = malloc_matrix(leng);
    e_val = dgetmem(leng);
 
-   /* calculate eig.vec. and eig.val. with jacobi method */
-   if ((jacobi_conv = jacobi(var, leng, eps, e_val, e_vec, itemax)) == -1) {
-      fprintf(stderr, "Error : matrix is not symmetric.\n");
-      exit(EXIT_FAILURE);
-   } else if (jacobi_conv == -2) {
-      fprintf(stderr, "Error : loop in jacobi method reached %d times.\n",
-              itemax);
-      exit(EXIT_FAILURE);
+   /* sum of all eigenvalues */
+   for (i = 0, trace = 0.0; i < leng; i++)
+      trace += var[i][i];
+
+   if (use_jacobi == TRUE) {
+      /* calculate eig.vec. and eig.val. with jacobi method */
+      if ((jacobi_conv =
+           jacobi(var, leng, eps, e_val, e_vec, itemax)) == -1) {
+         fprintf(stderr, "Error : matrix is not symmetric.\n");
+         exit(EXIT_FAILURE);
+      } else if (jacobi_conv == -2) {
+         stats_frame(itemax, TR);
+         stats_close();
+         fprintf(stderr, "Error : loop in jacobi method reached %d times.\n",
+                 itemax);
+         exit(EXIT_FAILURE);
+      }
+      stats_frame((int) jacobi_conv, FA);
+   } else {
+      /* calculate only the first n eig.vec. and eig.val. */
+      if (symeig(var[0], leng, n, e_val, e_vec[0]) != 0) {
+         stats_close();
+         fprintf(stderr, "Error : QL iteration did not converge.\n");
+         exit(EXIT_FAILURE);
+      }
    }
 
    /* allocate memory for contribution rate of each eigenvalue */
    cont_rate = dgetmem(leng);
 
    /* calculate contribution rate of each eigenvalue */
-   for (j = 0; j < leng; j++) {
-      sum = 0.0;
-      for (i = 0; i < leng; i++)
-         sum += e_val[i];
-      cont_rate[j] = e_val[j] / sum;
-   }
+   for (j = 0; j < n; j++)
+      cont_rate[j] = e_val[j] / trace;
 /* end of PCA */
 
    /* output mean vector and eigen vectors */
+   stats_stage("write");
    if (out_evecFlg == TRUE) {
       fwritef(mean, sizeof(*mean), leng, stdout);
       for (i = 0; i < n; i++)
@@ -458,6 +455,7 @@ int main(int argc, char *argv[])
       }
       fclose(fp_eigen);
    }
+   stats_close();
 
    return EXIT_SUCCESS;
 }
@@ -0,0 +1,995 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    In-Process Pipeline of SPTK Commands
+
+    int  pipeline_init(p, spec, round)
+    int  pipeline_push(p, x, n, y)
+    int  pipeline_flush(p, y)
+    void pipeline_reset(p)
+    void pipeline_free(p)
+
+    PIPELINE *p     : pipeline
+    char     *spec  : description of pipeline
+                        e.g. "x2x +sf | frame -l 400 -p 80 |
+                              window -l 400 -L 512 |
+                              mcep -m 24 -a 0.42 -l 512"
+    Boolean  round  : round values passed between stages to float
+    double   *x     : input values
+    int      n      : number of input values
+    double   **y    : output values (valid until the next call)
+
+    return value of pipeline_init : 0 -> normally completed
+                                   -1 -> parse error (p->err)
+    return value of pipeline_push, pipeline_flush :
+                   number of output values, or -1 on error
+
+    The stages frame, window, mcep, mgcep, lpc, freqt, mfcc and
+    delta are run in one process with the options of the
+    corresponding commands.  Each stage buffers its input until
+    a frame is complete and passes the result directly to the
+    next stage, so no data goes through pipes or binary
+    conversions.  pipeline_flush() ends the input and cascades
+    the end of data down the chain, reproducing what each
+    command does at the end of its input.  pipeline_reset()
+    rewinds every stage for a new input while keeping its tables
+    and buffers, so that one pipeline can be run over many
+    files.  'x2x' is allowed as the first stage (type of input)
+    and as the last stage (type of output); its conversion is
+    left to the caller (p->itype, p->otype).
+
+    Since the commands exchange float data, values passed
+    between stages are rounded to float when round is TR, which
+    gives the same output as the shell pipeline.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+typedef enum _StageKind {
+   ST_FRAME, ST_WINDOW, ST_MCEP, ST_MGCEP, ST_LPC, ST_FREQT, ST_MFCC,
+   ST_DELTA
+} StageKind;
+
+/* state of frame stage */
+typedef enum _FrameState {
+   FR_FIRST,                    /* reading first frame */
+   FR_BODY,                     /* reading frame period (overlapped) */
+   FR_SKIP,                     /* skipping samples between frames */
+   FR_JUMP                      /* reading frame (not overlapped) */
+} FrameState;
+
+typedef struct _PIPESTAGE {
+   StageKind kind;
+   int ilen;                    /* number of input values per frame */
+   int olen;                    /* number of output values per frame */
+   int fill;                    /* number of buffered input values */
+   long nfrm;                   /* number of processed frames */
+   double *x;                   /* input buffer */
+   double *y;                   /* output buffer */
+   int l, fprd, cs;             /* frame */
+   Boolean noctr;
+   FrameState state;
+   Window wintype;              /* window */
+   int normflg;
+   int m, m2, itype, etype;     /* mcep, mgcep, lpc, freqt */
+   int itr1, itr2, n, otype;
+   double a, g, end, e, f;
+   MFCC mfcc;                   /* mfcc */
+   int num;
+   Boolean czero;
+   DELTASTREAM ds;              /* delta */
+} PIPESTAGE;
+
+static int stage_feed(PIPELINE * p, const int k, const double *x, int n);
+
+/* value of option av[*i]: attached ("-l400") or next word */
+static char *stage_arg(const int ac, char **av, int *i)
+{
+   if (av[*i][2] != '\0')
+      return (av[*i] + 2);
+   if (*i + 1 < ac)
+      return (av[++*i]);
+   return (NULL);
+}
+
+static int frame_init(PIPESTAGE * s, const int ac, char **av, char **err)
+{
+   int i;
+   char c, *o, *v;
+
+   s->l = 256;
+   s->fprd = 100;
+   s->noctr = FA;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-') {
+         *err = o;
+         return (-1);
+      }
+      if ((c = o[1]) == 'n') {
+         s->noctr = 1 - s->noctr;
+         continue;
+      }
+      if ((v = stage_arg(ac, av, &i)) == NULL) {
+         *err = o;
+         return (-1);
+      }
+      switch (c) {
+      case 'l':
+         s->l = atoi(v);
+         break;
+      case 'p':
+         s->fprd = atoi(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (s->l <= 0 || s->fprd <= 0) {
+      *err = av[0];
+      return (-1);
+   }
+
+   s->x = dgetmem(s->l);
+   s->olen = s->l;
+   s->state = FR_FIRST;
+
+   return (0);
+}
+
+static int window_init(PIPESTAGE * s, const int ac, char **av, char **err)
+{
+   int i;
+   char *o, *v;
+
+   s->ilen = 256;
+   s->olen = -1;
+   s->wintype = BLACKMAN;
+   s->normflg = 1;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-' || (v = stage_arg(ac, av, &i)) == NULL) {
+         *err = o;
+         return (-1);
+      }
+      switch (o[1]) {
+      case 'l':
+         s->ilen = atoi(v);
+         break;
+      case 'L':
+         s->olen = atoi(v);
+         break;
+      case 'n':
+         s->normflg = atoi(v);
+         break;
+      case 'w':
+         s->wintype = (Window) atoi(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (s->olen < 0)
+      s->olen = s->ilen;
+   if (s->ilen <= 0) {
+      *err = av[0];
+      return (-1);
+   }
+
+   s->x = dgetmem((s->ilen > s->olen) ? s->ilen : s->olen);
+   s->y = s->x;
+
+   return (0);
+}
+
+/* mcep, or mgcep when mgc is TR */
+static int mcep_init(PIPESTAGE * s, const int ac, char **av, char **err,
+                     const Boolean mgc)
+{
+   int i;
+   char *o, *v;
+
+   s->g = 0.0;
+   s->n = -1;
+   s->otype = 0;
+   s->a = 0.35;
+   s->m = 25;
+   s->l = 256;
+   s->itype = 0;
+   s->etype = 0;
+   s->itr1 = 2;
+   s->itr2 = 30;
+   s->end = 0.001;
+   s->e = 0.0;
+   s->f = 0.000001;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-' || (v = stage_arg(ac, av, &i)) == NULL
+          || (!mgc && strchr("gcop", o[1]) != NULL)) {
+         *err = o;
+         return (-1);
+      }
+      switch (o[1]) {
+      case 'a':
+         s->a = atof(v);
+         break;
+      case 'm':
+         s->m = atoi(v);
+         break;
+      case 'l':
+         s->l = atoi(v);
+         break;
+      case 'q':
+         s->itype = atoi(v);
+         break;
+      case 'i':
+         s->itr1 = atoi(v);
+         break;
+      case 'j':
+         s->itr2 = atoi(v);
+         break;
+      case 'd':
+         s->end = atof(v);
+         break;
+      case 'e':
+         s->etype = 1;
+         s->e = atof(v);
+         break;
+      case 'E':
+         s->etype = 2;
+         s->e = atof(v);
+         break;
+      case 'f':
+         s->f = atof(v);
+         break;
+      case 'g':
+         s->g = atof(v);
+         break;
+      case 'c':
+         if (atoi(v) < 1) {
+            *err = o;
+            return (-1);
+         }
+         s->g = -1.0 / atoi(v);
+         break;
+      case 'o':
+         s->otype = atoi(v);
+         break;
+      case 'p':
+         s->n = atoi(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (s->l <= 0 || s->m < 0) {
+      *err = av[0];
+      return (-1);
+   }
+   if (s->n == -1)
+      s->n = s->l - 1;
+
+   s->ilen = (s->itype == 0) ? s->l : s->l / 2 + 1;
+   s->olen = s->m + 1;
+   s->x = dgetmem(s->l + 2 * s->olen);
+   s->y = s->x + s->l;
+
+   return (0);
+}
+
+static int lpc_init(PIPESTAGE * s, const int ac, char **av, char **err)
+{
+   int i;
+   char *o, *v;
+
+   s->m = 25;
+   s->ilen = 256;
+   s->f = 0.000001;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-' || (v = stage_arg(ac, av, &i)) == NULL) {
+         *err = o;
+         return (-1);
+      }
+      switch (o[1]) {
+      case 'm':
+         s->m = atoi(v);
+         break;
+      case 'l':
+         s->ilen = atoi(v);
+         break;
+      case 'f':
+         s->f = atof(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (s->ilen <= 0 || s->m < 0) {
+      *err = av[0];
+      return (-1);
+   }
+
+   s->olen = s->m + 1;
+   s->x = dgetmem(s->ilen + s->olen);
+   s->y = s->x + s->ilen;
+
+   return (0);
+}
+
+static int freqt_init(PIPESTAGE * s, const int ac, char **av, char **err)
+{
+   int i;
+   double a1 = 0.0, a2 = 0.35;
+   char *o, *v;
+
+   s->m = 25;
+   s->m2 = 25;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-' || (v = stage_arg(ac, av, &i)) == NULL) {
+         *err = o;
+         return (-1);
+      }
+      switch (o[1]) {
+      case 'm':
+         s->m = atoi(v);
+         break;
+      case 'M':
+         s->m2 = atoi(v);
+         break;
+      case 'a':
+         a1 = atof(v);
+         break;
+      case 'A':
+         a2 = atof(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (s->m < 0 || s->m2 < 0) {
+      *err = av[0];
+      return (-1);
+   }
+
+   s->a = (a2 - a1) / (1 - a1 * a2);
+   s->ilen = s->m + 1;
+   s->olen = s->m2 + 1;
+   s->x = dgetmem(s->ilen + s->olen);
+   s->y = s->x + s->ilen;
+
+   return (0);
+}
+
+static int mfcc_stage_init(PIPESTAGE * s, const int ac, char **av,
+                           char **err)
+{
+   int i, lift = 22, wtype = 0, L = -1;
+   double eps = 1.0, fs = 16.0, alpha = 0.97;
+   char c, *o, *v;
+
+   s->l = 256;
+   s->m = 12;
+   s->n = 20;
+   s->num = 0;
+   s->czero = FA;
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-') {
+         *err = o;
+         return (-1);
+      }
+      if ((c = o[1]) == 'd')
+         continue;
+      if (c == 'E' || c == '0') {
+         if (c == '0')
+            s->czero = 1 - s->czero;
+         s->num++;
+         continue;
+      }
+      if ((v = stage_arg(ac, av, &i)) == NULL) {
+         *err = o;
+         return (-1);
+      }
+      switch (c) {
+      case 'a':
+         alpha = atof(v);
+         break;
+      case 'c':
+         lift = atoi(v);
+         break;
+      case 'e':
+         eps = atof(v);
+         break;
+      case 'f':
+      case 's':
+         fs = atof(v);
+         break;
+      case 'l':
+         s->l = atoi(v);
+         break;
+      case 'L':
+         L = atoi(v);
+         break;
+      case 'm':
+         s->m = atoi(v);
+         break;
+      case 'n':
+         s->n = atoi(v);
+         break;
+      case 'w':
+         wtype = atoi(v);
+         break;
+      default:
+         *err = o;
+         return (-1);
+      }
+   }
+   if (L < 0)
+      for (L = 2; L <= s->l; L *= 2) {
+      }
+   if (s->l <= 0 || s->m < 1 || s->n < 1
+       || mfcc_init(&s->mfcc, fs * 1000, alpha, eps, s->l, L, s->m + 1, s->n,
+                    lift, (wtype == 0) ? TR : FA) < 0) {
+      *err = av[0];
+      return (-1);
+   }
+
+   s->ilen = s->l;
+   s->olen = s->m + s->num;
+   s->x = dgetmem(s->ilen + s->m + 2);
+   s->y = s->x + s->ilen;
+
+   return (0);
+}
+
+static int delta_stage_init(PIPESTAGE * s, const int ac, char **av,
+                            char **err)
+{
+   int i, j, d, n, a0, a1, a2, nwin = 1, calccoef = -1, leng = 25;
+   int *lw, *rw;
+   double **coef;
+   DELTAWINDOW window;
+   char c, *o, *v;
+
+   lw = (int *) getmem(ac + 1, sizeof(*lw));
+   rw = (int *) getmem(ac + 1, sizeof(*rw));
+   coef = (double **) getmem(ac + 1, sizeof(*coef));
+   coef[0] = dgetmem(1);
+   coef[0][0] = 1.0;
+
+   for (i = 1; i < ac; i++) {
+      if (*(o = av[i]) != '-' || (v = stage_arg(ac, av, &i)) == NULL)
+         break;
+      c = o[1];
+      if (c == 'm')
+         leng = atoi(v) + 1;
+      else if (c == 'l')
+         leng = atoi(v);
+      else if (c == 'd' && calccoef != 1 && isfloat(v)) {
+         /* coefficients of window */
+         calccoef = 0;
+         for (n = 1; i + n < ac && isfloat(av[i + n]); n++);
+         coef[nwin] = dgetmem(n);
+         coef[nwin][0] = atof(v);
+         for (j = 1; j < n; j++)
+            coef[nwin][j] = atof(av[i + j]);
+         i += n - 1;
+         coef[nwin] += n / 2;
+         lw[nwin] = -(n / 2);
+         rw[nwin] = n / 2 - ((n % 2 == 0) ? 1 : 0);
+         nwin++;
+      } else if (c == 'r' && calccoef == -1 && (n = atoi(v)) >= 1 && n <= 2
+                 && i + n < ac) {
+         /* width of regression windows */
+         calccoef = 1;
+         for (d = 1; d <= n; d++) {
+            if ((j = atoi(av[i + d])) < 1)
+               break;
+            lw[d] = -j;
+            rw[d] = j;
+            coef[d] = dgetmem(2 * j + 1) + j;
+         }
+         if (d <= n)
+            break;
+         i += n;
+         nwin = n + 1;
+
+         for (a1 = 0, j = lw[1]; j <= rw[1]; a1 += j * j, j++);
+         for (j = lw[1]; j <= rw[1]; j++)
+            coef[1][j] = (double) j / (double) a1;
+         if (nwin > 2) {
+            for (a0 = a1 = a2 = 0, j = lw[2]; j <= rw[2];
+                 a0++, a1 += j * j, a2 += j * j * j * j, j++);
+            for (j = lw[2]; j <= rw[2]; j++)
+               coef[2][j] = 2 * ((double) (a0 * j * j - a1)) /
+                   ((double) (a2 * a0 - a1 * a1));
+         }
+      } else
+         break;
+   }
+   if (i < ac || calccoef < 0 || leng <= 0)
+      *err = (i < ac) ? av[i] : av[0];
+   else {
+      window.win_size = nwin;
+      window.win_l_width = lw;
+      window.win_r_width = rw;
+      window.win_coefficient = coef;
+      delta_init(&s->ds, &window, leng);
+
+      s->ilen = leng;
+      s->olen = nwin * leng;
+      s->x = dgetmem(s->ilen + s->olen);
+      s->y = s->x + s->ilen;
+   }
+
+   for (d = 0; d < nwin; d++)
+      free(coef[d] + lw[d]);
+   free(coef);
+   free(lw);
+   free(rw);
+
+   return ((s->x == NULL) ? -1 : 0);
+}
+
+/* x2x as first or last stage */
+static int x2x_init(PIPELINE * p, const int ac, char **av, const Boolean first,
+                    const Boolean last)
+{
+   char *o = av[1];
+
+   if (ac != 2 || strlen(o) != 3 || o[0] != '+') {
+      p->err = (ac < 2) ? av[0] : o;
+      return (-1);
+   }
+   if (first && o[2] == 'f' && strchr("cCsSiIfd", o[1]) != NULL)
+      p->itype = o[1];
+   else if (last && o[1] == 'f' && strchr("fd", o[2]) != NULL)
+      p->otype = o[2];
+   else if (o[1] != 'f' || o[2] != 'f') {
+      p->err = o;
+      return (-1);
+   }
+
+   return (0);
+}
+
+static void round_float(double *x, int n)
+{
+   while (n--) {
+      *x = (float) *x;
+      x++;
+   }
+}
+
+static int emit(PIPELINE * p, const int k, double *y, const int n)
+{
+   if (p->round)
+      round_float(y, n);
+
+   return (stage_feed(p, k + 1, y, n));
+}
+
+static int sink(PIPELINE * p, const double *x, const int n)
+{
+   double *out;
+
+   if (p->nout + n > p->size) {
+      p->size = 2 * (p->nout + n);
+      out = dgetmem(p->size);
+      if (p->out != NULL) {
+         memcpy(out, p->out, sizeof(*out) * p->nout);
+         free(p->out);
+      }
+      p->out = out;
+   }
+   memcpy(p->out + p->nout, x, sizeof(*x) * n);
+   p->nout += n;
+
+   return (0);
+}
+
+/* prepare the next frame of frame stage after one has been emitted */
+static void frame_next(PIPESTAGE * s)
+{
+   int ns = s->l - s->fprd;
+
+   if (ns > 0) {
+      memmove(s->x, s->x + s->fprd, sizeof(*s->x) * ns);
+      s->state = FR_BODY;
+   } else
+      s->state = (ns < 0) ? FR_SKIP : FR_JUMP;
+}
+
+static int frame_feed(PIPELINE * p, const int k, const double *x, int n)
+{
+   PIPESTAGE *s = p->stage + k;
+   double *dst;
+   int i, need;
+
+   while (n > 0) {
+      switch (s->state) {
+      case FR_FIRST:
+         dst = s->noctr ? s->x : s->x + s->l / 2;
+         need = s->noctr ? s->l : (s->l + 1) / 2;
+         break;
+      case FR_BODY:
+         dst = s->x + s->l - s->fprd;
+         need = s->fprd;
+         break;
+      case FR_SKIP:
+         dst = NULL;
+         need = s->fprd - s->l;
+         break;
+      default:
+         dst = s->x;
+         need = s->l;
+         break;
+      }
+
+      i = (need - s->fill < n) ? need - s->fill : n;
+      if (dst != NULL)
+         memcpy(dst + s->fill, x, sizeof(*x) * i);
+      s->fill += i;
+      x += i;
+      n -= i;
+
+      if (s->fill == need) {
+         s->fill = 0;
+         if (s->state == FR_SKIP) {
+            s->state = FR_JUMP;
+            continue;
+         }
+         if (s->state == FR_FIRST)
+            s->cs = need;
+         if (emit(p, k, s->x, s->l) < 0)
+            return (-1);
+         frame_next(s);
+      }
+   }
+
+   return (0);
+}
+
+static int frame_flush(PIPELINE * p, const int k)
+{
+   PIPESTAGE *s = p->stage + k;
+   double *dst;
+   int i;
+
+   switch (s->state) {
+   case FR_FIRST:
+      if (s->fill == 0)
+         return (0);
+      s->cs = s->fill;
+      s->fill = 0;
+      if (emit(p, k, s->x, s->l) < 0)
+         return (-1);
+      frame_next(s);
+      if (s->state != FR_BODY)
+         return (0);
+      /* fall through */
+   case FR_BODY:
+      for (;;) {
+         dst = s->x + s->l - s->fprd;
+         for (i = s->fill; i < s->fprd; i++)
+            dst[i] = 0.0;
+         s->cs -= s->fprd - s->fill;
+         s->fill = 0;
+         if (s->cs <= 0)
+            break;
+         if (emit(p, k, s->x, s->l) < 0)
+            return (-1);
+         frame_next(s);
+      }
+      break;
+   case FR_JUMP:
+      if (s->fill > 0) {
+         for (i = s->fill; i < s->l; i++)
+            s->x[i] = 0.0;
+         s->fill = 0;
+         if (emit(p, k, s->x, s->l) < 0)
+            return (-1);
+      }
+      break;
+   default:
+      break;
+   }
+
+   return (0);
+}
+
+/* process one frame; returns the number of output values */
+static int stage_run(PIPESTAGE * s)
+{
+   int flag;
+
+   switch (s->kind) {
+   case ST_WINDOW:
+      window(s->wintype, s->x, s->ilen, s->normflg);
+      break;
+   case ST_MCEP:
+      mcep(s->x, s->l, s->y, s->m, s->a, s->itr1, s->itr2, s->end, s->etype,
+           s->e, s->f, s->itype);
+      break;
+   case ST_MGCEP:
+      mgcep(s->x, s->l, s->y, s->m, s->a, s->g, s->n, s->itr1, s->itr2,
+            s->end, s->etype, s->e, s->f, s->itype);
+      if (s->otype == 0 || s->otype == 1 || s->otype == 2 || s->otype == 4)
+         ignorm(s->y, s->y, s->m, s->g);
+      if ((s->otype == 0 || s->otype == 2 || s->otype == 4) && s->a != 0.0)
+         b2mc(s->y, s->y, s->m, s->a);
+      if (s->otype == 2 || s->otype == 4)
+         gnorm(s->y, s->y, s->m, s->g);
+      if (s->otype == 4 || s->otype == 5)
+         for (flag = s->m; flag >= 1; flag--)
+            s->y[flag] *= s->g;
+      break;
+   case ST_MFCC:
+      mfcc_batch(&s->mfcc, s->x, 1, s->y);
+      if (!s->czero)
+         s->y[s->m] = s->y[s->m + 1];
+      break;
+   case ST_LPC:
+      lpc_batch(s->x, s->ilen, 1, s->y, s->m, s->f, &flag);
+      if (flag == -1) {
+         fprintf(stderr,
+                 "lpc : The coefficient matrix of the normal equation is singular at %ldth frame!\n",
+                 s->nfrm);
+         return (-1);
+      }
+      if (flag == -2)
+         fprintf(stderr,
+                 "lpc : Extracted LPC coefficients become unstable at %ldth frame!\n",
+                 s->nfrm);
+      break;
+   case ST_FREQT:
+      freqt_batch(s->x, s->m, s->y, s->m2, s->a, 1);
+      break;
+   case ST_DELTA:
+      if (!delta_push(&s->ds, s->x, s->y))
+         return (0);
+      break;
+   default:
+      break;
+   }
+   s->nfrm++;
+
+   return (s->olen);
+}
+
+static int stage_feed(PIPELINE * p, const int k, const double *x, int n)
+{
+   PIPESTAGE *s;
+   int i;
+
+   if (k == p->nstage)
+      return (sink(p, x, n));
+
+   s = p->stage + k;
+   if (s->kind == ST_FRAME)
+      return (frame_feed(p, k, x, n));
+
+   while (n > 0) {
+      i = (s->ilen - s->fill < n) ? s->ilen - s->fill : n;
+      memcpy(s->x + s->fill, x, sizeof(*x) * i);
+      s->fill += i;
+      x += i;
+      n -= i;
+
+      if (s->fill == s->ilen) {
+         s->fill = 0;
+         if ((i = stage_run(s)) < 0)
+            return (-1);
+         if (i > 0 && emit(p, k, s->y, i) < 0)
+            return (-1);
+      }
+   }
+
+   return (0);
+}
+
+int pipeline_init(PIPELINE * p, const char *spec, const Boolean round)
+{
+   int k, ac, nbar, ret = 0;
+   char *s, *bar, **av;
+   PIPESTAGE *st;
+
+   p->spec = getmem(strlen(spec) + 1, sizeof(*p->spec));
+   strcpy(p->spec, spec);
+   p->round = round;
+   p->itype = p->otype = 'f';
+   p->err = NULL;
+   p->out = NULL;
+   p->nout = p->size = 0;
+
+   for (nbar = 0, s = p->spec; (s = strchr(s, '|')) != NULL; s++, nbar++);
+   p->stage = (PIPESTAGE *) getmem(nbar + 1, sizeof(*p->stage));
+   p->nstage = 0;
+   av = (char **) getmem(strlen(spec) / 2 + 2, sizeof(*av));
+
+   for (k = 0, s = p->spec; s != NULL && ret == 0; k++, s = bar) {
+      if ((bar = strchr(s, '|')) != NULL)
+         *bar++ = '\0';
+
+      /* split stage into words */
+      for (ac = 0;;) {
+         while (*s == ' ' || *s == '\t' || *s == '\n')
+            *s++ = '\0';
+         if (*s == '\0')
+            break;
+         av[ac++] = s;
+         while (*s != '\0' && *s != ' ' && *s != '\t' && *s != '\n')
+            s++;
+      }
+      if (ac == 0) {
+         p->err = "|";
+         ret = -1;
+         break;
+      }
+
+      st = p->stage + p->nstage;
+      if (strcmp(av[0], "x2x") == 0) {
+         ret = x2x_init(p, ac, av, k == 0, bar == NULL);
+         continue;
+      }
+      if (strcmp(av[0], "frame") == 0) {
+         st->kind = ST_FRAME;
+         ret = frame_init(st, ac, av, &p->err);
+      } else if (strcmp(av[0], "window") == 0) {
+         st->kind = ST_WINDOW;
+         ret = window_init(st, ac, av, &p->err);
+      } else if (strcmp(av[0], "mcep") == 0) {
+         st->kind = ST_MCEP;
+         ret = mcep_init(st, ac, av, &p->err, FA);
+      } else if (strcmp(av[0], "mgcep") == 0) {
+         st->kind = ST_MGCEP;
+         ret = mcep_init(st, ac, av, &p->err, TR);
+      } else if (strcmp(av[0], "mfcc") == 0) {
+         st->kind = ST_MFCC;
+         ret = mfcc_stage_init(st, ac, av, &p->err);
+      } else if (strcmp(av[0], "lpc") == 0) {
+         st->kind = ST_LPC;
+         ret = lpc_init(st, ac, av, &p->err);
+      } else if (strcmp(av[0], "freqt") == 0) {
+         st->kind = ST_FREQT;
+         ret = freqt_init(st, ac, av, &p->err);
+      } else if (strcmp(av[0], "delta") == 0) {
+         st->kind = ST_DELTA;
+         ret = delta_stage_init(st, ac, av, &p->err);
+      } else {
+         p->err = av[0];
+         ret = -1;
+      }
+      if (ret == 0)
+         p->nstage++;
+   }
+   free(av);
+
+   return (ret);
+}
+
+int pipeline_push(PIPELINE * p, const double *x, const int n, double **y)
+{
+   p->nout = 0;
+   if (stage_feed(p, 0, x, n) < 0)
+      return (-1);
+   *y = p->out;
+
+   return (p->nout);
+}
+
+int pipeline_flush(PIPELINE * p, double **y)
+{
+   int k;
+   PIPESTAGE *s;
+
+   p->nout = 0;
+   for (k = 0; k < p->nstage; k++) {
+      s = p->stage + k;
+      if (s->kind == ST_FRAME) {
+         if (frame_flush(p, k) < 0)
+            return (-1);
+      } else if (s->kind == ST_DELTA) {
+         while (delta_flush(&s->ds, s->y))
+            if (emit(p, k, s->y, s->olen) < 0)
+               return (-1);
+      }
+      s->fill = 0;
+   }
+   *y = p->out;
+
+   return (p->nout);
+}
+
+void pipeline_reset(PIPELINE * p)
+{
+   int k;
+   PIPESTAGE *s;
+
+   for (k = 0; k < p->nstage; k++) {
+      s = p->stage + k;
+      s->fill = 0;
+      s->nfrm = 0;
+      s->cs = 0;
+      s->state = FR_FIRST;
+      if (s->kind == ST_FRAME)
+         fillz(s->x, sizeof(*s->x), s->l);
+      if (s->kind == ST_DELTA)
+         s->ds.nin = s->ds.nout = 0;
+   }
+   p->nout = 0;
+}
+
+void pipeline_free(PIPELINE * p)
+{
+   int k;
+
+   for (k = 0; k < p->nstage; k++) {
+      if (p->stage[k].kind == ST_DELTA)
+         delta_free(&p->stage[k].ds);
+      if (p->stage[k].kind == ST_MFCC)
+         mfcc_free(&p->stage[k].mfcc);
+      free(p->stage[k].x);
+   }
+   free(p->stage);
+   free(p->spec);
+   if (p->out != NULL)
+      free(p->out);
+   p->nstage = 0;
+   p->stage = NULL;
+   p->spec = NULL;
+   p->out = NULL;
+}
@@ -0,0 +1,253 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/************************************************************************
+*                                                                       *
+*    In-Process Pipeline of SPTK Commands                               *
+*                                                                       *
+*                                                                       *
+*       usage:                                                          *
+*               pipeline [ options ] pipe [ infile ] > stdout           *
+*       options:                                                        *
+*               -d       :  pass double precision values        [FALSE] *
+*                           between stages                              *
+*       pipe:                                                           *
+*               commands separated by '|', e.g.                         *
+*               'x2x +sf | frame -l 400 -p 80 | window -l 400 -L 512 |  *
+*                mcep -m 24 -a 0.42 -l 512 | delta -m 24 -r 1 1'        *
+*               supported commands are frame, window, mcep, mgcep,      *
+*               lpc, freqt, mfcc, delta (-d coef... or -r) and x2x      *
+*               (first or last command only)                            *
+*       infile:                                                         *
+*               input of the first command                              *
+*       stdout:                                                         *
+*               output of the last command                              *
+*       require:                                                        *
+*               pipeline_init(), pipeline_push(), pipeline_flush()      *
+*                                                                       *
+************************************************************************/
+
+static char *rcs_id = "$Id$";
+
+
+/*  Standard C Libraries  */
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#else
+#  include <strings.h>
+#  ifndef HAVE_STRRCHR
+#     define strrchr rindex
+#  endif
+#endif
+
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+/*  Default Values  */
+#define DOUBLE FA
+#define BLOCK 4096              /* number of samples read at a time */
+
+/*  Command Name  */
+char *cmnd;
+char *BOOL[] = { "FALSE", "TRUE" };
+
+
+void usage(int status)
+{
+   fprintf(stderr, "\n");
+   fprintf(stderr, " %s - in-process pipeline of SPTK commands\n", cmnd);
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  usage:\n");
+   fprintf(stderr, "       %s [ options ] pipe [ infile ] > stdout\n", cmnd);
+   fprintf(stderr, "  options:\n");
+   fprintf(stderr,
+           "       -d    : pass double precision values between stages [%s]\n",
+           BOOL[DOUBLE]);
+   fprintf(stderr, "       -h    : print this message\n");
+   fprintf(stderr, "  pipe:\n");
+   fprintf(stderr, "       commands separated by '|', e.g.\n");
+   fprintf(stderr,
+           "       'x2x +sf | frame -l 400 -p 80 | window -l 400 -L 512 |\n");
+   fprintf(stderr, "        mcep -m 24 -a 0.42 -l 512 | delta -m 24 -r 1 1'\n");
+   fprintf(stderr,
+           "       supported commands are frame, window, mcep, mgcep, lpc,\n");
+   fprintf(stderr,
+           "       freqt, mfcc, delta (-d coef... or -r) and x2x (first or\n");
+   fprintf(stderr, "       last command)\n");
+   fprintf(stderr, "  infile:\n");
+   fprintf(stderr,
+           "       input of the first command                         [stdin]\n");
+   fprintf(stderr, "  stdout:\n");
+   fprintf(stderr, "       output of the last command\n");
+#ifdef PACKAGE_VERSION
+   fprintf(stderr, "\n");
+   fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
+   fprintf(stderr, " CVS Info: %s", rcs_id);
+#endif
+   fprintf(stderr, "\n");
+   exit(status);
+}
+
+/* read up to n values of given type */
+static int read_input(char type, void *raw, double *x, const int n, FILE * fp)
+{
+   int i, k;
+
+   switch (type) {
+   case 'c':
+      k = fread(raw, sizeof(char), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((signed char *) raw)[i];
+      break;
+   case 'C':
+      k = fread(raw, sizeof(char), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((unsigned char *) raw)[i];
+      break;
+   case 's':
+      k = fread(raw, sizeof(short), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((short *) raw)[i];
+      break;
+   case 'S':
+      k = fread(raw, sizeof(short), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((unsigned short *) raw)[i];
+      break;
+   case 'i':
+      k = fread(raw, sizeof(int), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((int *) raw)[i];
+      break;
+   case 'I':
+      k = fread(raw, sizeof(int), n, fp);
+      for (i = 0; i < k; i++)
+         x[i] = ((unsigned int *) raw)[i];
+      break;
+   case 'd':
+      k = fread(x, sizeof(double), n, fp);
+      break;
+   default:
+      k = freadf(x, sizeof(*x), n, fp);
+      break;
+   }
+
+   return (k);
+}
+
+static void write_output(char type, double *y, const int n)
+{
+   if (type == 'd')
+      fwrite(y, sizeof(*y), n, stdout);
+   else
+      fwritef(y, sizeof(*y), n, stdout);
+}
+
+int main(int argc, char **argv)
+{
+   FILE *fp = stdin;
+   char *spec = NULL;
+   double *x, *y;
+   void *raw;
+   int i, n;
+   Boolean dbl = DOUBLE;
+   PIPELINE p;
+
+   if ((cmnd = strrchr(argv[0], '/')) == NULL)
+      cmnd = argv[0];
+   else
+      cmnd++;
+
+   while (--argc)
+      if (**++argv == '-' && *(*argv + 1) != '\0' && spec == NULL) {
+         switch (*(*argv + 1)) {
+         case 'd':
+            dbl = 1 - dbl;
+            break;
+         case 'h':
+            usage(0);
+         default:
+            fprintf(stderr, "%s : Invalid option '%c'!\n", cmnd, *(*argv + 1));
+            usage(1);
+         }
+      } else if (spec == NULL)
+         spec = *argv;
+      else
+         fp = getfp(*argv, "rb");
+
+   if (spec == NULL) {
+      fprintf(stderr, "%s : Pipeline is not specified!\n", cmnd);
+      usage(1);
+   }
+   if (pipeline_init(&p, spec, 1 - dbl) < 0) {
+      fprintf(stderr, "%s : Cannot run '%s' in pipeline!\n", cmnd, p.err);
+      usage(1);
+   }
+
+   x = dgetmem(BLOCK);
+   raw = getmem(BLOCK, sizeof(double));
+
+   while ((n = read_input(p.itype, raw, x, BLOCK, fp)) > 0) {
+      if (p.itype == 'd' && !dbl)
+         for (i = 0; i < n; i++)
+            x[i] = (float) x[i];
+      if ((n = pipeline_push(&p, x, n, &y)) < 0)
+         return (1);
+      write_output(p.otype, y, n);
+   }
+   if ((n = pipeline_flush(&p, &y)) < 0)
+      return (1);
+   write_output(p.otype, y, n);
+
+   pipeline_free(&p);
+
+   return (0);
+}
@@ -53,6 +53,9 @@
 *                                         1999.12 T.Yoshimura modified  *
 *                                                                       *
 *    Usage: root_pol(a, odr, x, a_zero, eps, itrat)                     *
+*           root_pol_eig(a, odr, x, a_zero, eps, itrat)                 *
+*           root_pol_aberth(a, odr, x, a_zero, eps, itrat)              *
+*           root_pol_batch(a, odr, x, nfrm, a_zero, eps, itrat, flag)   *
 *                                                                       *
 *    Description:                                                       *
 *                                                                       *
@@ -66,6 +69,22 @@
 *                                                                       *
 *        x[0].re,x[0].im,...,x[n-1].re,x[n-1].im                        *
 *                                                                       *
+*    root_pol_eig() finds the roots as the eigenvalues of the           *
+*    balanced companion matrix, which is upper Hessenberg, by the       *
+*    shifted QR algorithm, and polishes them by Aberth iteration.       *
+*    root_pol_aberth() refines the initial roots given in x by          *
+*    Aberth iteration.  Neither modifies a nor exits; they return       *
+*    0, or -1 if the iteration did not converge.                        *
+*    root_pol_batch() solves nfrm polynomials of odr+1 coefficients     *
+*    (x holds odr+1 roots per frame, x[0] unused as in root_pol()).     *
+*    The first frame is solved by root_pol_eig(); every following       *
+*    frame is warm-started from the roots of the previous frame by      *
+*    root_pol_aberth(), falling back to root_pol_eig().  flag[t] is     *
+*    0, or -1 if frame t failed (flag may be NULL); the return value    *
+*    is -1 if any frame failed.                                         *
+*    Each solved polynomial is reported to stats_frame() with the       *
+*    number of iterations (QR steps plus Aberth sweeps).                *
+*                                                                       *
 *                                                                       *
 ************************************************************************/
 
@@ -82,6 +101,8 @@
 
 typedef enum { plus, minus, multiply, divide } opt;
 
+static int nitr;                /* iterations of the current polynomial */
+
 
 static double rad_root(const double x, const int i)
 {
@@ -170,6 +191,7 @@ void output_root_pol(Complex * x, int odr, int form)
    }
 
    fwritef(a, sizeof(*a), odr * 2, stdout);
+   free(a);
 
    return;
 }
@@ -197,7 +219,7 @@ void root_pol(double *a, const int odr, Complex * x, const int a_zero,
    double th, th1, th2, cm, cmax;
    Complex cden, cnum, c1, *deltx;
 
-   deltx = cplx_getmem(odr);
+   deltx = cplx_getmem(odr + 1);
 
    if (!a_zero)
       for (i = 1; i <= odr; i++)
@@ -241,10 +263,379 @@ void root_pol(double *a, const int odr, Complex * x, const int a_zero,
    }
    while ((l <= itrat) && (k <= odr));
 
+   stats_frame(l - 1, l > itrat);
    if (l > itrat) {
       fprintf(stderr, "root_pol : No convergence!\n");
       exit(1);
    }
 
+   free(deltx);
+
    return;
 }
+
+#define RADIX 2.0
+#define H(i, j) h[(i) * n + (j)]
+
+/* balance the rows and columns of h by powers of RADIX */
+static void balance(double *h, const int n)
+{
+   int i, j, done = 0;
+   double c, r, f, g, s;
+
+   while (!done) {
+      done = 1;
+      for (i = 0; i < n; i++) {
+         c = r = 0.0;
+         for (j = 0; j < n; j++)
+            if (j != i) {
+               c += fabs(H(j, i));
+               r += fabs(H(i, j));
+            }
+         if (c == 0.0 || r == 0.0)
+            continue;
+         g = r / RADIX;
+         f = 1.0;
+         s = c + r;
+         while (c < g) {
+            f *= RADIX;
+            c *= RADIX * RADIX;
+         }
+         g = r * RADIX;
+         while (c > g) {
+            f /= RADIX;
+            c /= RADIX * RADIX;
+         }
+         if ((c + r) / f < 0.95 * s) {
+            done = 0;
+            for (j = 0; j < n; j++)
+               H(i, j) /= f;
+            for (j = 0; j < n; j++)
+               H(j, i) *= f;
+         }
+      }
+   }
+
+   return;
+}
+
+/* eigenvalues of the upper Hessenberg matrix h (destroyed) by the
+   Francis double shift QR algorithm */
+static int hqr(double *h, const int n, Complex * w, const int itrat)
+{
+   int nn, m, l, k, j, i, its, mmin;
+   double z = 0.0, y, x, v, u, t, s, r = 0.0, q = 0.0, p = 0.0, ww, anorm;
+
+   anorm = 0.0;
+   for (i = 0; i < n; i++)
+      for (j = (i > 0) ? i - 1 : 0; j < n; j++)
+         anorm += fabs(H(i, j));
+
+   nn = n - 1;
+   t = 0.0;
+   while (nn >= 0) {
+      its = 0;
+      do {
+         for (l = nn; l >= 1; l--) {
+            s = fabs(H(l - 1, l - 1)) + fabs(H(l, l));
+            if (s == 0.0)
+               s = anorm;
+            if (fabs(H(l, l - 1)) + s == s) {
+               H(l, l - 1) = 0.0;
+               break;
+            }
+         }
+         x = H(nn, nn);
+         if (l == nn) {         /* one root found */
+            w[nn].re = x + t;
+            w[nn--].im = 0.0;
+         } else {
+            y = H(nn - 1, nn - 1);
+            ww = H(nn, nn - 1) * H(nn - 1, nn);
+            if (l == nn - 1) {  /* two roots found */
+               p = 0.5 * (y - x);
+               q = p * p + ww;
+               z = sqrt(fabs(q));
+               x += t;
+               if (q >= 0.0) {
+                  z = (p >= 0.0) ? p + z : p - z;
+                  w[nn - 1].re = w[nn].re = x + z;
+                  if (z != 0.0)
+                     w[nn].re = x - ww / z;
+                  w[nn - 1].im = w[nn].im = 0.0;
+               } else {
+                  w[nn - 1].re = w[nn].re = x + p;
+                  w[nn - 1].im = -z;
+                  w[nn].im = z;
+               }
+               nn -= 2;
+            } else {
+               if (its >= itrat)
+                  return (-1);
+               if (its == 10 || its == 20) {    /* exceptional shift */
+                  t += x;
+                  for (i = 0; i <= nn; i++)
+                     H(i, i) -= x;
+                  s = fabs(H(nn, nn - 1)) + fabs(H(nn - 1, nn - 2));
+                  y = x = 0.75 * s;
+                  ww = -0.4375 * s * s;
+               }
+               its++;
+               nitr++;
+               for (m = nn - 2; m >= l; m--) {
+                  z = H(m, m);
+                  r = x - z;
+                  s = y - z;
+                  p = (r * s - ww) / H(m + 1, m) + H(m, m + 1);
+                  q = H(m + 1, m + 1) - z - r - s;
+                  r = H(m + 2, m + 1);
+                  s = fabs(p) + fabs(q) + fabs(r);
+                  p /= s;
+                  q /= s;
+                  r /= s;
+                  if (m == l)
+                     break;
+                  u = fabs(H(m, m - 1)) * (fabs(q) + fabs(r));
+                  v = fabs(p) * (fabs(H(m - 1, m - 1)) + fabs(z)
+                                 + fabs(H(m + 1, m + 1)));
+                  if (u + v == v)
+                     break;
+               }
+               for (i = m + 2; i <= nn; i++) {
+                  H(i, i - 2) = 0.0;
+                  if (i != m + 2)
+                     H(i, i - 3) = 0.0;
+               }
+               for (k = m; k <= nn - 1; k++) {
+                  if (k != m) {
+                     p = H(k, k - 1);
+                     q = H(k + 1, k - 1);
+                     r = (k != nn - 1) ? H(k + 2, k - 1) : 0.0;
+                     if ((x = fabs(p) + fabs(q) + fabs(r)) != 0.0) {
+                        p /= x;
+                        q /= x;
+                        r /= x;
+                     }
+                  }
+                  s = sqrt(p * p + q * q + r * r);
+                  if (p < 0.0)
+                     s = -s;
+                  if (s == 0.0)
+                     continue;
+                  if (k == m) {
+                     if (l != m)
+                        H(k, k - 1) = -H(k, k - 1);
+                  } else
+                     H(k, k - 1) = -s * x;
+                  p += s;
+                  x = p / s;
+                  y = q / s;
+                  z = r / s;
+                  q /= p;
+                  r /= p;
+                  for (j = k; j <= nn; j++) {
+                     p = H(k, j) + q * H(k + 1, j);
+                     if (k != nn - 1) {
+                        p += r * H(k + 2, j);
+                        H(k + 2, j) -= p * z;
+                     }
+                     H(k + 1, j) -= p * y;
+                     H(k, j) -= p * x;
+                  }
+                  mmin = (nn < k + 3) ? nn : k + 3;
+                  for (i = l; i <= mmin; i++) {
+                     p = x * H(i, k) + y * H(i, k + 1);
+                     if (k != nn - 1) {
+                        p += z * H(i, k + 2);
+                        H(i, k + 2) -= p * r;
+                     }
+                     H(i, k + 1) -= p * q;
+                     H(i, k) -= p;
+                  }
+               }
+            }
+         }
+      } while (l < nn - 1);
+   }
+
+   return (0);
+}
+
+/* Aberth iteration for the monic polynomial c (c[0] = 1) */
+static int aberth(double *c, const int odr, Complex * x, const double eps,
+                  const int itrat)
+{
+   int i, j, k, l;
+   double pr, pi, dr, di, sr, si, nr, ni, tr, ti, den, dmax;
+
+   for (l = 0; l < itrat; l++) {
+      nitr++;
+      dmax = 0.0;
+      for (i = 1; i <= odr; i++) {
+         /* p(x_i) and p'(x_i) by Horner's rule */
+         pr = 1.0;
+         pi = dr = di = 0.0;
+         for (k = 1; k <= odr; k++) {
+            tr = dr * x[i].re - di * x[i].im + pr;
+            di = dr * x[i].im + di * x[i].re + pi;
+            dr = tr;
+            tr = pr * x[i].re - pi * x[i].im + c[k];
+            pi = pr * x[i].im + pi * x[i].re;
+            pr = tr;
+         }
+         if (pr == 0.0 && pi == 0.0)
+            continue;
+         den = dr * dr + di * di;
+         if (den == 0.0)
+            return (-1);
+         nr = (pr * dr + pi * di) / den;        /* N = p / p' */
+         ni = (pi * dr - pr * di) / den;
+
+         sr = si = 0.0;         /* S = sum 1 / (x_i - x_j) */
+         for (j = 1; j <= odr; j++) {
+            if (j == i)
+               continue;
+            tr = x[i].re - x[j].re;
+            ti = x[i].im - x[j].im;
+            den = tr * tr + ti * ti;
+            if (den == 0.0)
+               return (-1);
+            sr += tr / den;
+            si -= ti / den;
+         }
+
+         tr = 1.0 - (nr * sr - ni * si);        /* W = N / (1 - N S) */
+         ti = -(nr * si + ni * sr);
+         den = tr * tr + ti * ti;
+         if (den == 0.0)
+            return (-1);
+         sr = (nr * tr + ni * ti) / den;
+         si = (ni * tr - nr * ti) / den;
+         x[i].re -= sr;
+         x[i].im -= si;
+
+         den = sqrt(sr * sr + si * si);
+         if (den > dmax)
+            dmax = den;
+      }
+      if (dmax <= eps)
+         return (0);
+   }
+
+   return (-1);
+}
+
+static double *monic(double *a, const int odr, const int a_zero)
+{
+   int i;
+   static double *c = NULL;
+   static int size;
+
+   if (c == NULL || odr > size) {
+      if (c != NULL)
+         free(c);
+      c = dgetmem(odr + 1);
+      size = odr;
+   }
+
+   c[0] = 1.0;
+   for (i = 1; i <= odr; i++)
+      c[i] = a_zero ? a[i] : a[i] / a[0];
+
+   return (c);
+}
+
+static int eig(double *a, const int odr, Complex * x, const int a_zero,
+               const double eps, const int itrat)
+{
+   int i, j, n;
+   double *c, *h;
+   static double *buf = NULL;
+   static Complex *z;
+   static int size;
+
+   n = odr;
+   if (n < 1)
+      return (0);
+
+   if (buf == NULL || n > size) {
+      if (buf != NULL) {
+         free(buf);
+         free(z);
+      }
+      buf = dgetmem(n * n);
+      z = cplx_getmem(n + 1);
+      size = n;
+   }
+   h = buf;
+
+   /* companion matrix */
+   c = monic(a, odr, a_zero);
+   fillz(h, sizeof(*h), n * n);
+   for (j = 0; j < n; j++)
+      H(0, j) = -c[j + 1];
+   for (i = 1; i < n; i++)
+      H(i, i - 1) = 1.0;
+
+   balance(h, n);
+   if (hqr(h, n, x + 1, itrat) != 0)
+      return (-1);
+
+   /* polish; the eigenvalues are kept if the iteration fails */
+   movem(x, z, sizeof(*x), n + 1);
+   if (aberth(c, odr, z, eps, 3) == 0)
+      movem(z, x, sizeof(*x), n + 1);
+
+   return (0);
+}
+
+int root_pol_aberth(double *a, const int odr, Complex * x, const int a_zero,
+                    const double eps, const int itrat)
+{
+   int f;
+
+   nitr = 0;
+   f = aberth(monic(a, odr, a_zero), odr, x, eps, itrat);
+   stats_frame(nitr, f != 0);
+
+   return (f);
+}
+
+int root_pol_eig(double *a, const int odr, Complex * x, const int a_zero,
+                 const double eps, const int itrat)
+{
+   int f;
+
+   nitr = 0;
+   f = eig(a, odr, x, a_zero, eps, itrat);
+   stats_frame(nitr, f != 0);
+
+   return (f);
+}
+
+int root_pol_batch(double *a, const int odr, Complex * x, const int nfrm,
+                   const int a_zero, const double eps, const int itrat,
+                   int *flag)
+{
+   int t, f, ret = 0;
+   Complex *xt;
+
+   for (t = 0; t < nfrm; t++, a += odr + 1) {
+      xt = x + t * (odr + 1);
+      nitr = 0;
+      f = -1;
+      if (t > 0) {
+         movem(xt - (odr + 1), xt, sizeof(*xt), odr + 1);
+         f = aberth(monic(a, odr, a_zero), odr, xt, eps, itrat);
+      }
+      if (f != 0)
+         f = eig(a, odr, xt, a_zero, eps, itrat);
+      stats_frame(nitr, f != 0);
+      if (f != 0)
+         ret = -1;
+      if (flag != NULL)
+         flag[t] = f;
+   }
+
+   return (ret);
+}
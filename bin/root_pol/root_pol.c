@@ -59,10 +59,16 @@
 *               -i  : a[0] = 1                       [FALSE]            *
 *               -s  : revert the coefficient         [FALSE]            *
 *               -r  : ( magnitude, arg ) output      [(Real,Imag)]      *
+*               -t  : solver                         [0]                *
+*                       0 (Durand-Kerner-Aberth)                        *
+*                       1 (companion matrix eigenvalues; each frame     *
+*                          warm-started from the previous roots)        *
+*               --stats : write statistics of iterations [FALSE]        *
+*                         to stderr as JSON lines                       *
 *               Pn(x) = a[0]x^n + a[1]x^n-1 + ... + a[n-1]x + a[n]      *
 *      infile:                                                          *
 *               stdin for default                                       *
-*                       a[0],...,a[n]                                   *
+*                       a[0],...,a[n], a[0],...,a[n], ...               *
 *      outfile:                                                         *
 *                       x[0].re, x[1].re,...,x[n-1].re,                 *
 *                       x[0].im, x[1].im,...,x[n-1].im                  *
@@ -96,6 +102,8 @@ static char *rcs_id = "$Id: root_pol.c,v 1.26 2014/12/11 08:30:49 uratec Exp $";
 #define ORDER 32
 #define ITER  1000
 #define EPS   1.0e-14
+#define SOLVER 0
+#define BLOCK 256               /* number of polynomials solved at a time */
 
 /* Command Name */
 char *cmnd;
@@ -116,11 +124,17 @@ int usage(void)
    fprintf(stderr, "       -i  : a[0] = 1                     [FALSE]\n");
    fprintf(stderr, "       -s  : revert the coefficient       [FALSE]\n");
    fprintf(stderr, "       -r  : (magnitude, arg) output      [(Real,Imag)]\n");
+   fprintf(stderr, "       -t  : solver                       [%d]\n", SOLVER);
+   fprintf(stderr, "               0 (Durand-Kerner-Aberth)\n");
+   fprintf(stderr, "               1 (companion matrix eigenvalues, frames\n");
+   fprintf(stderr, "                  warm-started from the previous roots)\n");
+   fprintf(stderr, "       --stats : write statistics of iterations [FALSE]\n");
+   fprintf(stderr, "                 to stderr as JSON lines\n");
    fprintf(stderr, "       -h  : print this message\n");
    fprintf(stderr, "  infile:\n");
-   fprintf(stderr, "       coefficients of polynomial (%s) [stdin]\n", FORMAT);
+   fprintf(stderr, "       coefficients of polynomials (%s) [stdin]\n", FORMAT);
    fprintf(stderr, "  stdout:\n");
-   fprintf(stderr, "       root of polynomial (%s)\n", FORMAT);
+   fprintf(stderr, "       roots of polynomials (%s)\n", FORMAT);
 #ifdef PACKAGE_VERSION
    fprintf(stderr, "\n");
    fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
@@ -134,10 +148,12 @@ int usage(void)
 int main(int argc, char *argv[])
 {
    char *s;
-   int c, k, odr = ORDER, itrat = ITER, form = 0, a_zero = 0;
-   double *a, *d, eps = EPS;
+   int c, n, t, odr = ORDER, itrat = ITER, form = 0, a_zero = 0;
+   int solver = SOLVER, *flag, frame = 0;
+   double *a, eps = EPS;
    FILE *fp = stdin;
-   complex *x;
+   Complex *x;
+   Boolean stats = FA;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -178,6 +194,19 @@ int main(int argc, char *argv[])
             }
             itrat = atoi(s);
             break;
+         case 't':
+            if (*++s == '\0') {
+               s = *++argv;
+               --argc;
+            }
+            solver = atoi(s);
+            break;
+         case '-':
+            if (strcmp(s, "-stats") == 0) {
+               stats = TR;
+               break;
+            }
+            usage();
          default:
             usage();
          }
@@ -185,17 +214,43 @@ int main(int argc, char *argv[])
          fp = getfp(*argv, "rb");
    }
 
-   a = dgetmem(odr + 1);
-   odr = freadf(a, sizeof(*a), odr, fp) - 1;
+   a = dgetmem(BLOCK * (odr + 1));
+   x = cplx_getmem(BLOCK * (odr + 1));
+   flag = (int *) getmem(BLOCK, sizeof(*flag));
 
-   d = dgetmem(odr + 1);
-   x = cplx_getmem(odr + 1);
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
+   n = freadf(a, sizeof(*a), BLOCK * (odr + 1), fp);
+   if (n > 1 && n < odr + 1)    /* a single polynomial of lower order */
+      odr = n - 1;
 
-   for (k = 0; k <= odr; ++k)
-      d[k] = a[k];
+   while ((n /= odr + 1) > 0) {
+      if (solver == 0) {
+         /* root_pol() exits on failure, so write each frame once solved */
+         for (t = 0; t < n; t++) {
+            stats_stage("analysis");
+            root_pol(a + t * (odr + 1), odr, x + t * (odr + 1), a_zero, eps,
+                     itrat);
+            stats_stage("write");
+            output_root_pol(x + t * (odr + 1), odr, form);
+         }
+      } else {
+         stats_stage("analysis");
+         if (root_pol_batch(a, odr, x, n, a_zero, eps, itrat, flag) != 0)
+            for (t = 0; t < n; t++)
+               if (flag[t] != 0)
+                  fprintf(stderr, "%s : No convergence in frame %d!\n", cmnd,
+                          frame + t);
+         stats_stage("write");
+         for (t = 0; t < n; t++)
+            output_root_pol(x + t * (odr + 1), odr, form);
+      }
 
-   root_pol(d, odr, x, a_zero, eps, itrat);
-   output_root_pol(x, odr, form);
+      frame += n;
+      stats_stage("read");
+      n = freadf(a, sizeof(*a), BLOCK * (odr + 1), fp);
+   }
+   stats_close();
 
    return (0);
 }
@@ -130,7 +130,7 @@ static double derivw(const double w, const double a, const double t)
 
 /***************************************************************
 
-  No.1  frqt_a    static : *l, size1
+  No.1  frqt_a    table  : l (warptab)
 
   Frequency Transformation of "al" (second term of dE/dc)
 
@@ -149,28 +149,16 @@ static void frqt_a(double *al, const int m, const int fftsz, const double a,
 {
    int i, j;
    double w, b, *ww, *f, *re, *im, *pf, *pl, *next;
-   int size_l, size_f, fftsz2;
-   static double *l = NULL;
-   static int size1, flag_l = 1;
+   int size_f, fftsz2, isnew;
+   double *l;
 
    b = M_2PI / (double) fftsz;
 
-   size_l = m + 1;
-
-   if (l == NULL) {
-      flag_l = 0;
-      size1 = size_l;
-      l = dgetmem(size1);
-   } else if (size_l != size1) {
-      free(l);
-      flag_l = 0;
-      size1 = size_l;
-      l = dgetmem(size1);
-   }
+   l = warptab(WARP_FRQT_A, 0, m, fftsz, a, t, m + 1, &isnew);
 
    /*-------  if "l" is not defined  ----------*/
 
-   if (flag_l == 0) {
+   if (isnew) {
 
       ww = dgetmem(fftsz);
 
@@ -209,7 +197,6 @@ static void frqt_a(double *al, const int m, const int fftsz, const double a,
       }
 
       free(f);
-      flag_l = 1;
    }
 
    movem(l, al, sizeof(*al), m + 1);
@@ -219,7 +206,7 @@ static void frqt_a(double *al, const int m, const int fftsz, const double a,
 
 /***************************************************************
 
-  No.2  freqt2    static : *g, size2
+  No.2  freqt2    table  : g (warptab)
 
   Frequency Transformation
 
@@ -240,28 +227,16 @@ static void freqt2(double *c1, const int m1, double *c2, const int m2,
 {
    int i, j;
    double w, b, *ww, *dw, *f, *re, *im, *pf, *pg, *next;
-   int size_g, size_f, fftsz2;
-   static double *g = NULL;
-   static int size2, flag_g = 1;
+   int size_f, fftsz2, isnew;
+   double *g;
 
    b = M_2PI / (double) fftsz;
 
-   size_g = (m2 + 1) * (m1 + 1);
-
-   if (g == NULL) {
-      flag_g = 0;
-      size2 = size_g;
-      g = dgetmem(size2);
-   } else if (size_g != size2) {
-      free(g);
-      flag_g = 0;
-      size2 = size_g;
-      g = dgetmem(size2);
-   }
+   g = warptab(WARP_FREQT2, m1, m2, fftsz, a, t, (m2 + 1) * (m1 + 1), &isnew);
 
    /*-------  if "g" is not defined  ----------*/
 
-   if (flag_g == 0) {
+   if (isnew) {
       ww = dgetmem(fftsz);
       dw = dgetmem(fftsz);
 
@@ -308,7 +283,6 @@ static void freqt2(double *c1, const int m1, double *c2, const int m2,
          pf = next;
       }
       free(f);
-      flag_g = 1;
 
       for (j = 1; j <= m1; j++)
          g[j] *= 0.5;
@@ -328,7 +302,7 @@ static void freqt2(double *c1, const int m1, double *c2, const int m2,
 
 /***************************************************************
 
-  No.3  ifreqt2    static : *h, size3
+  No.3  ifreqt2    table  : h (warptab)
 
   Inverse Frequency Transformation
 
@@ -349,28 +323,16 @@ static void ifreqt2(double *c1, int m1, double *c2, int m2, int fftsz, double a,
 {
    int i, j;
    double w, b, *ww, *f, *re, *im, *pl, *pr, *plnxt, *prnxt, *pf, *ph, *next;
-   int size_h, size_f, fftsz2, m12, m11;
-   static double *h = NULL;
-   static int size3, flag_h = 1;
+   int size_f, fftsz2, m12, m11, isnew;
+   double *h;
 
    b = M_2PI / (double) fftsz;
 
-   size_h = (m2 + 1) * (m1 + 1);
-
-   if (h == NULL) {
-      flag_h = 0;
-      size3 = size_h;
-      h = dgetmem(size3);
-   } else if (size_h != size3) {
-      free(h);
-      flag_h = 0;
-      size3 = size_h;
-      h = dgetmem(size3);
-   }
+   h = warptab(WARP_IFREQT2, m1, m2, fftsz, a, t, (m2 + 1) * (m1 + 1), &isnew);
 
    /*-------  if "h" is not defined  ----------*/
 
-   if (flag_h == 0) {
+   if (isnew) {
       ww = dgetmem(fftsz);
 
       for (j = 0, w = 0.0; j < fftsz; j++, w += b)
@@ -432,7 +394,6 @@ static void ifreqt2(double *c1, int m1, double *c2, int m2, int fftsz, double a,
          pf = next;
       }
       free(f);
-      flag_h = 1;
 
       for (j = 1; j <= m1; j++)
          h[j] *= 0.5;
@@ -452,7 +413,7 @@ static void ifreqt2(double *c1, int m1, double *c2, int m2, int fftsz, double a,
 
 /***************************************************************
 
-  No.4  frqtr2    static : *k, size4
+  No.4  frqtr2    table  : k (warptab)
 
   Frequency Transformation for Calculating Coefficients
 
@@ -473,28 +434,16 @@ static void frqtr2(double *c1, int m1, double *c2, int m2, int fftsz, double a,
 {
    int i, j;
    double w, b, *ww, *f, *tc2, *re, *im, *pf, *pk, *next;
-   int size_k, size_f, fftsz2;
-   static double *k = NULL;
-   static int size4, flag_k = 1;
+   int size_f, fftsz2, isnew;
+   double *k;
 
    b = M_2PI / (double) fftsz;
 
-   size_k = (m2 + 1) * (m1 + 1);
-
-   if (k == NULL) {
-      flag_k = 0;
-      size4 = size_k;
-      k = dgetmem(size4);
-   } else if (size_k != size4) {
-      free(k);
-      flag_k = 0;
-      size4 = size_k;
-      k = dgetmem(size4);
-   }
+   k = warptab(WARP_FRQTR2, m1, m2, fftsz, a, t, (m2 + 1) * (m1 + 1), &isnew);
 
    /*-------  if "k" is not defined  ----------*/
 
-   if (flag_k == 0) {
+   if (isnew) {
 
       ww = dgetmem(fftsz);
 
@@ -536,7 +485,6 @@ static void frqtr2(double *c1, int m1, double *c2, int m2, int fftsz, double a,
          pf = next;
       }
       free(f);
-      flag_k = 1;
    }
 
    tc2 = dgetmem(m2 + 1);       /*  tmp of c2  */
@@ -716,12 +664,14 @@ int smcep(double *xw, const int flng, double *mc, const int m, const int fftsz,
 
       if (theq(c, y, d, b, m + 1, f)) {
          fprintf(stderr, "smcep : Error in theq() at %dth iteration!\n", j);
+         stats_frame(j, TR);
          exit(1);
       }
 
       for (i = 0; i <= m; i++)
          mc[i] += d[i];
    }
+   stats_frame((j <= itr2) ? j : itr2, !flag);
 
    if (flag)
       return (0);
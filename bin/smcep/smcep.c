@@ -72,6 +72,8 @@
 *               -E E     :  floor in db calculated per frame  [N/A]     *
 *               -f f     :  mimimum value of the determinant            *
 *                           of the normal matrix             [0.000001] *  
+*               --stats  :  write statistics of iterations    [FALSE]   *
+*                           to stderr as JSON lines                     *
 *      infile:                                                          *
 *              data sequence                                            *
 *                      , x(0), x(1), ..., x(L-1),                       *
@@ -84,7 +86,7 @@
 *              option T is used with option s                           *
 *              value of T must be T <= 1000*s/2                         *
 *      require:                                                         *
-*              smcep()                                                  *
+*              smcep(), stats_open()                                    *
 *                                                                       *
 ************************************************************************/
 
@@ -177,6 +179,8 @@ void usage(int status)
    fprintf(stderr, "       -f f  : mimimum value of the determinant  [%g]\n",
            MINDET);
    fprintf(stderr, "               of the normal matrix\n");
+   fprintf(stderr, "       --stats : write statistics of iterations  [FALSE]\n");
+   fprintf(stderr, "               to stderr as JSON lines\n");
    fprintf(stderr, "  infile:\n");
    fprintf(stderr, "       windowed sequences (%s)    [stdin]\n", FORMAT);
    fprintf(stderr, "  stdout:\n");
@@ -201,6 +205,7 @@ int main(int argc, char **argv)
    int m = ORDER, flng = FLENG, ilng = FLENG, itype = ITYPE, etype = ETYPE,
        fftsz = FFTSZ, itr1 = MINITR, itr2 = MAXITR, flag = 0;
    FILE *fp = stdin;
+   Boolean stats = FA;
    double *mc, *x, a = ALPHA, t = THETA, end = END, e = EPS, f = MINDET, s =
        SAMPLEF, T = EMPHHZ;
 
@@ -269,6 +274,13 @@ int main(int argc, char **argv)
             f = atof(*++argv);
             --argc;
             break;
+         case '-':
+            if (strcmp(*argv, "--stats") == 0) {
+               stats = TR;
+               break;
+            }
+            fprintf(stderr, "%s : invalid option '%s'!\n", cmnd, *argv);
+            usage(1);
          case 'h':
             usage(0);
          default:
@@ -300,14 +312,19 @@ int main(int argc, char **argv)
    x = dgetmem(flng + m + 1);
    mc = x + flng;
 
+   stats_open(cmnd, (stats) ? stderr : NULL);
+   stats_stage("read");
    while (freadf(x, sizeof(*x), ilng, fp) == ilng) {
-
+      stats_stage("analysis");
       flag =
           smcep(x, flng, mc, m, fftsz, a, t, itr1, itr2, end, etype, e, f,
                 itype);
 
+      stats_stage("write");
       fwritef(mc, sizeof(*mc), m + 1, stdout);
+      stats_stage("read");
    }
+   stats_close();
 
    return (0);
 }
@@ -132,6 +132,7 @@ char *cmnd;
 #define MEMSIZE  10
 #define MAGIC    FA
 #define REP      FA
+#define BLOCK    4096           /* number of values processed at a time */
 
 void usage(int status)
 {
@@ -220,8 +221,6 @@ int nopr = 0;
 int mopr = 0;
 int ropr = 0;
 
-static double mem[MEMSIZE];
-
 int main(int argc, char *argv[])
 {
    int magic_count = 0, rep_count = 0;
@@ -426,145 +425,294 @@ int main(int argc, char *argv[])
    return (0);
 }
 
+/* operations decoded once from the option table */
+typedef enum {
+   OP_NOP, OP_MAGIC_RM, OP_MAGIC_RP,
+   OP_MEM_RD, OP_MEM_WR, OP_MEM_ADD, OP_MEM_SUB, OP_MEM_MUL, OP_MEM_DIV,
+   OP_MEM_POW, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_FLOOR, OP_CEIL,
+   OP_ATAN, OP_ABS, OP_CLIP, OP_COS, OP_INV, OP_POW10, OP_POW2, OP_POWX,
+   OP_SQUARE, OP_SQRT, OP_SIN, OP_EXP, OP_LOGX, OP_LOG10, OP_LOG2, OP_LN,
+   OP_FIX, OP_TAN, OP_UNIT
+} Opcode;
+
+static Opcode decode(struct operation *o)
+{
+   if (o->magic)
+      return (o->ifrep ? OP_MAGIC_RP : OP_MAGIC_RM);
+
+   switch (o->op[0]) {
+   case 'r':
+      return (OP_MEM_RD);
+   case 'w':
+      return (OP_MEM_WR);
+   case '+':
+      return (OP_MEM_ADD);
+   case '-':
+      return (OP_MEM_SUB);
+   case '*':
+      return (OP_MEM_MUL);
+   case '/':
+      return (OP_MEM_DIV);
+   case '^':
+      return (OP_MEM_POW);
+   case 'a':
+      return (OP_ADD);
+   case 's':
+      return (OP_SUB);
+   case 'm':
+      return (OP_MUL);
+   case 'd':
+      return (OP_DIV);
+   case 'p':
+      return (OP_POW);
+   case 'f':
+      return (OP_FLOOR);
+   case 'c':
+      return (OP_CEIL);
+   case 'A':
+      return ((o->op[1] == 'T') ? OP_ATAN : OP_ABS);
+   case 'C':
+      return ((o->op[1] == 'L') ? OP_CLIP : OP_COS);
+   case 'I':
+      return (OP_INV);
+   case 'P':
+      if (o->op[1] == 'O' && o->op[3] == '1')
+         return (OP_POW10);
+      else if (o->op[1] == 'O' && o->op[3] == '2')
+         return (OP_POW2);
+      else if (o->op[1] == 'O' && o->op[3] == 'X')
+         return (OP_POWX);
+      return (OP_SQUARE);
+   case 'R':
+      return (OP_SQRT);
+   case 'S':
+      return ((o->op[1] == 'Q') ? OP_SQRT : OP_SIN);
+   case 'E':
+      return (OP_EXP);
+   case 'L':
+      if (o->op[3] == 'X')
+         return (OP_LOGX);
+      else if (o->op[3] == '1')
+         return (OP_LOG10);
+      else if (o->op[3] == '2')
+         return (OP_LOG2);
+      return (OP_LN);
+   case 'F':
+      return (OP_FIX);
+   case 'T':
+      return (OP_TAN);
+   case 'U':
+      return (OP_UNIT);
+   default:
+      return (OP_NOP);
+   }
+}
+
+/* The operation chain is applied one operation at a time to a block of
+   BLOCK values, so that each inner loop is a plain loop over an array.
+   Values removed by -magic are still carried through the loops; they
+   hold the magic number again when -MAGIC restores them (as in the
+   scalar version, a removed value is restored only because it equals
+   the magic number), and are dropped from the output otherwise.  Only
+   writing to memory registers and the warning of -OP_LN depend on them. */
 int sopr(FILE * fp)
 {
-   double x, y;
-   int k, i;
-   Boolean skipflg = FA;
+   double *x, *mem, *m = NULL, y, z;
+   int n, i, j, k, nskip, i2;
+   char *skip;
+   Opcode *code;
 
-   while (freadf(&x, sizeof(x), 1, fp) == 1) {
-      for (k = 0; k < MEMSIZE; ++k)
-         mem[k] = 0;
+   code = (Opcode *) getmem(nopr + 1, sizeof(*code));
+   for (k = 0; k < nopr; k++)
+      code[k] = decode(&optbl[k]);
+
+   x = dgetmem(BLOCK * (MEMSIZE + 1));
+   mem = x + BLOCK;
+   skip = getmem(BLOCK, sizeof(*skip));
+
+   while ((n = freadf(x, sizeof(*x), BLOCK, fp)) > 0) {
+      fillz(mem, sizeof(*mem), BLOCK * MEMSIZE);
+      nskip = 0;
       for (k = 0; k < nopr; ++k) {
          y = optbl[k].d;
-         if (optbl[k].magic) {  /* -magic or -MAGIC */
-            if (optbl[k].ifrep) {       /* -MAGIC */
-               if (x == optbl[mopr].d) {        /* still remains magic number */
-                  x = y;        /* substitute by new magic number */
-                  skipflg = FA;
-               }
-            } else if (x == y) {        /* -magic */
-               skipflg = TR;
-            }
-         } else if (skipflg == FA) {
-            switch (optbl[k].op[0]) {
-            case 'r':
-               x = mem[(int) y];
-               break;
-            case 'w':
-               mem[(int) y] = x;
-               break;
-            case '+':
-               x += mem[(int) y];
-               break;
-            case '-':
-               x -= mem[(int) y];
-               break;
-            case '*':
-               x *= mem[(int) y];
-               break;
-            case '/':
-               x /= mem[(int) y];
-               break;
-            case '^':
-               x = pow(x, mem[(int) y]);
-               break;
-            case 'a':
-               x += y;
-               break;
-            case 's':
-               x -= y;
-               break;
-            case 'm':
-               x *= y;
-               break;
-            case 'd':
-               x /= y;
-               break;
-            case 'p':
-               x = pow(x, y);
-               break;
-            case 'f':
-               x = (x < y) ? y : x;
-               break;
-            case 'c':
-               x = (x > y) ? y : x;
-               break;
-            case 'A':
-               if (optbl[k].op[1] == 'T')
-                  x = atan(x);
-               else if (x < 0)
-                  x = -x;
-               break;
-            case 'C':
-               if (optbl[k].op[1] == 'L') {
-                  if (x < 0)
-                     x = 0;
+         if (code[k] >= OP_MEM_RD && code[k] <= OP_MEM_POW)
+            m = mem + (int) y * BLOCK;
+         switch (code[k]) {
+         case OP_MAGIC_RM:
+            for (i = 0; i < n; i++)
+               if (x[i] == y) {
+                  skip[i] = TR;
+                  nskip++;
                } else
-                  x = cos(x);
-               break;
-            case 'I':
-               x = 1 / x;
-               break;
-            case 'P':
-               if (optbl[k].op[1] == 'O' && optbl[k].op[3] == '1')
-                  x = pow(10.0, x);
-               else if (optbl[k].op[1] == 'O' && optbl[k].op[3] == '2')
-                  x = pow(2.0, x);
-               else if (optbl[k].op[1] == 'O' && optbl[k].op[3] == 'X')
-                  x = pow(y, x);
-               else
-                  x *= x;
-               break;
-            case 'R':
-               x = sqrt(x);
-               break;
-            case 'S':
-               if (optbl[k].op[1] == 'Q')
-                  x = sqrt(x);
-               else
-                  x = sin(x);
-               break;
-            case 'E':
-               x = exp(x);
-               break;
-            case 'L':
-               if (x <= 0)
+                  skip[i] = FA;
+            break;
+         case OP_MAGIC_RP:
+            z = optbl[mopr].d;
+            for (i = 0; i < n; i++)
+               if (x[i] == z || (nskip > 0 && skip[i])) {
+                  x[i] = y;
+                  skip[i] = FA;
+               }
+            nskip = 0;
+            break;
+         case OP_MEM_RD:
+            for (i = 0; i < n; i++)
+               x[i] = m[i];
+            break;
+         case OP_MEM_WR:
+            for (i = 0; i < n; i++)
+               if (nskip == 0 || !skip[i])
+                  m[i] = x[i];
+            break;
+         case OP_MEM_ADD:
+            for (i = 0; i < n; i++)
+               x[i] += m[i];
+            break;
+         case OP_MEM_SUB:
+            for (i = 0; i < n; i++)
+               x[i] -= m[i];
+            break;
+         case OP_MEM_MUL:
+            for (i = 0; i < n; i++)
+               x[i] *= m[i];
+            break;
+         case OP_MEM_DIV:
+            for (i = 0; i < n; i++)
+               x[i] /= m[i];
+            break;
+         case OP_MEM_POW:
+            for (i = 0; i < n; i++)
+               x[i] = pow(x[i], m[i]);
+            break;
+         case OP_ADD:
+            for (i = 0; i < n; i++)
+               x[i] += y;
+            break;
+         case OP_SUB:
+            for (i = 0; i < n; i++)
+               x[i] -= y;
+            break;
+         case OP_MUL:
+            for (i = 0; i < n; i++)
+               x[i] *= y;
+            break;
+         case OP_DIV:
+            for (i = 0; i < n; i++)
+               x[i] /= y;
+            break;
+         case OP_POW:
+            for (i = 0; i < n; i++)
+               x[i] = pow(x[i], y);
+            break;
+         case OP_FLOOR:
+            for (i = 0; i < n; i++)
+               x[i] = (x[i] < y) ? y : x[i];
+            break;
+         case OP_CEIL:
+            for (i = 0; i < n; i++)
+               x[i] = (x[i] > y) ? y : x[i];
+            break;
+         case OP_ATAN:
+            for (i = 0; i < n; i++)
+               x[i] = atan(x[i]);
+            break;
+         case OP_ABS:
+            for (i = 0; i < n; i++)
+               x[i] = (x[i] < 0) ? -x[i] : x[i];
+            break;
+         case OP_CLIP:
+            for (i = 0; i < n; i++)
+               x[i] = (x[i] < 0) ? 0 : x[i];
+            break;
+         case OP_COS:
+            for (i = 0; i < n; i++)
+               x[i] = cos(x[i]);
+            break;
+         case OP_INV:
+            for (i = 0; i < n; i++)
+               x[i] = 1 / x[i];
+            break;
+         case OP_POW10:
+            for (i = 0; i < n; i++)
+               x[i] = pow(10.0, x[i]);
+            break;
+         case OP_POW2:
+            for (i = 0; i < n; i++)
+               x[i] = pow(2.0, x[i]);
+            break;
+         case OP_POWX:
+            for (i = 0; i < n; i++)
+               x[i] = pow(y, x[i]);
+            break;
+         case OP_SQUARE:
+            for (i = 0; i < n; i++)
+               x[i] *= x[i];
+            break;
+         case OP_SQRT:
+            for (i = 0; i < n; i++)
+               x[i] = sqrt(x[i]);
+            break;
+         case OP_SIN:
+            for (i = 0; i < n; i++)
+               x[i] = sin(x[i]);
+            break;
+         case OP_EXP:
+            for (i = 0; i < n; i++)
+               x[i] = exp(x[i]);
+            break;
+         case OP_LOGX:
+         case OP_LOG10:
+         case OP_LOG2:
+         case OP_LN:
+            for (i = 0; i < n; i++)
+               if (x[i] <= 0 && (nskip == 0 || !skip[i]))
                   fprintf(stderr, "WARNING: LOG of zero or negative value !\n");
-               if (optbl[k].op[3] == 'X')
-                  x = log(x) / log(y);
-               else if (optbl[k].op[3] == '1')
-                  x = log10(x);
-               else if (optbl[k].op[3] == '2')
-                  x = LOG2(x);
-               else
-                  x = log(x);
-               break;
-            case 'F':
-               if (x < 0)
-                  i = x - 0.5;
-               else
-                  i = x + 0.5;
-               x = i;
-               break;
-            case 'T':
-               x = tan(x);
-               break;
-            case 'U':
-               if (x < 0)
-                  x = 0;
-               else
-                  x = 1;
-            case 'M':
-
-            default:
-               break;
+            if (code[k] == OP_LOGX) {
+               z = log(y);
+               for (i = 0; i < n; i++)
+                  x[i] = log(x[i]) / z;
+            } else if (code[k] == OP_LOG10) {
+               for (i = 0; i < n; i++)
+                  x[i] = log10(x[i]);
+            } else if (code[k] == OP_LOG2) {
+               for (i = 0; i < n; i++)
+                  x[i] = LOG2(x[i]);
+            } else {
+               for (i = 0; i < n; i++)
+                  x[i] = log(x[i]);
+            }
+            break;
+         case OP_FIX:
+            for (i = 0; i < n; i++) {
+               i2 = (x[i] < 0) ? x[i] - 0.5 : x[i] + 0.5;
+               x[i] = i2;
             }
+            break;
+         case OP_TAN:
+            for (i = 0; i < n; i++)
+               x[i] = tan(x[i]);
+            break;
+         case OP_UNIT:
+            for (i = 0; i < n; i++)
+               x[i] = (x[i] < 0) ? 0 : 1;
+            break;
+         default:
+            break;
          }
       }
-      if (skipflg == FA)
-         fwritef(&x, sizeof(x), 1, stdout);
-      skipflg = FA;
+
+      if (nskip > 0) {
+         for (i = j = 0; i < n; i++)
+            if (!skip[i])
+               x[j++] = x[i];
+         n = j;
+      }
+      fwritef(x, sizeof(*x), n, stdout);
    }
+
+   free(x);
+   free(skip);
+   free(code);
+
    return (0);
 }
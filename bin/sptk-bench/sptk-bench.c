@@ -0,0 +1,1281 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/************************************************************************
+*                                                                       *
+*    Micro-benchmark of the Core Kernels                                *
+*                                                                       *
+*       usage:                                                          *
+*               sptk-bench [ options ] > stdout                         *
+*       options:                                                        *
+*               -k k     :  run only kernels whose name contains k      *
+*                                                               [N/A]   *
+*               -s s     :  minimum time per kernel (sec)       [0.2]   *
+*               -b b     :  baseline file to compare with       [N/A]   *
+*               -w w     :  write results as baseline file      [N/A]   *
+*               -t t     :  tolerance of slow down              [0.1]   *
+*               -B B     :  directory of SPTK commands for      [N/A]   *
+*                           end-to-end kernels                          *
+*               -l       :  list kernels                        [FALSE] *
+*               -a       :  check accuracy of float kernels     [FALSE] *
+*                           instead of timing                           *
+*       stdout:                                                         *
+*               kernel, parameters, ns/op, frames/s, bytes allocated    *
+*               per operation and, with -b, baseline and ratio          *
+*               with -a, deviation of float kernels from double ones    *
+*               (maximum absolute error over maximum absolute value)    *
+*               and its bound                                           *
+*       notes:                                                          *
+*               Every kernel works on fixed pseudo random input, is     *
+*               called once before timing so that tables are built,     *
+*               and is then repeated until s seconds have passed.       *
+*               Sample-by-sample filters count a sample as a frame.     *
+*               dtw, us and ds exist only as commands, so they are      *
+*               timed end-to-end on a temporary file when -B is given.  *
+*               multim-ref and invert-ref are multim() and invert()     *
+*               as they were before mat_gemm() and mat_inv().           *
+*               With -a, cache-crc checks the CRC-32 digests that       *
+*               cache_put() stores against their check values, and      *
+*               its deviation is 1 if they differ.                      *
+*               The exit status is 1 if a kernel is more than t         *
+*               slower than the baseline, a command fails or, with -a,  *
+*               a check exceeds its bound.                              *
+*       require:                                                        *
+*               fft(), fftr(), freqt(), freqt_batch(), mcep(), mgcep(), *
+*               mlsadf(), mglsadf(), lpc(), lpc_batch(), mfcc_init(),   *
+*               mfcc_batch(), vq(), log_outp(), getmem_count(),         *
+*               fftf(), fftrf(), windowf(), lpcf(), mlsadff(),          *
+*               mfcc_batchf(), prepareFloat_GMM(), log_outpf(),         *
+*               mat_gemm(), mat_chol(), mat_spdinv(), multim(),         *
+*               invert(), cache_open(), cache_key(), cache_update(),    *
+*               cache_put()                                             *
+*                                                                       *
+************************************************************************/
+
+/*  Standard C Libraries  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#else
+#  include <strings.h>
+#  ifndef HAVE_STRRCHR
+#     define strrchr rindex
+#  endif
+#endif
+
+#ifndef WIN32
+#  include <unistd.h>
+#  include <sys/types.h>
+#  include <sys/time.h>
+#endif
+
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+/*  Default Values  */
+#define MINTIME 0.2
+#define TOLERANCE 0.1
+#define LIST FA
+#define ACCURACY FA
+#define SEED 1
+
+#define ALPHA 0.42
+#define GAMMA -0.5
+#define STAGE 2
+#define PADEORDER 4
+#define SAMPLEFREQ 16.0
+#define FLENG 512               /* frame length of filter coefficients */
+
+/*  Command Name  */
+char *cmnd;
+char *BOOL[] = { "FALSE", "TRUE" };
+
+/* state of a kernel set up by its setup function */
+typedef struct _Bench {
+   int n;                       /* frame length or size */
+   int m;                       /* order or dimension */
+   int k;                       /* frames per operation or codebook size */
+   int pos;                     /* position in x of sample-by-sample kernels */
+   int status;                  /* exit status of command */
+   double out;                  /* scalar result */
+   double *x;                   /* input */
+   double *y;                   /* work and output */
+   double *c;                   /* coefficients */
+   double *d;                   /* filter memory */
+   float *xf, *yf, *cf, *df;    /* float copies for float kernels */
+   double **px, **py;           /* rows of x and y for invert() */
+   int *flag;
+   char *tool, *opt;            /* command and options of end-to-end kernels */
+   char *cmd;                   /* command line */
+   Boolean hasgmm, hasmfcc;
+   GMM gmm;
+   MFCC mfcc;
+} Bench;
+
+/* entry of kernel table */
+typedef struct _Kernel {
+   char *name;                  /* name in report and baseline */
+   char *param;                 /* parameters shown in report */
+   int n, m, k;                 /* sizes given to setup */
+   int nframe;                  /* frames per operation */
+   void (*setup) (Bench *);
+   void (*run) (Bench *);
+   char *tool;                  /* command and options of end-to-end kernels */
+   char *opt;
+} Kernel;
+
+/* accuracy check of a float kernel against the double one */
+typedef struct _Check {
+   char *name;
+   char *param;
+   double (*check) (void);      /* returns deviation */
+   double bound;
+} Check;
+
+/* directory of commands and temporary input of end-to-end kernels */
+static char *bindir = NULL;
+static char tmpin[512];
+
+static void setup_fft(Bench * b);
+static void setup_frame(Bench * b);
+static void setup_batch(Bench * b);
+static void setup_freqt(Bench * b);
+static void setup_mlsadf(Bench * b);
+static void setup_mglsadf(Bench * b);
+static void setup_mfcc(Bench * b);
+static void setup_vq(Bench * b);
+static void setup_gmm(Bench * b);
+static void setup_cmd(Bench * b);
+static void setup_fftf(Bench * b);
+static void setup_framef(Bench * b);
+static void setup_mlsadff(Bench * b);
+static void setup_mfccf(Bench * b);
+static void setup_gmmf(Bench * b);
+static void setup_mat(Bench * b);
+static void run_fft(Bench * b);
+static void run_fftr(Bench * b);
+static void run_mcep(Bench * b);
+static void run_mgcep(Bench * b);
+static void run_lpc(Bench * b);
+static void run_lpc_batch(Bench * b);
+static void run_freqt(Bench * b);
+static void run_freqt_batch(Bench * b);
+static void run_mlsadf(Bench * b);
+static void run_mglsadf(Bench * b);
+static void run_mfcc(Bench * b);
+static void run_vq(Bench * b);
+static void run_gmm(Bench * b);
+static void run_cmd(Bench * b);
+static void run_fftf(Bench * b);
+static void run_fftrf(Bench * b);
+static void run_lpcf(Bench * b);
+static void run_mlsadff(Bench * b);
+static void run_mfccf(Bench * b);
+static void run_gmmf(Bench * b);
+static void run_gemm(Bench * b);
+static void run_multim(Bench * b);
+static void run_multim_ref(Bench * b);
+static void run_chol(Bench * b);
+static void run_spdinv(Bench * b);
+static void run_invert(Bench * b);
+static void run_invert_ref(Bench * b);
+static void bench_free(Bench * b);
+static double check_fft(void);
+static double check_fftr(void);
+static double check_window(void);
+static double check_lpc(void);
+static double check_mlsadf(void);
+static double check_mfcc(void);
+static double check_gmm(void);
+static double check_cache(void);
+
+static Kernel kernel[] = {
+   {"fft-256", "n=256", 256, 0, 1, 1, setup_fft, run_fft, NULL, NULL},
+   {"fft-1024", "n=1024", 1024, 0, 1, 1, setup_fft, run_fft, NULL, NULL},
+   {"fftr-256", "n=256", 256, 0, 1, 1, setup_fft, run_fftr, NULL, NULL},
+   {"fftr-1024", "n=1024", 1024, 0, 1, 1, setup_fft, run_fftr, NULL, NULL},
+   {"fftf-256", "n=256", 256, 0, 1, 1, setup_fftf, run_fftf, NULL, NULL},
+   {"fftf-1024", "n=1024", 1024, 0, 1, 1, setup_fftf, run_fftf, NULL, NULL},
+   {"fftrf-256", "n=256", 256, 0, 1, 1, setup_fftf, run_fftrf, NULL, NULL},
+   {"fftrf-1024", "n=1024", 1024, 0, 1, 1, setup_fftf, run_fftrf, NULL, NULL},
+   {"freqt", "m1=24 m2=24", 24, 24, 1, 1, setup_freqt, run_freqt, NULL, NULL},
+   {"freqt-long", "m1=24 m2=511", 24, 511, 1, 1, setup_freqt, run_freqt,
+    NULL, NULL},
+   {"freqt-batch", "m1=24 m2=24 k=64", 24, 24, 64, 64, setup_freqt,
+    run_freqt_batch, NULL, NULL},
+   {"mcep", "l=512 m=24", 512, 24, 1, 1, setup_frame, run_mcep, NULL, NULL},
+   {"mgcep", "l=512 m=24 g=-0.5", 512, 24, 1, 1, setup_frame, run_mgcep,
+    NULL, NULL},
+   {"lpc", "l=512 m=20", 512, 20, 1, 1, setup_frame, run_lpc, NULL, NULL},
+   {"lpc-batch", "l=512 m=20 k=64", 512, 20, 64, 64, setup_batch,
+    run_lpc_batch, NULL, NULL},
+   {"lpcf", "l=512 m=20", 512, 20, 1, 1, setup_framef, run_lpcf, NULL, NULL},
+   {"mlsadf", "m=24 p=4", 4096, 24, 1, 1, setup_mlsadf, run_mlsadf, NULL,
+    NULL},
+   {"mlsadff", "m=24 p=4", 4096, 24, 1, 1, setup_mlsadff, run_mlsadff,
+    NULL, NULL},
+   {"mglsadf", "m=24 c=2", 4096, 24, 1, 1, setup_mglsadf, run_mglsadf, NULL,
+    NULL},
+   {"mfcc", "l=400 m=12 n=20", 400, 12, 1, 1, setup_mfcc, run_mfcc, NULL,
+    NULL},
+   {"mfcc-batch", "l=400 m=12 n=20 k=64", 400, 12, 64, 64, setup_mfcc,
+    run_mfcc, NULL, NULL},
+   {"mfccf-batch", "l=400 m=12 n=20 k=64", 400, 12, 64, 64,
+    setup_mfccf, run_mfccf, NULL, NULL},
+   {"vq", "l=25 e=256", 0, 25, 256, 1, setup_vq, run_vq, NULL, NULL},
+   {"gmm", "l=25 m=32", 0, 25, 32, 1, setup_gmm, run_gmm, NULL, NULL},
+   {"gmm-full", "l=25 m=32 full", 0, 25, -32, 1, setup_gmm, run_gmm, NULL,
+    NULL},
+   {"gmmf", "l=25 m=32", 0, 25, 32, 1, setup_gmmf, run_gmmf, NULL, NULL},
+   {"gmmf-full", "l=25 m=32 full", 0, 25, -32, 1, setup_gmmf,
+    run_gmmf, NULL, NULL},
+   {"gemm", "n=128", 128, 0, 1, 1, setup_mat, run_gemm, NULL, NULL},
+   {"multim", "n=128", 128, 0, 1, 1, setup_mat, run_multim, NULL, NULL},
+   {"multim-ref", "n=128", 128, 0, 1, 1, setup_mat, run_multim_ref, NULL,
+    NULL},
+   {"chol", "n=128", 128, 0, 1, 1, setup_mat, run_chol, NULL, NULL},
+   {"spdinv", "n=128", 128, 0, 1, 1, setup_mat, run_spdinv, NULL, NULL},
+   {"invert", "n=128", 128, 0, 1, 1, setup_mat, run_invert, NULL, NULL},
+   {"invert-ref", "n=128", 128, 0, 1, 1, setup_mat, run_invert_ref, NULL,
+    NULL},
+   {"dtw", "m=24 t=200", 0, 24, 200, 200, setup_cmd, run_cmd, "dtw", "-m 24"},
+   {"us", "s=58 t=16000", 16000, 0, 1, 16000, setup_cmd, run_cmd, "us",
+    "-s 58"},
+   {"ds", "s=21 t=16000", 16000, 0, 1, 16000, setup_cmd, run_cmd, "ds",
+    "-s 21"},
+   {NULL, NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL}
+};
+
+static Check check[] = {
+   {"fft", "n=1024", check_fft, 1e-5},
+   {"fftr", "n=1024", check_fftr, 1e-5},
+   {"window", "l=512 blackman", check_window, 1e-6},
+   {"lpc", "l=512 m=20", check_lpc, 1e-3},
+   {"mlsadf", "m=24 p=4 t=4096", check_mlsadf, 1e-4},
+   {"mfcc", "l=400 m=12 n=20 k=64", check_mfcc, 1e-5},
+   {"gmm", "l=25 m=32", check_gmm, 1e-6},
+   {"cache-crc", "\"123456789\"", check_cache, 0.0},
+   {NULL, NULL, NULL, 0.0}
+};
+
+
+void usage(int status)
+{
+   fprintf(stderr, "\n");
+   fprintf(stderr, " %s - micro-benchmark of the core kernels\n", cmnd);
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  usage:\n");
+   fprintf(stderr, "       %s [ options ] > stdout\n", cmnd);
+   fprintf(stderr, "  options:\n");
+   fprintf(stderr,
+           "       -k k  : run only kernels whose name contains k  [N/A]\n");
+   fprintf(stderr,
+           "       -s s  : minimum time per kernel (sec)           [%g]\n",
+           MINTIME);
+   fprintf(stderr,
+           "       -b b  : baseline file to compare with           [N/A]\n");
+   fprintf(stderr,
+           "       -w w  : write results as baseline file          [N/A]\n");
+   fprintf(stderr,
+           "       -t t  : tolerance of slow down                  [%g]\n",
+           TOLERANCE);
+   fprintf(stderr,
+           "       -B B  : directory of SPTK commands for          [N/A]\n");
+   fprintf(stderr, "               end-to-end kernels (dtw, us, ds)\n");
+   fprintf(stderr,
+           "       -l    : list kernels                            [%s]\n",
+           BOOL[LIST]);
+   fprintf(stderr,
+           "       -a    : check accuracy of float kernels         [%s]\n",
+           BOOL[ACCURACY]);
+   fprintf(stderr, "               instead of timing\n");
+   fprintf(stderr, "       -h    : print this message\n");
+   fprintf(stderr, "  stdout:\n");
+   fprintf(stderr,
+           "       kernel, parameters, ns/op, frames/s, bytes allocated per\n");
+   fprintf(stderr,
+           "       operation and, with -b, baseline ns/op and ratio;\n");
+   fprintf(stderr,
+           "       with -a, deviation of float kernels from double ones\n");
+   fprintf(stderr, "  note:\n");
+   fprintf(stderr,
+           "       exit status is 1 if a kernel is slower than the baseline\n");
+   fprintf(stderr,
+           "       by more than t, a command fails or a check exceeds its bound\n");
+#ifdef PACKAGE_VERSION
+   fprintf(stderr, "\n");
+   fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
+#endif
+   fprintf(stderr, "\n");
+   exit(status);
+}
+
+static double now(void)
+{
+#ifndef WIN32
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return ((double) tv.tv_sec + 1e-6 * (double) tv.tv_usec);
+#else
+   return ((double) clock() / CLOCKS_PER_SEC);
+#endif
+}
+
+/* speech-like signal: white noise through a resonance */
+static void voiced(Philox * g, double *x, const int n)
+{
+   int i;
+
+   philox_normal(g, x, n);
+   for (i = 2; i < n; i++)
+      x[i] += 1.3 * x[i - 1] - 0.8 * x[i - 2];
+}
+
+static void frame(Philox * g, double *x, const int n)
+{
+   voiced(g, x, n);
+   window(BLACKMAN, x, n, 1);
+}
+
+static void setup_fft(Bench * b)
+{
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(2 * b->n);
+   b->y = dgetmem(2 * b->n);
+   philox_normal(&g, b->x, 2 * b->n);
+}
+
+static void setup_frame(Bench * b)
+{
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->n);
+   b->c = dgetmem(b->m + 1);
+   frame(&g, b->x, b->n);
+}
+
+static void setup_batch(Bench * b)
+{
+   int i;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->n * b->k);
+   b->c = dgetmem((b->m + 1) * b->k);
+   b->flag = (int *) getmem(b->k, sizeof(*b->flag));
+   for (i = 0; i < b->k; i++)
+      frame(&g, b->x + i * b->n, b->n);
+}
+
+static void setup_freqt(Bench * b)
+{
+   int i, j;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->c = dgetmem((b->n + 1) * b->k);
+   b->y = dgetmem((b->m + 1) * b->k);
+   philox_normal(&g, b->c, (b->n + 1) * b->k);
+   for (j = 0; j < b->k; j++)
+      for (i = 1; i <= b->n; i++)
+         b->c[j * (b->n + 1) + i] /= i;
+}
+
+static void setup_mlsadf(Bench * b)
+{
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->n);
+   b->c = dgetmem(b->m + 1);
+   b->d = dgetmem(3 * (PADEORDER + 1) + PADEORDER * (b->m + 2));
+   frame(&g, b->x, FLENG);
+   mcep(b->x, FLENG, b->c, b->m, ALPHA, 2, 30, 0.001, 0, 0.0, 0.000001, 0);
+   mc2b(b->c, b->c, b->m, ALPHA);
+   philox_normal(&g, b->x, b->n);
+}
+
+static void setup_mglsadf(Bench * b)
+{
+   int i;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->n);
+   b->c = dgetmem(b->m + 1);
+   b->d = dgetmem((b->m + 1) * STAGE);
+   frame(&g, b->x, FLENG);
+   mgcep(b->x, FLENG, b->c, b->m, ALPHA, GAMMA, FLENG - 1, 2, 30, 0.001, 0,
+         0.0, 0.000001, 0);
+   b->c[0] = log(b->c[0]);      /* K, b'r --> filter coefficients */
+   for (i = 1; i <= b->m; i++)
+      b->c[i] *= GAMMA;
+   philox_normal(&g, b->x, b->n);
+}
+
+static void setup_mfcc(Bench * b)
+{
+   int i;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->n * b->k);
+   b->y = dgetmem((b->m + 2) * b->k);
+   for (i = 0; i < b->k; i++)
+      voiced(&g, b->x + i * b->n, b->n);
+   mfcc_init(&b->mfcc, SAMPLEFREQ, 0.97, 1.0, b->n, 512, b->m + 1, 20, 22, FA);
+   b->hasmfcc = TR;
+}
+
+static void setup_vq(Bench * b)
+{
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(b->m);
+   b->c = dgetmem(b->m * b->k);
+   philox_normal(&g, b->x, b->m);
+   philox_normal(&g, b->c, b->m * b->k);
+}
+
+/* k < 0 gives full covariance */
+static void setup_gmm(Bench * b)
+{
+   int i, j, M = abs(b->k), L = b->m;
+   Boolean full = (b->k < 0) ? TR : FA;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(L);
+   philox_normal(&g, b->x, L);
+   alloc_GMM(&b->gmm, M, L, full);
+   b->hasgmm = TR;
+   for (i = 0; i < M; i++) {
+      b->gmm.weight[i] = 1.0 / M;
+      philox_normal(&g, b->gmm.gauss[i].mean, L);
+      for (j = 0; j < L; j++) {
+         if (full)
+            b->gmm.gauss[i].cov[j][j] = 1.0 + 0.1 * j;
+         else
+            b->gmm.gauss[i].var[j] = 1.0 + 0.1 * j;
+      }
+   }
+   if (full)
+      prepareCovInv_GMM(&b->gmm);
+   prepareGconst_GMM(&b->gmm);
+}
+
+/* symmetric positive definite x = G G' / n + I and G in c, n x n */
+static void setup_mat(Bench * b)
+{
+   int i, j, k, n = b->n;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->c = dgetmem(n * n);
+   b->x = dgetmem(n * n);
+   b->y = dgetmem(n * n);
+   b->d = dgetmem(n * n);
+   b->flag = (int *) getmem(n, sizeof(*b->flag));
+   b->px = (double **) getmem(n, sizeof(*b->px));
+   b->py = (double **) getmem(n, sizeof(*b->py));
+   philox_normal(&g, b->c, n * n);
+   for (i = 0; i < n; i++) {
+      for (j = 0; j <= i; j++) {
+         for (k = 0, b->out = 0.0; k < n; k++)
+            b->out += b->c[i * n + k] * b->c[j * n + k];
+         b->x[i * n + j] = b->x[j * n + i] = b->out / n + (i == j);
+      }
+      b->px[i] = b->x + i * n;
+      b->py[i] = b->y + i * n;
+   }
+}
+
+/* write input of command to tmpin: n samples or k vectors of order m */
+static void setup_cmd(Bench * b)
+{
+   int n = (b->n > 0) ? b->n : b->k * (b->m + 1);
+   FILE *fp;
+   Philox g;
+
+   philox_init(&g, SEED);
+   b->x = dgetmem(n);
+   if (b->n > 0)
+      voiced(&g, b->x, n);
+   else
+      philox_normal(&g, b->x, n);
+   fp = getfp(tmpin, "wb");
+   fwritef(b->x, sizeof(*b->x), n, fp);
+   fclose(fp);
+
+   /* dtw takes the same file as reference */
+   b->cmd = getmem(strlen(bindir) + strlen(b->tool) + strlen(b->opt)
+                   + 2 * strlen(tmpin) + 32, sizeof(*b->cmd));
+   sprintf(b->cmd, "%s/%s %s %s%s%s > /dev/null", bindir, b->tool, b->opt,
+           (b->n > 0) ? "" : tmpin, (b->n > 0) ? "" : " ", tmpin);
+}
+
+static void run_fft(Bench * b)
+{
+   movem(b->x, b->y, sizeof(*b->x), 2 * b->n);
+   fft(b->y, b->y + b->n, b->n);
+}
+
+static void run_fftr(Bench * b)
+{
+   movem(b->x, b->y, sizeof(*b->x), 2 * b->n);
+   fftr(b->y, b->y + b->n, b->n);
+}
+
+static void run_mcep(Bench * b)
+{
+   mcep(b->x, b->n, b->c, b->m, ALPHA, 2, 30, 0.001, 0, 0.0, 0.000001, 0);
+}
+
+static void run_mgcep(Bench * b)
+{
+   mgcep(b->x, b->n, b->c, b->m, ALPHA, GAMMA, b->n - 1, 2, 30, 0.001, 0, 0.0,
+         0.000001, 0);
+}
+
+static void run_lpc(Bench * b)
+{
+   lpc(b->x, b->n, b->c, b->m, 0.000001);
+}
+
+static void run_lpc_batch(Bench * b)
+{
+   lpc_batch(b->x, b->n, b->k, b->c, b->m, 0.000001, b->flag);
+}
+
+static void run_freqt(Bench * b)
+{
+   freqt(b->c, b->n, b->y, b->m, ALPHA);
+}
+
+static void run_freqt_batch(Bench * b)
+{
+   freqt_batch(b->c, b->n, b->y, b->m, ALPHA, b->k);
+}
+
+static void run_mlsadf(Bench * b)
+{
+   b->out = mlsadf(b->x[b->pos], b->c, b->m, ALPHA, PADEORDER, b->d);
+   if (++b->pos == b->n)
+      b->pos = 0;
+}
+
+static void run_mglsadf(Bench * b)
+{
+   b->out = mglsadf(b->x[b->pos], b->c, b->m, ALPHA, STAGE, b->d);
+   if (++b->pos == b->n)
+      b->pos = 0;
+}
+
+static void run_mfcc(Bench * b)
+{
+   mfcc_batch(&b->mfcc, b->x, b->k, b->y);
+}
+
+static void run_vq(Bench * b)
+{
+   b->out = vq(b->x, b->c, b->m, b->k);
+}
+
+static void run_gmm(Bench * b)
+{
+   b->out = log_outp(&b->gmm, b->m, b->x);
+}
+
+static void run_cmd(Bench * b)
+{
+   if (system(b->cmd) != 0)
+      b->status = 1;
+}
+
+static void run_gemm(Bench * b)
+{
+   mat_gemm(b->n, b->n, b->n, 1.0, b->x, b->n, b->c, b->n, 0.0, b->y, b->n);
+}
+
+static void run_multim(Bench * b)
+{
+   multim(b->x, b->n, b->n, b->c, b->n, b->n, b->y);
+}
+
+/* multim() before it was based on mat_gemm(), for comparison */
+static void run_multim_ref(Bench * b)
+{
+   int i, j, k, n = b->n;
+   double *wx = b->x, *wy, *a = b->y;
+
+   for (i = 0; i < n; i++) {
+      for (j = 0; j < n; j++) {
+         wy = &b->c[j];
+         *a = 0;
+         for (k = 0; k < n; k++) {
+            *a += *wx * *wy;
+            wx++;
+            wy += n;
+         }
+         wx -= n;
+         a++;
+      }
+      wx += n;
+   }
+}
+
+static void run_chol(Bench * b)
+{
+   movem(b->x, b->y, sizeof(*b->x), b->n * b->n);
+   b->out = mat_chol(b->y, b->n, b->n);
+}
+
+static void run_spdinv(Bench * b)
+{
+   movem(b->x, b->y, sizeof(*b->x), b->n * b->n);
+   mat_spdinv(b->y, b->n, b->n, &b->out);
+}
+
+static void run_invert(Bench * b)
+{
+   b->out = invert(b->px, b->py, b->n);
+}
+
+/* invert() before it was based on mat_inv(), less its allocations */
+static void run_invert_ref(Bench * b)
+{
+   int i, j, k, ii, ik, n = b->n, *swap = b->flag;
+   double *lu = b->d, *work = b->c, **inv = b->py, d, u, det;
+
+   movem(b->x, lu, sizeof(*b->x), n * n);
+
+   for (k = 0; k < n; k++) {
+      swap[k] = k;
+      u = 0.0;
+      for (j = 0; j < n; j++) {
+         d = fabs(lu[k * n + j]);
+         if (d > u)
+            u = d;
+      }
+      work[k] = 1.0 / u;
+   }
+
+   det = 1;
+   for (k = 0, j = 0; k < n; k++) {
+      u = -1;
+      for (i = k; i < n; i++) {
+         ii = swap[i];
+         d = fabs(lu[ii * n + k]) * work[ii];
+         if (d > u) {
+            u = d;
+            j = i;
+         }
+      }
+
+      ik = swap[j];
+      if (j != k) {
+         swap[j] = swap[k];
+         swap[k] = ik;
+         det = -det;
+      }
+
+      u = lu[ik * n + k];
+      det *= u;
+      for (i = k + 1; i < n; i++) {
+         ii = swap[i];
+         d = (lu[ii * n + k] /= u);
+         for (j = k + 1; j < n; j++)
+            lu[ii * n + j] -= d * lu[ik * n + j];
+      }
+   }
+
+   for (k = 0; k < n; k++) {
+      for (i = 0; i < n; i++) {
+         ii = swap[i];
+         d = (ii == k);
+         for (j = 0; j < i; j++)
+            d -= lu[ii * n + j] * inv[j][k];
+         inv[i][k] = d;
+      }
+      for (i = n - 1; i >= 0; i--) {
+         d = inv[i][k];
+         ii = swap[i];
+         for (j = i + 1; j < n; j++)
+            d -= lu[ii * n + j] * inv[j][k];
+         inv[i][k] = d / lu[ii * n + i];
+      }
+   }
+
+   b->out = det;
+}
+
+static float *tofloat(const double *x, const int n)
+{
+   int i;
+   float *y;
+
+   y = fgetmem(n);
+   for (i = 0; i < n; i++)
+      y[i] = x[i];
+
+   return (y);
+}
+
+static void setup_fftf(Bench * b)
+{
+   setup_fft(b);
+   b->xf = tofloat(b->x, 2 * b->n);
+   b->yf = fgetmem(2 * b->n);
+}
+
+static void setup_framef(Bench * b)
+{
+   setup_frame(b);
+   b->xf = tofloat(b->x, b->n);
+   b->cf = fgetmem(b->m + 1);
+}
+
+static void setup_mlsadff(Bench * b)
+{
+   setup_mlsadf(b);
+   b->xf = tofloat(b->x, b->n);
+   b->cf = tofloat(b->c, b->m + 1);
+   b->df = fgetmem(3 * (PADEORDER + 1) + PADEORDER * (b->m + 2));
+}
+
+static void setup_mfccf(Bench * b)
+{
+   setup_mfcc(b);
+   b->xf = tofloat(b->x, b->n * b->k);
+   b->yf = fgetmem((b->m + 2) * b->k);
+}
+
+static void setup_gmmf(Bench * b)
+{
+   setup_gmm(b);
+   prepareFloat_GMM(&b->gmm);
+   b->xf = tofloat(b->x, b->m);
+}
+
+static void run_fftf(Bench * b)
+{
+   movem(b->xf, b->yf, sizeof(*b->xf), 2 * b->n);
+   fftf(b->yf, b->yf + b->n, b->n);
+}
+
+static void run_fftrf(Bench * b)
+{
+   movem(b->xf, b->yf, sizeof(*b->xf), 2 * b->n);
+   fftrf(b->yf, b->yf + b->n, b->n);
+}
+
+static void run_lpcf(Bench * b)
+{
+   lpcf(b->xf, b->n, b->cf, b->m, 0.000001);
+}
+
+static void run_mlsadff(Bench * b)
+{
+   b->out = mlsadff(b->xf[b->pos], b->cf, b->m, ALPHA, PADEORDER, b->df);
+   if (++b->pos == b->n)
+      b->pos = 0;
+}
+
+static void run_mfccf(Bench * b)
+{
+   mfcc_batchf(&b->mfcc, b->xf, b->k, b->yf);
+}
+
+static void run_gmmf(Bench * b)
+{
+   b->out = log_outpf(&b->gmm, b->m, b->xf);
+}
+
+/* maximum absolute error of y over maximum absolute value of x */
+static double deviation(const double *x, const float *y, const int n)
+{
+   int i;
+   double e = 0.0, a = 0.0;
+
+   for (i = 0; i < n; i++) {
+      if (fabs(x[i] - y[i]) > e)
+         e = fabs(x[i] - y[i]);
+      if (fabs(x[i]) > a)
+         a = fabs(x[i]);
+   }
+
+   return ((a > 0.0) ? e / a : e);
+}
+
+static double check_fft(void)
+{
+   double dev;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 1024;
+   setup_fftf(&b);
+   run_fft(&b);
+   run_fftf(&b);
+   dev = deviation(b.y, b.yf, 2 * b.n);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_fftr(void)
+{
+   double dev;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 1024;
+   setup_fftf(&b);
+   run_fftr(&b);
+   run_fftrf(&b);
+   dev = deviation(b.y, b.yf, 2 * b.n);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_window(void)
+{
+   double dev;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 512;
+   setup_fftf(&b);
+   window(BLACKMAN, b.x, b.n, 1);
+   windowf(BLACKMAN, b.xf, b.n, 1);
+   dev = deviation(b.x, b.xf, b.n);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_lpc(void)
+{
+   double dev;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 512;
+   b.m = 20;
+   setup_framef(&b);
+   run_lpc(&b);
+   run_lpcf(&b);
+   dev = deviation(b.c, b.cf, b.m + 1);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_mlsadf(void)
+{
+   int i;
+   double dev, *y;
+   float *yf;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 4096;
+   b.m = 24;
+   setup_mlsadff(&b);
+   y = dgetmem(b.n);
+   yf = fgetmem(b.n);
+   for (i = 0; i < b.n; i++) {
+      b.pos = i;
+      run_mlsadf(&b);
+      y[i] = b.out;
+      b.pos = i;
+      run_mlsadff(&b);
+      yf[i] = b.out;
+   }
+   dev = deviation(y, yf, b.n);
+   free(y);
+   free(yf);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_mfcc(void)
+{
+   double dev;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.n = 400;
+   b.m = 12;
+   b.k = 64;
+   setup_mfccf(&b);
+   run_mfcc(&b);
+   run_mfccf(&b);
+   dev = deviation(b.y, b.yf, (b.m + 2) * b.k);
+   bench_free(&b);
+
+   return (dev);
+}
+
+static double check_gmm(void)
+{
+   int i, j;
+   double dev, y[100];
+   float yf[100];
+   Philox g;
+   Bench b;
+
+   memset(&b, 0, sizeof(b));
+   b.m = 25;
+   b.k = 32;
+   setup_gmmf(&b);
+   philox_init(&g, SEED + 1);
+   for (i = 0; i < 100; i++) {
+      philox_normal(&g, b.x, b.m);
+      for (j = 0; j < b.m; j++)
+         b.xf[j] = b.x[j];
+      run_gmm(&b);
+      y[i] = b.out;
+      run_gmmf(&b);
+      yf[i] = b.out;
+   }
+   dev = deviation(y, yf, 100);
+   bench_free(&b);
+
+   return (dev);
+}
+
+/* digests stored by cache_put() for the input "123456789" must be the
+   check values of CRC-32 and CRC-32C; returns 1 otherwise */
+static double check_cache(void)
+{
+   char line[128], *tmp;
+   unsigned long nin, d1 = 0, d2 = 0;
+   Cache c;
+   FILE *fp;
+
+   tmp = (getenv("TMPDIR") != NULL) ? getenv("TMPDIR") : "/tmp";
+   cache_open(&c, tmp, 0);
+   cache_key(&c, "sptk-bench cache check");
+   cache_update(&c, "123456789", 9);
+   if (cache_put(&c, "", 0) == 0) {
+      if ((fp = fopen(c.path, "rb")) != NULL) {
+         if (fgets(line, sizeof(line), fp) != NULL)
+            sscanf(line, "%*s %*s %lu %lx %lx", &nin, &d1, &d2);
+         fclose(fp);
+      }
+      remove(c.path);
+   }
+   cache_close(&c);
+
+   return ((d1 == 0xcbf43926UL && d2 == 0xe3069283UL) ? 0.0 : 1.0);
+}
+
+static void bench_free(Bench * b)
+{
+   if (b->x != NULL)
+      free(b->x);
+   if (b->y != NULL)
+      free(b->y);
+   if (b->c != NULL)
+      free(b->c);
+   if (b->d != NULL)
+      free(b->d);
+   if (b->flag != NULL)
+      free(b->flag);
+   if (b->cmd != NULL)
+      free(b->cmd);
+   if (b->xf != NULL)
+      free(b->xf);
+   if (b->yf != NULL)
+      free(b->yf);
+   if (b->cf != NULL)
+      free(b->cf);
+   if (b->df != NULL)
+      free(b->df);
+   if (b->px != NULL)
+      free(b->px);
+   if (b->py != NULL)
+      free(b->py);
+   if (b->hasgmm)
+      free_GMM(&b->gmm);
+   if (b->hasmfcc)
+      mfcc_free(&b->mfcc);
+}
+
+/* repeat run until tmin seconds have passed, return ns/op */
+static double measure(Kernel * k, Bench * b, const double tmin, double *alloc)
+{
+   long i, nop;
+   double t, b0, b1;
+
+   k->run(b);
+   for (nop = 1;; nop *= 2) {
+      getmem_count(&b0);
+      t = now();
+      for (i = 0; i < nop; i++)
+         k->run(b);
+      t = now() - t;
+      getmem_count(&b1);
+      if (t >= tmin || b->status != 0)
+         break;
+   }
+   *alloc = (b1 - b0) / nop;
+
+   return (1e9 * t / nop);
+}
+
+/* read "name ns/op" lines of baseline file, -1 for missing kernels */
+static void read_baseline(char *file, double *base, const int nkernel)
+{
+   char name[256];
+   double ns;
+   int i, c;
+   FILE *fp;
+
+   fp = getfp(file, "r");
+   for (i = 0; i < nkernel; i++)
+      base[i] = -1.0;
+   for (;;) {
+      if ((c = getc(fp)) == EOF)
+         break;
+      if (c == '#' || c == '\n' || ungetc(c, fp) == EOF
+          || fscanf(fp, "%255s %lf", name, &ns) != 2) {
+         while (c != '\n' && c != EOF)
+            c = getc(fp);
+         continue;
+      }
+      for (i = 0; i < nkernel; i++)
+         if (strcmp(kernel[i].name, name) == 0)
+            base[i] = ns;
+   }
+   fclose(fp);
+}
+
+int main(int argc, char **argv)
+{
+   char *sel = NULL, *fbase = NULL, *fout = NULL;
+   int i, nkernel, nrun = 0, nslow = 0, nfail = 0;
+   double tmin = MINTIME, tol = TOLERANCE, ns, alloc, *base = NULL, ratio;
+   Boolean list = LIST, accuracy = ACCURACY;
+   Bench b;
+   FILE *fpw = NULL;
+
+   if ((cmnd = strrchr(argv[0], '/')) == NULL)
+      cmnd = argv[0];
+   else
+      cmnd++;
+
+   while (--argc)
+      if (**++argv == '-') {
+         switch (*(*argv + 1)) {
+         case 'k':
+            sel = *++argv;
+            --argc;
+            break;
+         case 's':
+            tmin = atof(*++argv);
+            --argc;
+            break;
+         case 'b':
+            fbase = *++argv;
+            --argc;
+            break;
+         case 'w':
+            fout = *++argv;
+            --argc;
+            break;
+         case 't':
+            tol = atof(*++argv);
+            --argc;
+            break;
+         case 'B':
+            bindir = *++argv;
+            --argc;
+            break;
+         case 'l':
+            list = 1 - list;
+            break;
+         case 'a':
+            accuracy = 1 - accuracy;
+            break;
+         case 'h':
+            usage(0);
+         default:
+            fprintf(stderr, "%s : Invalid option '%c'!\n", cmnd, *(*argv + 1));
+            usage(1);
+         }
+      } else {
+         fprintf(stderr, "%s : Invalid argument '%s'!\n", cmnd, *argv);
+         usage(1);
+      }
+
+   for (nkernel = 0; kernel[nkernel].name != NULL; nkernel++);
+
+   if (list) {
+      for (i = 0; i < nkernel; i++)
+         printf("%-12s %s%s\n", kernel[i].name, kernel[i].param,
+                (kernel[i].tool != NULL) ? " (command)" : "");
+      return (0);
+   }
+
+   if (accuracy) {
+      printf("# %-10s %-24s %12s %12s\n", "kernel", "parameters",
+             "deviation", "bound");
+      for (i = 0; check[i].name != NULL; i++) {
+         if (sel != NULL && strstr(check[i].name, sel) == NULL)
+            continue;
+         ns = check[i].check();
+         printf("%-12s %-24s %12.3e %12.1e%s\n", check[i].name, check[i].param,
+                ns, check[i].bound, (ns > check[i].bound) ? "  EXCEEDED" : "");
+         if (ns > check[i].bound)
+            nfail++;
+      }
+      return ((nfail > 0) ? 1 : 0);
+   }
+
+   if (fbase != NULL) {
+      base = dgetmem(nkernel);
+      read_baseline(fbase, base, nkernel);
+   }
+   if (fout != NULL) {
+      fpw = getfp(fout, "w");
+      fprintf(fpw, "# %s baseline: kernel ns/op\n", cmnd);
+   }
+#ifndef WIN32
+   if (bindir != NULL)
+      sprintf(tmpin, "%.400s/sptk-bench.%ld",
+              (getenv("TMPDIR") != NULL) ? getenv("TMPDIR") : "/tmp",
+              (long) getpid());
+#else
+   bindir = NULL;
+#endif
+
+   printf("# simd level: %s\n", simd_level());
+   printf("# %-10s %-20s %12s %12s %10s", "kernel", "parameters", "ns/op",
+          "frames/s", "alloc/op");
+   if (base != NULL)
+      printf(" %12s %7s", "baseline", "ratio");
+   printf("\n");
+
+   for (i = 0; i < nkernel; i++) {
+      if (sel != NULL && strstr(kernel[i].name, sel) == NULL)
+         continue;
+      if (kernel[i].tool != NULL && bindir == NULL) {
+         printf("%-12s %-20s %12s\n", kernel[i].name, kernel[i].param,
+                "skipped");
+         continue;
+      }
+
+      memset(&b, 0, sizeof(b));
+      b.n = kernel[i].n;
+      b.m = kernel[i].m;
+      b.k = kernel[i].k;
+      b.tool = kernel[i].tool;
+      b.opt = kernel[i].opt;
+      kernel[i].setup(&b);
+      ns = measure(&kernel[i], &b, tmin, &alloc);
+      nrun++;
+
+      if (b.status != 0) {
+         fprintf(stderr, "%s : Command '%s' failed!\n", cmnd, b.cmd);
+         printf("%-12s %-20s %12s\n", kernel[i].name, kernel[i].param,
+                "failed");
+         nfail++;
+         bench_free(&b);
+         continue;
+      }
+
+      printf("%-12s %-20s %12.1f %12.1f", kernel[i].name, kernel[i].param,
+             ns, 1e9 * kernel[i].nframe / ns);
+      if (kernel[i].tool != NULL)
+         printf(" %10s", "-");  /* allocated in another process */
+      else
+         printf(" %10.0f", alloc);
+      if (base != NULL) {
+         if (base[i] > 0.0) {
+            ratio = ns / base[i];
+            printf(" %12.1f %7.3f%s", base[i], ratio,
+                   (ratio > 1.0 + tol) ? "  SLOWER" : "");
+            if (ratio > 1.0 + tol)
+               nslow++;
+         } else
+            printf(" %12s", "-");
+      }
+      printf("\n");
+      fflush(stdout);
+
+      if (fpw != NULL)
+         fprintf(fpw, "%s %.1f\n", kernel[i].name, ns);
+
+      bench_free(&b);
+   }
+
+#ifndef WIN32
+   if (bindir != NULL)
+      remove(tmpin);
+#endif
+   if (fpw != NULL)
+      fclose(fpw);
+   if (base != NULL && nslow > 0)
+      fprintf(stderr, "%s : %d of %d kernels are slower than baseline "
+              "by more than %g%%!\n", cmnd, nslow, nrun, 100.0 * tol);
+
+   return ((nslow > 0 || nfail > 0) ? 1 : 0);
+}
@@ -0,0 +1,200 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Short-Time Fourier Analysis
+
+    int  stft_init(s, leng, fprd, fftl, type, nflg, noctr)
+    int  stft_nframes(s, n)
+    void stft_frame(s, x, otype, eps, y)
+    int  stft(s, x, n, otype, eps, y)
+    void stft_free(s)
+
+    STFT    *s    : analyzer
+    int     leng  : frame length
+    int     fprd  : frame period
+    int     fftl  : FFT length (power of 2, fftl >= leng)
+    Window  type  : window type
+    int     nflg  : normalizing flag of window (see window())
+    Boolean noctr : no center start point (see frame)
+    double  *x    : input (stft_frame: leng samples, stft: n samples)
+    int     otype : output type
+                      0 (20 * log|X(z)|)
+                      1 (ln|X(z)|)
+                      2 (|X(z)|)
+                      3 (|X(z)|^2)
+                      4 (windowed and zero-padded frame)
+    double  eps   : small value added to |X(z)|^2 for types 0 and 1
+    double  *y    : output (STFT_OUTLEN(s, otype) per frame)
+
+    return value of stft_init : 0 -> normally completed
+                               -1 -> invalid FFT length
+    return value of stft      : number of frames
+
+    Framing, windowing, zero-padding, FFT and the spectral
+    conversion are done in one pass on buffers of FFT length.
+    The window table is computed once in stft_init().  stft()
+    places frames as 'frame' does: frame k starts at sample
+    k * fprd (- leng / 2 unless noctr), samples outside the input
+    are zero, and the number of frames is that of 'frame'.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+int stft_init(STFT * s, const int leng, const int fprd, const int fftl,
+              const Window type, const int nflg, const Boolean noctr)
+{
+   int m;
+
+   for (m = 2; m < fftl; m *= 2);
+   if (m != fftl || fftl < leng)
+      return (-1);
+
+   s->leng = leng;
+   s->fprd = fprd;
+   s->fftl = fftl;
+   s->center = noctr ? 0 : leng / 2;
+   s->win = dgetmem(leng + 2 * fftl);
+   s->re = s->win + leng;
+   s->im = s->re + fftl;
+   s->gain = window_table(type, s->win, leng, nflg);
+
+   return (0);
+}
+
+int stft_nframes(const STFT * s, const int n)
+{
+   int k;
+
+   if (n <= 0)
+      return (0);
+
+   if (s->leng > s->fprd)
+      return ((n + s->fprd - 1) / s->fprd);
+
+   k = (n + s->center + s->fprd - 1) / s->fprd;
+   return ((k > 1) ? k : 1);
+}
+
+/* frame of x[start .. start + leng - 1] out of x[0 .. n - 1] */
+static void analyze(STFT * s, const double *x, const int n, const int start,
+                   const int otype, const double eps, double *y)
+{
+   int i, i0, i1;
+   const int no = s->fftl / 2 + 1;
+   double *re = (otype == 4) ? y : s->re, *im = s->im, *w = s->win, p;
+
+   i0 = (start < 0) ? -start : 0;
+   i1 = (start + s->leng > n) ? n - start : s->leng;
+   if (i1 < i0)
+      i1 = i0;
+
+   for (i = 0; i < i0; i++)
+      re[i] = 0.0;
+   for (; i < i1; i++)
+      re[i] = x[start + i] * w[i];
+   for (; i < s->fftl; i++)
+      re[i] = 0.0;
+
+   if (otype == 4)
+      return;
+
+   fftr(re, im, s->fftl);
+
+   switch (otype) {
+   case 1:
+      for (i = 0; i < no; i++)
+         y[i] = 0.5 * log(re[i] * re[i] + im[i] * im[i] + eps);
+      break;
+   case 2:
+      for (i = 0; i < no; i++)
+         y[i] = sqrt(re[i] * re[i] + im[i] * im[i]);
+      break;
+   case 3:
+      for (i = 0; i < no; i++)
+         y[i] = re[i] * re[i] + im[i] * im[i];
+      break;
+   default:
+      for (i = 0; i < no; i++) {
+         p = re[i] * re[i] + im[i] * im[i] + eps;
+         y[i] = 10 * log10(p);
+      }
+      break;
+   }
+}
+
+void stft_frame(STFT * s, const double *x, const int otype, const double eps,
+                double *y)
+{
+   analyze(s, x, s->leng, 0, otype, eps, y);
+}
+
+int stft(STFT * s, const double *x, const int n, const int otype,
+         const double eps, double *y)
+{
+   int k, nf;
+   const int ol = STFT_OUTLEN(s, otype);
+
+   nf = stft_nframes(s, n);
+   for (k = 0; k < nf; k++)
+      analyze(s, x, n, k * s->fprd - s->center, otype, eps, y + k * ol);
+
+   return (nf);
+}
+
+void stft_free(STFT * s)
+{
+   free(s->win);
+   s->win = s->re = s->im = NULL;
+}
@@ -0,0 +1,302 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/************************************************************************
+*                                                                       *
+*    Short-Time Fourier Analysis (frame + window + spectrum)            *
+*                                                                       *
+*       usage:                                                          *
+*               stft [ options ] [ infile ] > stdout                    *
+*       options:                                                        *
+*               -l l     :  frame length                [256]           *
+*               -p p     :  frame period                [100]           *
+*               -L L     :  FFT length (power of 2)     [256]           *
+*               -n       :  no center start point       [FALSE]         *
+*               -w w     :  type of window              [0]             *
+*                             0 (Blackman)                              *
+*                             1 (Hamming)                               *
+*                             2 (Hanning)                               *
+*                             3 (Bartlett)                              *
+*                             4 (trapezoid)                             *
+*                             5 (rectangular)                           *
+*               -N N     :  type of normalization       [1]             *
+*                             0 none                                    *
+*                             1 normalize by power                      *
+*                             2 normalize by magnitude                  *
+*               -e e     :  small value added to |X|^2  [0]             *
+*               -o o     :  output format               [0]             *
+*                             0 (20 * log|X(z)|)                        *
+*                             1 (ln|X(z)|)                              *
+*                             2 (|X(z)|)                                *
+*                             3 (|X(z)|^2)                              *
+*                             4 (windowed frame of length L)            *
+*       infile:                                                         *
+*               data sequence                                           *
+*                   , x(0), x(1), ...,                                  *
+*       stdout:                                                         *
+*               spectrum of each frame                                  *
+*                   , s(0), s(1), ..., s(L/2),                          *
+*               or windowed frames (-o 4)                               *
+*                   , w(0)x(t), ..., w(l-1)x(t+l-1), 0, ..., 0,         *
+*       notice:                                                         *
+*               'stft -o 0' is equivalent to                            *
+*                 frame -l l -p p | window -l l -L L | spec -l L        *
+*               and 'stft -o 4' can be fed to mcep, mgcep, etc.         *
+*               with frame length L, without the float conversion       *
+*               between the stages.                                     *
+*                                                                       *
+************************************************************************/
+
+static char *rcs_id = "$Id$";
+
+
+/*  Standard C Libraries  */
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#else
+#  include <strings.h>
+#  ifndef HAVE_STRRCHR
+#     define strrchr rindex
+#  endif
+#endif
+
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+/*  Default Values  */
+#define LENG 256
+#define FPERIOD 100
+#define FFTLENG 256
+#define NOCTR FA
+#define WINTYPE BLACKMAN
+#define NORMFLG 1
+#define EPS 0.0
+#define OTYPE 0
+
+char *BOOL[] = { "FALSE", "TRUE" };
+
+/*  Command Name  */
+char *cmnd;
+
+
+void usage(int status)
+{
+   fprintf(stderr, "\n");
+   fprintf(stderr, " %s - short-time Fourier analysis\n", cmnd);
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  usage:\n");
+   fprintf(stderr, "       %s [ options ] [ infile ] > stdout\n", cmnd);
+   fprintf(stderr, "  options:\n");
+   fprintf(stderr, "       -l l  : frame length               [%d]\n", LENG);
+   fprintf(stderr, "       -p p  : frame period               [%d]\n", FPERIOD);
+   fprintf(stderr, "       -L L  : FFT length (power of 2)    [%d]\n", FFTLENG);
+   fprintf(stderr, "       -n    : no center start point      [%s]\n",
+           BOOL[NOCTR]);
+   fprintf(stderr, "       -w w  : type of window             [%d]\n", WINTYPE);
+   fprintf(stderr, "                 0 (Blackman)\n");
+   fprintf(stderr, "                 1 (Hamming)\n");
+   fprintf(stderr, "                 2 (Hanning)\n");
+   fprintf(stderr, "                 3 (Bartlett)\n");
+   fprintf(stderr, "                 4 (trapezoid)\n");
+   fprintf(stderr, "                 5 (rectangular)\n");
+   fprintf(stderr, "       -N N  : type of normalization      [%d]\n", NORMFLG);
+   fprintf(stderr, "                 0 none\n");
+   fprintf(stderr, "                 1 normalize by power\n");
+   fprintf(stderr, "                 2 normalize by magnitude\n");
+   fprintf(stderr, "       -e e  : small value added to |X|^2 [%g]\n", EPS);
+   fprintf(stderr, "       -o o  : output format              [%d]\n", OTYPE);
+   fprintf(stderr, "                 0 (20 * log|X(z)|)\n");
+   fprintf(stderr, "                 1 (ln|X(z)|)\n");
+   fprintf(stderr, "                 2 (|X(z)|)\n");
+   fprintf(stderr, "                 3 (|X(z)|^2)\n");
+   fprintf(stderr, "                 4 (windowed frame of length L)\n");
+   fprintf(stderr, "       -h    : print this message\n");
+   fprintf(stderr, "  infile:\n");
+   fprintf(stderr, "       data sequence (%s)               [stdin]\n", FORMAT);
+   fprintf(stderr, "  stdout:\n");
+   fprintf(stderr, "       spectra or windowed frames (%s)\n", FORMAT);
+#ifdef PACKAGE_VERSION
+   fprintf(stderr, "\n");
+   fprintf(stderr, " SPTK: version %s\n", PACKAGE_VERSION);
+   fprintf(stderr, " CVS Info: %s", rcs_id);
+#endif
+   fprintf(stderr, "\n");
+   exit(status);
+}
+
+int main(int argc, char **argv)
+{
+   int l = LENG, fprd = FPERIOD, fftl = FFTLENG, nflg = NORMFLG, otype =
+       OTYPE, ns, i, rnum, ts, cs, ol;
+   FILE *fp = stdin;
+   Boolean noctr = NOCTR;
+   Window wintype = WINTYPE;
+   double eps = EPS, *x, *xx, *y, *p1, *p2, *p;
+   char *s, c;
+   STFT st;
+
+   if ((cmnd = strrchr(argv[0], '/')) == NULL)
+      cmnd = argv[0];
+   else
+      cmnd++;
+   while (--argc)
+      if (*(s = *++argv) == '-') {
+         c = *++s;
+         switch (c) {
+         case 'l':
+            l = atoi(*++argv);
+            --argc;
+            break;
+         case 'p':
+            fprd = atoi(*++argv);
+            --argc;
+            break;
+         case 'L':
+            fftl = atoi(*++argv);
+            --argc;
+            break;
+         case 'n':
+            noctr = 1 - noctr;
+            break;
+         case 'w':
+            wintype = (Window) atoi(*++argv);
+            --argc;
+            break;
+         case 'N':
+            nflg = atoi(*++argv);
+            --argc;
+            break;
+         case 'e':
+            eps = atof(*++argv);
+            --argc;
+            break;
+         case 'o':
+            otype = atoi(*++argv);
+            --argc;
+            break;
+         case 'h':
+            usage(0);
+         default:
+            fprintf(stderr, "%s : Invalid option '%c'!\n", cmnd, *(*argv + 1));
+            usage(1);
+         }
+      } else
+         fp = getfp(*argv, "rb");
+
+   if (stft_init(&st, l, fprd, fftl, wintype, nflg, noctr) != 0) {
+      fprintf(stderr,
+              "%s : FFT length must be a power of 2 and not less than frame length!\n",
+              cmnd);
+      usage(1);
+   }
+   ol = STFT_OUTLEN(&st, otype);
+   y = dgetmem(ol);
+
+   /* framing is the same as that of 'frame' */
+   x = dgetmem(l);
+   if (!noctr) {
+      i = (int) ((l + 1) / 2);
+      rnum = freadf(&x[(int) (l / 2)], sizeof(*x), i, fp);
+   } else
+      rnum = freadf(x, sizeof(*x), l, fp);
+   if (rnum == 0)
+      return 0;
+   cs = rnum;
+   stft_frame(&st, x, otype, eps, y);
+   fwritef(y, sizeof(*y), ol, stdout);
+
+   if ((ns = (l - fprd)) > 0) {
+      p = &x[fprd];
+      for (;;) {
+         p1 = x;
+         p2 = p;
+         i = ns;
+         while (i--) {
+            *p1++ = *p2++;
+         }
+         rnum = freadf(p1, sizeof(*p1), fprd, fp);
+         if (rnum < fprd) {
+            ts = fprd - rnum;
+            cs -= ts;
+            while (rnum--)
+               p1++;
+            while (ts--)
+               *p1++ = 0.0;
+         }
+         if (cs <= 0)
+            break;
+         stft_frame(&st, x, otype, eps, y);
+         fwritef(y, sizeof(*y), ol, stdout);
+      }
+   } else {
+      i = -ns;
+      xx = dgetmem(i);
+      for (;;) {
+         if (freadf(xx, sizeof(*xx), i, fp) != i)
+            break;
+         rnum = freadf(x, sizeof(*x), l, fp);
+         if (rnum < l) {
+            if (rnum == 0)
+               break;
+            ts = l - rnum;
+            p1 = x;
+            while (rnum--)
+               p1++;
+            while (ts--)
+               *p1++ = 0.0;
+         }
+         stft_frame(&st, x, otype, eps, y);
+         fwritef(y, sizeof(*y), ol, stdout);
+      }
+   }
+
+   return 0;
+}
@@ -49,13 +49,18 @@
   Transpose a matrix
       transpose(float* buf, int m, int n)
 
-      float* buf : data seqence (Overwrite)
+      float* buf : data seqence
       int      m : number of rows
       int      n : number of columns
 
+  The matrix is transposed into a work buffer by recursive
+  halving of the longer side (cache-oblivious), down to tiles
+  of TILE x TILE elements, and written at once.
+
 ************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #if defined(WIN32)
 #  include "SPTK.h"
@@ -63,14 +68,42 @@
 #  include <SPTK.h>
 #endif
 
+#define TILE 16                 /* side of tiles transposed directly */
+
+/* y[j][i] = x[i][j] for i0 <= i < i1, j0 <= j < j1 */
+static void transpose_rec(const double *x, double *y, const int m,
+                          const int n, const int i0, const int i1,
+                          const int j0, const int j1)
+{
+   int i, j, h;
+
+   if (i1 - i0 <= TILE && j1 - j0 <= TILE) {
+      for (j = j0; j < j1; j++)
+         for (i = i0; i < i1; i++)
+            y[j * m + i] = x[i * n + j];
+   } else if (i1 - i0 >= j1 - j0) {
+      h = (i0 + i1) / 2;
+      transpose_rec(x, y, m, n, i0, h, j0, j1);
+      transpose_rec(x, y, m, n, h, i1, j0, j1);
+   } else {
+      h = (j0 + j1) / 2;
+      transpose_rec(x, y, m, n, i0, i1, j0, h);
+      transpose_rec(x, y, m, n, i0, i1, h, j1);
+   }
+}
+
 void transpose(double *buf, const int m, const int n)
 {
-   int i, j;
+   static double *y = NULL;
+   static int size = 0;
 
-   for (i = 0; i < n; i++) {
-      for (j = 0; j < m; j++) {
-         fwritef(&buf[i + j * n], *buf, 1, stdout);
-      }
+   if (m * n > size) {
+      if (y != NULL)
+         free(y);
+      size = m * n;
+      y = dgetmem(size);
    }
 
+   transpose_rec(buf, y, m, n, 0, m, 0, n);
+   fwritef(y, sizeof(*y), m * n, stdout);
 }
@@ -96,11 +96,6 @@ static char *rcs_id = "$Id: transpose.c,v 1.7 2014/12/11 08:30:50 uratec Exp $";
 /*   Command Name  */
 char *cmnd;
 
-typedef struct _float_list {
-   float *f;
-   struct _float_list *next;
-} float_list;
-
 void usage(void)
 {
    fprintf(stderr, "\n");
@@ -127,12 +122,11 @@ void usage(void)
 
 int main(int argc, char *argv[])
 {
-   int i = 0, m = 0, n = 0, elnum = 0, count = 0;
+   int m = 0, n = 0, elnum = 0;
    char *s, c;
-   double *buf, *dat;
+   double *buf;
    FILE *fp = stdin;
    void transpose(double *, int, int);
-   float_list *top = NULL, *prev = NULL, *cur = NULL;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -170,30 +164,12 @@ int main(int argc, char *argv[])
 
    elnum = m * n;
 
-   top = prev = (float_list *) getmem(1, sizeof(float_list));
-   prev->next = NULL;
-   dat = dgetmem(1);
-   count = 0;
-   while (freadf(dat, sizeof(*dat), 1, fp) == 1) {
-      cur = (float_list *) getmem(1, sizeof(float_list));
-      cur->f = fgetmem(1);
-      cur->f[0] = (float) dat[0];
-      count++;
-      prev->next = cur;
-      cur->next = NULL;
-      prev = cur;
-   }
-
-   if (count < elnum) {
+   buf = dgetmem(elnum);
+   if (freadf(buf, sizeof(*buf), elnum, fp) < elnum) {
       fprintf(stderr, "%s : input data is smaller than defined!!\n", cmnd);
       usage();
    }
 
-   buf = dgetmem(count);
-   for (i = 0, cur = top->next; i < count; i++, cur = cur->next) {
-      buf[i] = (double) cur->f[0];
-   }
-
    transpose(buf, m, n);
 
    return (0);
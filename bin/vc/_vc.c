@@ -73,7 +73,7 @@ int vc(const GMM * gmm, const DELTAWINDOW * window, const size_t total_frame,
        src_vlen_dyn = source_vlen * window->win_size,
        tgt_vlen_dyn = target_vlen * window->win_size;
    int m, l, shift;
-   double max_post_mix = 0.0, logoutp = LZERO, *input = NULL,
+   double max_post_mix = 0.0, logoutp = LZERO, logdet, *input = NULL,
        *src_with_dyn = NULL, *logwgd = NULL,
        **cov_xx_inv = NULL, ***cov_yx_xx = NULL, *gv_weight = NULL,
        ***cond_mean = NULL, ***cond_vari = NULL, **cond_post_mix = NULL;
@@ -120,41 +120,51 @@ int vc(const GMM * gmm, const DELTAWINDOW * window, const size_t total_frame,
       cov_yx_xx[m] = ddgetmem(tgt_vlen_dyn, src_vlen_dyn);
    }
    for (m = 0; m < gmm->nmix; m++) {
-      invert(gmm->gauss[m].cov, cov_xx_inv, src_vlen_dyn);
-      for (i = 0; i < tgt_vlen_dyn; i++) {
+      for (i = 0; i < src_vlen_dyn; i++) {
          for (j = 0; j < src_vlen_dyn; j++) {
-            for (k = 0; k < src_vlen_dyn; k++) {
-               cov_yx_xx[m][i][j] += gmm->gauss[m].cov[src_vlen_dyn + i][k]
-                   * cov_xx_inv[k][j];
-            }
+            cov_xx_inv[i][j] = gmm->gauss[m].cov[i][j];
          }
       }
+      if (mat_spdinv(cov_xx_inv[0], src_vlen_dyn, src_vlen_dyn, NULL) != 0) {
+         invert(gmm->gauss[m].cov, cov_xx_inv, src_vlen_dyn);
+      }
+      mat_gemm(tgt_vlen_dyn, src_vlen_dyn, src_vlen_dyn, 1.0,
+               gmm->gauss[m].cov[src_vlen_dyn], gmm->dim, cov_xx_inv[0],
+               src_vlen_dyn, 0.0, cov_yx_xx[m][0], src_vlen_dyn);
    }
    logwgd = dgetmem(gmm->nmix);
    input = dgetmem(src_vlen_dyn);
+
+   /* marginal distribution of source feature does not depend on frame */
    alloc_GMM(&gmm_xx, gmm->nmix, src_vlen_dyn, gmm->full);
-   for (t = 0; t < total_frame; t++) {
-      for (i = 0; i < src_vlen_dyn; i++) {
-         input[i] = src_with_dyn[t * src_vlen_dyn + i];
-      }
-      for (i = 0; i < (size_t) gmm_xx.nmix; i++) {
-         gmm_xx.weight[i] = gmm->weight[i];
-         for (j = 0; j < (size_t) gmm_xx.dim; j++) {
-            gmm_xx.gauss[i].mean[j] = gmm->gauss[i].mean[j];
-            if (gmm_xx.full) {
-               for (k = 0; k < (size_t) gmm_xx.dim; k++) {
-                  gmm_xx.gauss[i].cov[j][k] = gmm->gauss[i].cov[j][k];
-               }
-            } else {
-               gmm_xx.gauss[i].var[j] = gmm->gauss[i].var[j];
+   for (i = 0; i < (size_t) gmm_xx.nmix; i++) {
+      gmm_xx.weight[i] = gmm->weight[i];
+      for (j = 0; j < (size_t) gmm_xx.dim; j++) {
+         gmm_xx.gauss[i].mean[j] = gmm->gauss[i].mean[j];
+         if (gmm_xx.full) {
+            for (k = 0; k < (size_t) gmm_xx.dim; k++) {
+               gmm_xx.gauss[i].cov[j][k] = gmm->gauss[i].cov[j][k];
+               gmm_xx.gauss[i].inv[j][k] = gmm->gauss[i].cov[j][k];
             }
+         } else {
+            gmm_xx.gauss[i].var[j] = gmm->gauss[i].var[j];
          }
       }
-      for (i = 0; i < (size_t) gmm_xx.nmix; i++) {
+   }
+   for (i = 0; i < (size_t) gmm_xx.nmix; i++) {
+      if (mat_spdinv(gmm_xx.gauss[i].inv[0], src_vlen_dyn, src_vlen_dyn,
+                     &logdet) == 0) {
+         gmm_xx.gauss[i].gconst = src_vlen_dyn * log(M_2PI) + logdet;
+      } else {
          invert(gmm_xx.gauss[i].cov, gmm_xx.gauss[i].inv, src_vlen_dyn);
          gmm_xx.gauss[i].gconst =
              cal_gconstf(gmm_xx.gauss[i].cov, src_vlen_dyn);
       }
+   }
+   for (t = 0; t < total_frame; t++) {
+      for (i = 0; i < src_vlen_dyn; i++) {
+         input[i] = src_with_dyn[t * src_vlen_dyn + i];
+      }
       for (m = 0, logoutp = LZERO; m < gmm->nmix; m++) {
          logwgd[m] = log_wgd(&gmm_xx, m, src_vlen_dyn, input);
          logoutp = log_add(logoutp, logwgd[m]);
@@ -174,15 +184,13 @@ int vc(const GMM * gmm, const DELTAWINDOW * window, const size_t total_frame,
    for (m = 0; m < gmm->nmix; m++) {
       for (i = 0; i < tgt_vlen_dyn; i++) {
          for (j = 0; j < tgt_vlen_dyn; j++) {
-            for (k = 0; k < src_vlen_dyn; k++) {
-               cond_vari[m][i][j] += cov_yx_xx[m][i][k]
-                   * gmm->gauss[m].cov[k][src_vlen_dyn + j];
-            }
             cond_vari[m][i][j] =
-                gmm->gauss[m].cov[src_vlen_dyn + i][src_vlen_dyn + j]
-                - cond_vari[m][i][j];
+                gmm->gauss[m].cov[src_vlen_dyn + i][src_vlen_dyn + j];
          }
       }
+      mat_gemm(tgt_vlen_dyn, tgt_vlen_dyn, src_vlen_dyn, -1.0,
+               cov_yx_xx[m][0], src_vlen_dyn, gmm->gauss[m].cov[0] +
+               src_vlen_dyn, gmm->dim, 1.0, cond_vari[m][0], tgt_vlen_dyn);
    }
 
    /* initialize parameter set of hts_engine */
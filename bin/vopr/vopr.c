@@ -105,6 +105,7 @@ static char *rcs_id = "$Id: vopr.c,v 1.28 2014/12/11 08:30:51 uratec Exp $";
 /*  Default Values  */
 #define LENG 1
 #define INV  FA
+#define BLOCK 4096              /* number of values processed at a time */
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -277,132 +278,135 @@ int main(int argc, char **argv)
    return (0);
 }
 
+/* a[k] = a[k] opr b[k] for k = 0, ..., n-1; returns the index of the
+   first element for which the operation is undefined, or -1 */
+static int vopr_apply(double *a, double *b, const int n)
+{
+   int k, err = -1;
+
+   switch (opr) {
+   case 'a':
+      for (k = 0; k < n; ++k)
+         a[k] += b[k];
+      break;
+   case 's':
+      for (k = 0; k < n; ++k)
+         a[k] -= b[k];
+      break;
+   case 'm':
+      for (k = 0; k < n; ++k)
+         a[k] *= b[k];
+      break;
+   case 'd':
+      for (k = 0; k < n; ++k)
+         a[k] /= b[k];
+      break;
+   case 'A':
+      for (k = 0; k < n; ++k)
+         a[k] = atan2(b[k], a[k]);
+      break;
+   case 'c':                   /* choose smaller one */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] > b[k]) ? b[k] : a[k];
+      break;
+   case 'f':                   /* choose larger one */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] < b[k]) ? b[k] : a[k];
+      break;
+   case 'p':                   /* arithmetic mean */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] + b[k]) / 2;
+      break;
+   case 'P':                   /* geometric mean */
+      for (k = 0; k < n; ++k) {
+         if (a[k] * b[k] < 0.0) {
+            err = k;
+            break;
+         }
+         a[k] = sqrt(a[k] * b[k]);
+      }
+      break;
+   case 'q':                   /* greater than or equal */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] >= b[k]) ? 1.0 : 0.0;
+      break;
+   case 'Q':                   /* greater than */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] > b[k]) ? 1.0 : 0.0;
+      break;
+   case 'r':                   /* less than or equal */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] <= b[k]) ? 1.0 : 0.0;
+      break;
+   case 'R':                   /* less than */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] < b[k]) ? 1.0 : 0.0;
+      break;
+   case 'e':                   /* equal to */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] == b[k]) ? 1.0 : 0.0;
+      break;
+   case 'E':                   /* not equal to */
+      for (k = 0; k < n; ++k)
+         a[k] = (a[k] != b[k]) ? 1.0 : 0.0;
+      break;
+   default:
+      break;
+   }
+
+   return (err);
+}
+
+/* Vectors are processed BLOCK / leng (at least one) at a time.  When a
+   and b come from the same stream they alternate and are separated
+   first; a single b vector read from file1 is applied to every a. */
 int vopr(FILE * fp1, FILE * fp2)
 {
    double *a, *b;
-   int k;
+   int i, n, nv, err, ret = 0;
 
-   a = dgetmem(leng + leng);
-   b = a + leng;
+   nv = (leng < BLOCK) ? BLOCK / leng : 1;
+   a = dgetmem(3 * nv * leng);  /* a holds both a and b when they alternate */
+   b = a + 2 * nv * leng;
 
    if (fp1 != fp2 && leng > 1) {
       if (freadf(b, sizeof(*b), leng, fp2) != leng)
          return (1);
+      for (i = 1; i < nv; i++)
+         movem(b, b + i * leng, sizeof(*b), leng);
    }
-   while (freadf(a, sizeof(*a), leng, fp1) == leng) {
-      if (fp1 == fp2 || leng == 1) {
-         if (freadf(b, sizeof(*b), leng, fp2) != leng)
-            return (1);
-      }
 
-      switch (opr) {
-      case 'a':
-         for (k = 0; k < leng; ++k)
-            a[k] += b[k];
-         break;
-      case 's':
-         for (k = 0; k < leng; ++k)
-            a[k] -= b[k];
-         break;
-      case 'm':
-         for (k = 0; k < leng; ++k)
-            a[k] *= b[k];
-         break;
-      case 'd':
-         for (k = 0; k < leng; ++k)
-            a[k] /= b[k];
-         break;
-      case 'A':
-         for (k = 0; k < leng; ++k)
-            a[k] = atan2(b[k], a[k]);
-         break;
-      case 'c':                /* choose smaller one */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] > b[k]) {
-               a[k] = b[k];
-            }
-         }
-         break;
-      case 'f':                /* choose larger one */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] < b[k]) {
-               a[k] = b[k];
-            }
-         }
-         break;
-      case 'p':                /* arithmetic mean */
-         for (k = 0; k < leng; ++k)
-            a[k] = (a[k] + b[k]) / 2;
-         break;
-      case 'P':                /* geometric mean */
-         for (k = 0; k < leng; ++k) {
-            double tmp = a[k] * b[k];
-            if (tmp < 0.0) {
-               fprintf(stderr, "%s : Can't calculate geometric mean !\n", cmnd);
-               usage(1);
-            }
-            a[k] = sqrt(tmp);
-         }
-         break;
-      case 'q':                /* greater than or equal */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] >= b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
-            }
+   for (;;) {
+      if (fp1 == fp2) {         /* a and b alternate */
+         n = freadf(a, sizeof(*a), 2 * nv * leng, fp1) / (2 * leng);
+         for (i = 0; i < n; i++) {
+            movem(a + (2 * i + 1) * leng, b + i * leng, sizeof(*a), leng);
+            movem(a + 2 * i * leng, a + i * leng, sizeof(*a), leng);
          }
-         break;
-      case 'Q':                /* greater than */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] > b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
-            }
-         }
-         break;
-      case 'r':                /* less than or equal */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] <= b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
-            }
-         }
-         break;
-      case 'R':                /* less than */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] < b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
-            }
-         }
-         break;
-      case 'e':                /* equal to */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] == b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
-            }
-         }
-         break;
-      case 'E':                /* not equal to */
-         for (k = 0; k < leng; ++k) {
-            if (a[k] != b[k]) {
-               a[k] = 1.0;
-            } else {
-               a[k] = 0.0;
+      } else {
+         n = freadf(a, sizeof(*a), nv * leng, fp1) / leng;
+         if (leng == 1) {
+            i = freadf(b, sizeof(*b), n, fp2);
+            if (i < n) {
+               n = i;
+               ret = 1;
             }
          }
-         break;
-      default:
-         break;
       }
+      if (n <= 0)
+         break;
 
-      fwritef(a, sizeof(*a), leng, stdout);
+      if ((err = vopr_apply(a, b, n * leng)) >= 0) {
+         fwritef(a, sizeof(*a), err / leng * leng, stdout);
+         fprintf(stderr, "%s : Can't calculate geometric mean !\n", cmnd);
+         usage(1);
+      }
+      fwritef(a, sizeof(*a), n * leng, stdout);
+      if (n < nv)
+         break;
    }
-   return (0);
+
+   free(a);
+
+   return (ret);
 }
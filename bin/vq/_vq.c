@@ -85,13 +85,5 @@ int vq(double *x, double *cb, const int l, const int cbsize)
 
 double edist(double *x, double *y, const int m)
 {
-   int i;
-   double sub, dist = 0.0;
-
-   for (i = 0; i < m; i++) {
-      sub = x[i] - y[i];
-      dist += sub * sub;
-   }
-
-   return (dist / (double) m);
+   return (simd_dist2(x, y, m) / (double) m);
 }
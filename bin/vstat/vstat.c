@@ -63,6 +63,8 @@
 *                               confidence interval via t-dist.         *
 *                             4 median                                  *
 *               -c c     :  conf. level of conf. interval      [0.95]   *
+*               -e e     :  rank error bound of median         [0.0]    *
+*                           (0.0: exact, other: bounded memory)         *
 *               -d       :  diagonal covariance                [FALSE]  *
 *               -i       :  output inverse cov. instead of cov.[FALSE]  *
 *               -r       :  output correlation instead of cov. [FALSE]  *
@@ -84,6 +86,10 @@
 *              off-diagonal elements are suppressed.                    *
 *              '-d' and '-r' are exclusive                              *
 *              ('-r' has priority over '-d').                           *
+*              moments are accumulated by Welford's method.             *
+*              if '-e' is given, the median is estimated by a quantile  *
+*              sketch whose rank error is at most e * (number of        *
+*              vectors), instead of holding all vectors in memory.      *
 *       require:                                                        *
 *                                                                       *
 ************************************************************************/
@@ -123,6 +129,7 @@ static char *rcs_id = "$Id: vstat.c,v 1.37 2014/12/11 08:30:51 uratec Exp $";
 #define DIAGC   FA
 #define INV     FA
 #define CORR    FA
+#define QEPS    0.0
 
 char *BOOL[] = { "FALSE", "TRUE" };
 
@@ -153,6 +160,9 @@ void usage(int status)
    fprintf(stderr,
            "       -c c   : conf. level of conf. interval (%%)   [%g]\n",
            CONFLEV);
+   fprintf(stderr,
+           "       -e e   : rank error bound of median (0: exact) [%g]\n",
+           QEPS);
    fprintf(stderr, "       -d     : diagonal covariance                 [%s]\n",
            BOOL[DIAGC]);
    fprintf(stderr, "       -i     : output inverse cov. instead of cov. [%s]\n",
@@ -265,49 +275,17 @@ double t_percent(const double p, const int df)
    return (x);
 }
 
-void quicksort(double *x, int left, int right)
-{
-   int i, j;
-   int pivot;
-   int tmp;
-
-   i = left;
-   j = right;
-
-   pivot = x[(left + right) / 2];
-
-   while (1) {
-
-      while (x[i] < pivot)
-         i++;
-
-      while (pivot < x[j])
-         j--;
-      if (i >= j)
-         break;
-
-      tmp = x[i];
-      x[i] = x[j];
-      x[j] = tmp;
-
-      i++;
-      j--;
-   }
-
-   if (left < i - 1)
-      quicksort(x, left, i - 1);
-   if (j + 1 < right)
-      quicksort(x, j + 1, right);
-}
-
 int main(int argc, char *argv[])
 {
    FILE *fp = stdin;
-   double *x, *mean, *med = NULL, **mtmp = NULL, **cov = NULL, **invcov =
-       NULL, *var = NULL, conf = CONFLEV, *upper = NULL, *lower = NULL, t, err;
+   double *x, *mean, *med = NULL, **cov = NULL, **invcov =
+       NULL, *var = NULL, conf = CONFLEV, *upper = NULL, *lower = NULL, t, err,
+       eps = QEPS;
    int leng = LENG, nv = -1, i, j, k = 0, lp = 0, m, outtype = 0, count = 0;
    Boolean outmean = OUTMEAN, outcov = OUTCOV, outconf = OUTCONF,
        outmed = OUTMED, diagc = DIAGC, inv = INV, corr = CORR;
+   Moments mom;
+   QSketch *qs;
 
    if ((cmnd = strrchr(argv[0], '/')) == NULL)
       cmnd = argv[0];
@@ -336,6 +314,10 @@ int main(int argc, char *argv[])
             conf = atof(*++argv);
             --argc;
             break;
+         case 'e':
+            eps = atof(*++argv);
+            --argc;
+            break;
          case 'd':
             diagc = 1 - diagc;
             break;
@@ -388,71 +370,27 @@ int main(int argc, char *argv[])
    x = mean + leng;
 
    if (outmed) {
+      qs = (QSketch *) getmem(leng, sizeof(*qs));
+      med = dgetmem(leng);
+      for (i = 0; i < leng; i++)
+         alloc_QSketch(&qs[i], eps);
 
-      if (nv == -1) {
-         typedef struct _float_list {
-            float *f;
-            struct _float_list *next;
-         } float_list;
-
-         float_list *top = NULL, *prev = NULL, *cur = NULL;
-         top = prev = (float_list *) getmem(1, sizeof(float_list));
-         prev->next = NULL;
-         while (freadf(x, sizeof(*x), leng, fp) == leng) {
-            cur = (float_list *) getmem(1, sizeof(float_list));
-            cur->f = fgetmem(leng);
-            for (i = 0; i < leng; i++) {
-               cur->f[i] = (float) x[i];
-            }
-            count++;
-            prev->next = cur;
-            cur->next = NULL;
-            prev = cur;
-         }
-         k = count;
-
-         mtmp = (double **) getmem(leng, sizeof(*mtmp));
-         mtmp[0] = dgetmem(leng * k);
-         for (i = 1; i < leng; i++)
-            mtmp[i] = mtmp[i - 1] + k;
-
-         med = dgetmem(leng);
-
-         for (j = 0, cur = top->next; j < k; j++, cur = cur->next) {
-            for (i = 0; i < leng; i++) {
-               mtmp[i][j] = (double) cur->f[i];
-            }
-         }
-      } else {
-
-         k = nv;
-
-         mtmp = (double **) getmem(leng, sizeof(*mtmp));
-         mtmp[0] = dgetmem(leng * k);
-         for (i = 1; i < leng; i++)
-            mtmp[i] = mtmp[i - 1] + k;
-
-         med = dgetmem(leng);
-
-         for (j = 0; j < k; j++) {
-            for (i = 0; i < leng; i++) {
-               freadf(&mtmp[i][j], sizeof(**mtmp), 1, fp);
-            }
-         }
+      for (lp = nv; lp; --lp) {
+         if (freadf(x, sizeof(*x), leng, fp) != leng)
+            break;
+         for (i = 0; i < leng; i++)
+            accum_QSketch(&qs[i], x[i]);
+         count++;
       }
 
-      if (k % 2 == 0) {
+      if (count % 2 == 0) {
          fprintf(stderr, "%s : warning: the number of vectors is even!\n",
                  cmnd);
       }
 
       for (i = 0; i < leng; i++) {
-         quicksort(mtmp[i], 0, k - 1);
-         if (k % 2 == 1) {
-            med[i] = mtmp[i][k / 2];
-         } else {
-            med[i] = ((mtmp[i][k / 2] + mtmp[i][k / 2 - 1]) / 2);
-         }
+         med[i] = median_QSketch(&qs[i]);
+         free_QSketch(&qs[i]);
       }
 
       fwritef(med, sizeof(*med), leng, stdout);
@@ -485,37 +423,15 @@ int main(int argc, char *argv[])
 
 
 
+   alloc_Moments(&mom, leng, (outcov && !diagc) ? TR : FA);
+
    while (!feof(fp)) {
-      for (i = 0; i < leng; i++) {
-         mean[i] = 0.0;
-         if (outcov) {
-            if (!diagc)
-               for (j = 0; j < leng; j++)
-                  cov[i][j] = 0.0;
-            else
-               var[i] = 0.0;
-         }
-         if (outconf) {
-            var[i] = 0.0;
-         }
-      }
+      fillz_Moments(&mom);
 
       for (lp = nv; lp;) {
          if (freadf(x, sizeof(*x), leng, fp) != leng)
             break;
-         for (i = 0; i < leng; i++) {
-            mean[i] += x[i];
-            if (outcov) {
-               if (!diagc)
-                  for (j = i; j < leng; j++)
-                     cov[i][j] += x[i] * x[j];
-               else
-                  var[i] += x[i] * x[i];
-            }
-            if (outconf) {
-               var[i] += x[i] * x[i];
-            }
-         }
+         accum_Moments(&mom, x);
          --lp;
       }
 
@@ -525,20 +441,16 @@ int main(int argc, char *argv[])
          else
             k = -lp - 1;
          for (i = 0; i < leng; i++)
-            mean[i] /= k;
+            mean[i] = mom.mean[i];
          if (outcov) {
             if (!diagc)
-               for (i = 0; i < leng; i++)
-                  for (j = i; j < leng; j++)
-                     cov[j][i] = cov[i][j] = cov[i][j] / k - mean[i] * mean[j];
+               cov_Moments(&mom, cov[0]);
             else
-               for (i = 0; i < leng; i++)
-                  var[i] = var[i] / k - mean[i] * mean[i];
+               cov_Moments(&mom, var);
          }
          if (outconf) {
-            for (i = 0; i < leng; i++) {
-               var[i] = (var[i] - k * mean[i] * mean[i]) / (k - 1);
-            }
+            for (i = 0; i < leng; i++)
+               var[i] = mom.m2[mom.full ? i * leng + i : i] / (k - 1);
             t = t_percent(conf / 100, k - 1);
             for (i = 0; i < leng; i++) {
                err = t * sqrt(var[i] / k);
@@ -49,6 +49,8 @@
    ---------------
 
        double  window( name, x, size, pnflg );
+       double  window_table( name, w, size, pnflg );
+       double  windowf( name, xf, size, pnflg );
 
        char *name : window name
 
@@ -64,6 +66,9 @@
                    2 : normalize by magnitude
 
        set windowed value to "*x" and return "normalizing gain".
+       window_table() only sets the window values to "*w", so that
+       callers can keep their own table per type and size.
+       windowf() is window() for float data with a float table.
 *****************************************************************/
 
 #include <stdio.h>
@@ -216,6 +221,70 @@ static double *rectangular(double *w, const int leng)
    return (w);
 }
 
+/************************************************
+   window table
+
+       double  window_table(type, w, size, nflg)
+
+       Window  type : window type
+       double  *w   : window values
+       int     size : window length
+       int     nflg : normalizing flag
+
+       return value : normalizing gain
+************************************************/
+
+double window_table(Window type, double *w, const int size, const int nflg)
+{
+   int i;
+   double g;
+
+   switch (type) {
+   case BLACKMAN:
+      blackman(w, size);
+      break;
+   case HAMMING:
+      hamming(w, size);
+      break;
+   case HANNING:
+      hanning(w, size);
+      break;
+   case BARTLETT:
+      bartlett(w, size);
+      break;
+   case TRAPEZOID:
+      trapezoid(w, size);
+      break;
+   case RECTANGULAR:
+      rectangular(w, size);
+      break;
+   default:
+      fprintf(stderr, "window : Unknown window type %d!\n", (int) type);
+      exit(1);
+   }
+
+   switch (nflg) {
+   case 1:
+      for (i = 0, g = 0.0; i < size; i++)
+         g += w[i] * w[i];
+      g = sqrt(g);
+      for (i = 0; i < size; i++)
+         w[i] /= g;
+      break;
+   case 2:
+      for (i = 0, g = 0.0; i < size; i++)
+         g += w[i];
+      for (i = 0; i < size; i++)
+         w[i] /= g;
+      break;
+   case 0:
+   default:
+      g = 1.0;
+   }
+
+   return (g);
+}
+
 double window(Window type, double *x, const int size, const int nflg)
 {
    int i;
@@ -231,49 +300,41 @@ double window(Window type, double *x, const int size, const int nflg)
          w = dgetmem(size);
       }
 
-      switch (type) {
-      case BLACKMAN:
-         blackman(w, size);
-         break;
-      case HAMMING:
-         hamming(w, size);
-         break;
-      case HANNING:
-         hanning(w, size);
-         break;
-      case BARTLETT:
-         bartlett(w, size);
-         break;
-      case TRAPEZOID:
-         trapezoid(w, size);
-         break;
-      case RECTANGULAR:
-         rectangular(w, size);
-         break;
-      default:
-         fprintf(stderr, "window : Unknown window type %d!\n", (int) type);
-         exit(1);
-      }
+      g = window_table(type, w, size, nflg);
 
-      switch (nflg) {
-      case 1:
-         for (i = 0, g = 0.0; i < size; i++)
-            g += w[i] * w[i];
-         g = sqrt(g);
-         for (i = 0; i < size; i++)
-            w[i] /= g;
-         break;
-      case 2:
-         for (i = 0, g = 0.0; i < size; i++)
-            g += w[i];
-         for (i = 0; i < size; i++)
-            w[i] /= g;
-         break;
-      case 0:
-      default:
-         g = 1.0;
+      ptype = type;
+      psize = size;
+      pnflg = nflg;
+   }
+
+   for (i = 0; i < size; i++)
+      x[i] = x[i] * w[i];
+
+   return (g);
+}
+
+double windowf(Window type, float *x, const int size, const int nflg)
+{
+   int i;
+   static double g, *wd = NULL;
+   static float *w = NULL;
+   static Window ptype = (Window) - 1;
+   static int psize = -1, pnflg = -1;
+
+   if ((type != ptype) || (size != psize) || (nflg != pnflg)) {
+      if (size > psize) {
+         if (w != NULL) {
+            free(w);
+            free(wd);
+         }
+         w = fgetmem(size);
+         wd = dgetmem(size);
       }
 
+      g = window_table(type, wd, size, nflg);
+      for (i = 0; i < size; i++)
+         w[i] = wd[i];
+
       ptype = type;
       psize = size;
       pnflg = nflg;
@@ -112,6 +112,8 @@ static char *rcs_id = "$Id: x2x.c,v 1.47 2014/12/11 08:30:52 uratec Exp $";
 #define FORM_ULLONG "%llu"
 #define FORM_FLOAT  "%g"
 #define FORM_LDBL   "%Lg"
+#define BLOCK      4096         /* number of elements converted at a time */
+#define ABUFSIZE   65536        /* initial size of buffer for ascii input */
 #define INT3_MAX   8388607
 #define INT3_MIN   (-8388608)
 #define UINT3_MAX  16777215
@@ -201,12 +203,194 @@ void usage(int status)
 
 double r = 0.0;
 
+/* block kernels for the common types s, i, f and d: the elements are
+   loaded into doubles (exact for all of these types), checked against
+   the range of the output type as a whole, and stored.  A block that
+   is out of range or involves other types is left to x2x(), which
+   issues the warnings and errors element by element */
+
+static int x2x_kernel(char c)
+{
+   return (c == 's' || c == 'i' || c == 'f' || c == 'd');
+}
+
+static void x2x_load(void *x, char c, double *d, int n)
+{
+   int i;
+   short *xs = (short *) x;
+   int *xi = (int *) x;
+   float *xf = (float *) x;
+   double *xd = (double *) x;
+
+   switch (c) {
+   case 's':
+      for (i = 0; i < n; i++)
+         d[i] = xs[i];
+      break;
+   case 'i':
+      for (i = 0; i < n; i++)
+         d[i] = xi[i];
+      break;
+   case 'f':
+      for (i = 0; i < n; i++)
+         d[i] = xf[i];
+      break;
+   case 'd':
+      for (i = 0; i < n; i++)
+         d[i] = xd[i];
+      break;
+   }
+
+   return;
+}
+
+static int x2x_inrange(double *d, int n, char c)
+{
+   int i;
+   double min = 0.0, max = 0.0;
+
+   for (i = 0; i < n; i++) {
+      if (d[i] < min)
+         min = d[i];
+      if (d[i] > max)
+         max = d[i];
+   }
+
+   switch (c) {
+   case 's':
+      return (min >= SHRT_MIN && max <= SHRT_MAX);
+   case 'i':
+      return (min >= INT_MIN && max <= INT_MAX);
+   case 'f':
+      return (min >= -FLT_MAX && max <= FLT_MAX);
+   default:
+      return (min >= -DBL_MAX && max <= DBL_MAX);
+   }
+}
+
+static void x2x_store(double *d, void *x, char c, int n)
+{
+   int i;
+   short *xs = (short *) x;
+   int *xi = (int *) x;
+   float *xf = (float *) x;
+   double *xd = (double *) x;
+
+   switch (c) {
+   case 's':
+      for (i = 0; i < n; i++)
+         xs[i] = (d[i] > 0) ? d[i] + r : d[i] - r;
+      break;
+   case 'i':
+      for (i = 0; i < n; i++)
+         xi[i] = (d[i] > 0) ? d[i] + r : d[i] - r;
+      break;
+   case 'f':
+      for (i = 0; i < n; i++)
+         xf[i] = d[i];
+      break;
+   case 'd':
+      for (i = 0; i < n; i++)
+         xd[i] = d[i];
+      break;
+   }
+
+   return;
+}
+
+/* convert n elements by the block kernels; 0 if they do not apply */
+static int x2x_block(void *x1, void *x2, char c1, char c2, int n, double *d)
+{
+   if (!x2x_kernel(c1) || !x2x_kernel(c2))
+      return (0);
+   /* x + r must be rounded in long double as x2x() does */
+   if (c1 == 'd' && r != 0.0 && (c2 == 's' || c2 == 'i'))
+      return (0);
+
+   x2x_load(x1, c1, d, n);
+   if (!x2x_inrange(d, n, c2))
+      return (0);
+   x2x_store(d, x2, c2, n);
+
+   return (1);
+}
+
+/* read at most n numbers from ascii stream; *bad is set to 1 if
+   non-numerical data is found */
+static int x2x_aread(FILE * fp, double *d, int n, int *bad)
+{
+   int k = 0, i;
+   size_t m;
+   char *e, *b;
+   static char *buf = NULL;
+   static int size = 0, len = 0, pos = 0, eof = 0;
+
+   if (buf == NULL) {
+      size = ABUFSIZE;
+      buf = getmem(size + 1, sizeof(*buf));
+   }
+   *bad = 0;
+   while (k < n) {
+      while (pos < len && isspace((unsigned char) buf[pos]))
+         pos++;
+      for (i = pos; i < len && !isspace((unsigned char) buf[i]); i++);
+      if (i == len && !eof) {   /* number may continue; read more */
+         memmove(buf, buf + pos, len - pos);
+         len -= pos;
+         pos = 0;
+         if (len == size) {     /* long token; enlarge buffer */
+            b = getmem(2 * size + 1, sizeof(*b));
+            memcpy(b, buf, len);
+            free(buf);
+            buf = b;
+            size *= 2;
+         }
+         m = fread(buf + len, 1, size - len, fp);
+         if (m == 0)
+            eof = 1;
+         len += m;
+         buf[len] = '\0';
+         continue;
+      }
+      if (pos == len)
+         break;
+      d[k] = strtod(buf + pos, &e);
+      if (e == buf + pos) {
+         *bad = 1;
+         break;
+      }
+      pos = e - buf;
+      k++;
+   }
+
+   return (k);
+}
+
+/* print an integer in decimal, same as printf("%d") or printf("%u") */
+static void x2x_aprint(unsigned long u, int neg)
+{
+   char buf[32], *p;
+
+   p = buf + sizeof(buf) - 1;
+   *p = '\0';
+   do {
+      *--p = '0' + u % 10;
+      u /= 10;
+   } while (u != 0);
+   if (neg)
+      *--p = '-';
+   fputs(p, stdout);
+
+   return;
+}
+
 int main(int argc, char **argv)
 {
-   char c1 = 'f', c2 = 'f', *form = NULL;
+   char c1 = 'f', c2 = 'f', *form = NULL, *buf1, *buf2;
    long double x;
+   double *d;
    size_t size1 = 0, size2 = 0;
-   int i = 1, col = COL, n;
+   int i = 1, col = COL, n, k, bad, fast;
    FILE *fp = stdin;
    Boolean round = ROUND, clip = CLIP, form_fix = 0;
    void x2x(void *x1, void *x2, char c1, char c2, int clip);
@@ -483,6 +667,7 @@ int main(int argc, char **argv)
       c2 = c1;
    }
 
+   d = dgetmem(BLOCK);
    if (c1 == 'a') {
       if (c2 == 'a')
          while ((n = fscanf(fp, "%Le", &x)) != EOF) {
@@ -501,7 +686,8 @@ int main(int argc, char **argv)
                        cmnd);
                usage(1);
             }
-      } else
+      } else if (strchr("vlLuU", c2) != NULL)
+         /* may exceed 53 bits; parse in long double as before */
          while ((n = fscanf(fp, "%Le", &x)) != EOF) {
             if (n == 1) {
                x2x(&x, &x, 'v', c2, clip);
@@ -512,50 +698,88 @@ int main(int argc, char **argv)
                        cmnd);
                usage(1);
             }
-         }
+      } else {
+         buf2 = getmem(BLOCK, size2);
+         do {
+            n = x2x_aread(fp, d, BLOCK, &bad);
+            if (x2x_block(d, buf2, 'd', c2, n, d))
+               fwritex(buf2, size2, n, stdout);
+            else
+               for (k = 0; k < n; k++) {
+                  x = d[k];
+                  x2x(&x, &x, 'v', c2, clip);
+                  fwritex(&x, size2, 1, stdout);
+               }
+            if (bad) {
+               fprintf(stderr,
+                       "%s : error : Invalid non-numerical data is input !\n",
+                       cmnd);
+               usage(1);
+            }
+         } while (n == BLOCK);
+      }
    } else {
+      buf1 = getmem(BLOCK, size1);
       if (c2 == 'a') {
-         while (freadx(&x, size1, 1, fp) == 1) {
-            x2x(&x, &x, c1, 'v', clip);
-            switch (c1) {
-            case 'v':
-               printf(form, (long double) x);
-               break;
-            case 'd':
-               printf(form, (double) x);
-               break;
-            case 'f':
-               printf(form, (float) x);
-               break;
-            case 'U':
-               printf(form, (unsigned long long) x);
-               break;
-            case 'u':
-               printf(form, (long long) x);
-               break;
-            case 'S':
-            case 'I':
-            case 'L':
-            case 'C':
-            case 'T':
-               printf(form, (unsigned long) x);
-               break;
-            default:
-               printf(form, (long) x);
-            }
-            if (i == col) {
-               i = 1;
-               printf("\n");
-            } else {
-               i++;
-               printf("\t");
+         fast = (strcmp(form, FORM_LONG) == 0 && strchr("sict", c1) != NULL)
+             || (strcmp(form, FORM_ULONG) == 0 && strchr("SICT", c1) != NULL);
+         while ((n = freadx(buf1, size1, BLOCK, fp)) > 0)
+            for (k = 0; k < n; k++) {
+               memcpy(&x, buf1 + k * size1, size1);
+               x2x(&x, &x, c1, 'v', clip);
+               if (fast) {
+                  if (x < 0)
+                     x2x_aprint((unsigned long) -x, 1);
+                  else
+                     x2x_aprint((unsigned long) x, 0);
+               } else
+                  switch (c1) {
+                  case 'v':
+                     printf(form, (long double) x);
+                     break;
+                  case 'd':
+                     printf(form, (double) x);
+                     break;
+                  case 'f':
+                     printf(form, (float) x);
+                     break;
+                  case 'U':
+                     printf(form, (unsigned long long) x);
+                     break;
+                  case 'u':
+                     printf(form, (long long) x);
+                     break;
+                  case 'S':
+                  case 'I':
+                  case 'L':
+                  case 'C':
+                  case 'T':
+                     printf(form, (unsigned long) x);
+                     break;
+                  default:
+                     printf(form, (long) x);
+                  }
+               if (i == col) {
+                  i = 1;
+                  putchar('\n');
+               } else {
+                  i++;
+                  putchar('\t');
+               }
             }
+      } else {
+         buf2 = getmem(BLOCK, size2);
+         while ((n = freadx(buf1, size1, BLOCK, fp)) > 0) {
+            if (x2x_block(buf1, buf2, c1, c2, n, d))
+               fwritex(buf2, size2, n, stdout);
+            else
+               for (k = 0; k < n; k++) {
+                  memcpy(&x, buf1 + k * size1, size1);
+                  x2x(&x, &x, c1, c2, clip);
+                  fwritex(&x, size2, 1, stdout);
+               }
          }
-      } else
-         while (freadx(&x, size1, 1, fp) == 1) {
-            x2x(&x, &x, c1, c2, clip);
-            fwritex(&x, size2, 1, stdout);
-         }
+      }
    }
 
    return (0);
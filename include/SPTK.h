@@ -104,6 +104,18 @@ typedef enum _Window {
    RECTANGULAR
 } Window;
 
+/* enum for kind of frequency warping table */
+typedef enum _WarpKind {
+   WARP_FREQT,
+   WARP_FRQT_A,
+   WARP_FREQT2,
+   WARP_IFREQT2,
+   WARP_FRQTR2,
+   WARP_C2SP,
+   WARP_MGC2SP,
+   WARP_DCT
+} WarpKind;
+
 /* struct for Complex */
 typedef struct {
    double re;
@@ -126,6 +138,7 @@ typedef struct _GMM {
    Boolean full;
    double *weight;
    Gauss *gauss;
+   float *fparam;               /* float copy for log_outpf() (may be NULL) */
 } GMM;
 
 typedef struct _deltawindow {
@@ -136,6 +149,73 @@ typedef struct _deltawindow {
    double **win_coefficient;
 } DELTAWINDOW;
 
+/* structure for streaming delta */
+typedef struct _deltastream {
+   int leng;                    /* length of vector */
+   int nwin;                    /* number of windows */
+   int maxl;                    /* maximum backward width */
+   int maxr;                    /* maximum forward width */
+   int size;                    /* number of frames in ring buffer */
+   double *ring;                /* ring buffer of input frames */
+   int ntap;                    /* number of nonzero coefficients */
+   int *tap_win;                /* window index of each tap */
+   int *tap_shift;              /* frame shift of each tap */
+   double *tap_coef;            /* coefficient of each tap */
+   long nin;                    /* number of input frames */
+   long nout;                   /* number of output frames */
+} DELTASTREAM;
+
+/* structure for short-time Fourier analysis */
+typedef struct _STFT {
+   int leng;                    /* frame length */
+   int fprd;                    /* frame period */
+   int fftl;                    /* FFT length */
+   int center;                  /* offset of the first frame */
+   double gain;                 /* normalizing gain of window */
+   double *win;                 /* window table */
+   double *re;                  /* FFT buffer (real part) */
+   double *im;                  /* FFT buffer (imaginary part) */
+} STFT;
+
+#define STFT_OUTLEN(s, otype) (((otype) == 4) ? (s)->fftl : (s)->fftl / 2 + 1)
+
+/* structure for MFCC extraction */
+typedef struct _MFCC {
+   int wlng;                    /* frame length */
+   int flng;                    /* FFT length */
+   int m;                       /* number of cepstral coefficients */
+   int n;                       /* number of channels of filter bank */
+   double alpha;                /* pre-emphasis coefficient */
+   double eps;                  /* flooring value of filter bank */
+   int *chan;                   /* channel of each FFT bin */
+   double *wgt;                 /* weight of each FFT bin for chan[k] */
+   double *win;                 /* window (NULL without windowing) */
+   double *dctm;                /* DCT matrix (n x m) */
+   double *lift;                /* liftering weights (m) */
+   double *re;                  /* FFT buffer (real part) */
+   double *im;                  /* FFT buffer (imaginary part) */
+   float *fre;                  /* float buffers of mfcc_batchf() */
+   double *fb;                  /* log filter bank outputs (nfrm x n) */
+   double *dc;                  /* DCT outputs (nfrm x m) */
+   double *c0;                  /* 0th coefficients (nfrm) */
+   double *en;                  /* energies (nfrm) */
+   int size;                    /* number of frames of fb, dc, c0, en */
+} MFCC;
+
+/* structure for in-process pipeline */
+typedef struct _PIPELINE {
+   int nstage;                  /* number of stages */
+   struct _PIPESTAGE *stage;    /* stages */
+   Boolean round;               /* round values between stages to float */
+   char itype;                  /* input type ('x2x' as first stage) */
+   char otype;                  /* output type ('x2x' as last stage) */
+   char *spec;                  /* copy of pipeline description */
+   char *err;                   /* word on which parsing failed */
+   double *out;                 /* output buffer */
+   int nout;                    /* number of values in output buffer */
+   int size;                    /* size of output buffer */
+} PIPELINE;
+
 /* structure for wavsplit and wavjoin */
 typedef struct _wavfile {
    int file_size;               /* file size */
@@ -156,6 +236,70 @@ typedef struct _wavfile {
 
 } Wavfile;
 
+/* structure for streaming mean and covariance */
+typedef struct _Moments {
+   int dim;
+   Boolean full;                /* full or diagonal covariance */
+   double count;                /* number of accumulated vectors */
+   double *mean;
+   double *m2;                  /* sum of squared deviations (lower triangle) */
+   double *delta;               /* work */
+} Moments;
+
+/* structure for quantile sketch */
+typedef struct _QSketch {
+   long cap;                    /* capacity of each level (0: unbounded) */
+   int nlev;                    /* number of levels */
+   int flip;                    /* offset of next compaction */
+   double count;                /* number of accumulated values */
+   long *len;                   /* number of values in each level */
+   long *size;                  /* allocated size of each level */
+   double **buf;                /* values of weight 2^level */
+} QSketch;
+
+/* structure for counter-based random number generator */
+typedef struct _Philox {
+   unsigned long key[2];        /* seed (2 x 32 bit) */
+   unsigned long pos[2];        /* position in the stream (2 x 32 bit) */
+} Philox;
+
+/* structure for registered frequency warping table */
+typedef struct _WarpTable {
+   WarpKind kind;               /* kind of table */
+   int m1;                      /* order of input sequence */
+   int m2;                      /* order of warped sequence */
+   int fftsz;                   /* FFT size used to build table */
+   double a;                    /* all-pass constant */
+   double t;                    /* emphasized frequency */
+   int size;                    /* number of elements */
+   double *mat;                 /* table */
+   struct _WarpTable *next;
+} WarpTable;
+
+/* structure for warm start of iterative cepstral analysis */
+typedef struct _CepWarm {
+   Boolean on;                  /* start from previous solution */
+   int m;                       /* order of previous solution (-1: none) */
+   double *prev;                /* previous solution */
+   int size;                    /* size of prev */
+   Boolean fallback;            /* current frame was restarted */
+} CepWarm;
+
+/* structure for cache of analysis results */
+typedef struct _Cache {
+   char *dir;                   /* directory of entries */
+   long limit;                  /* maximum total size in bytes (0: none) */
+   char *param;                 /* parameters of current key */
+   unsigned long h1, h2;        /* hashes of current key (2 x 32 bit) */
+   unsigned long d1, d2;        /* digest of input bytes (2 x 32 bit) */
+   size_t nin;                  /* number of input bytes of current key */
+   char *path;                  /* entry of current key */
+   char *data;                  /* result of last hit */
+   size_t size;                 /* size of data */
+   long written;                /* bytes stored since last eviction */
+   long nhit, nmiss;            /* number of hits and misses */
+} Cache;
+
 typedef struct _filelist {
    int num;
    char **name;
@@ -163,6 +307,12 @@ typedef struct _filelist {
 
 /* library routines */
 double agexp(double r, double x, double y);
+int cache_open(Cache * c, const char *dir, const long limit);
+void cache_key(Cache * c, const char *param);
+void cache_update(Cache * c, const void *data, const size_t n);
+int cache_get(Cache * c, void **data, size_t * n);
+int cache_put(Cache * c, const void *data, const size_t n);
+void cache_close(Cache * c);
 int cholesky(double *c, double *a, double *b, const int n, double eps);
 int freada(double *p, const int bl, FILE * fp);
 int fwritex(void *ptr, const size_t size, const int nitems, FILE * fp);
@@ -181,6 +331,7 @@ float *fgetmem(const int leng);
 float **ffgetmem(const int leng);
 double **ddgetmem(const int leng1, const int leng2);
 char *getmem(const size_t leng, const size_t size);
+long getmem_count(double *bytes);
 double gexp(const double r, const double x);
 double glog(const double r, const double x);
 int ifftr(double *x, double *y, const int l);
@@ -188,10 +339,52 @@ double invert(double **mat, double **inv, const int n);
 void multim(double x[], const int xx, const int xy, double y[], const int yx,
             const int yy, double a[]);
 void addm(double x[], double y[], const int xx, const int yy, double a[]);
+void mat_gemm(const int m, const int n, const int k, const double alpha,
+              const double *a, const int lda, const double *b, const int ldb,
+              const double beta, double *c, const int ldc);
+int mat_chol(double *a, const int n, const int lda);
+int mat_ldl(double *a, const int n, const int lda, double eps);
+void mat_trsv(const double *l, const int n, const int lda, const int trans,
+              const int unit, double *x);
+int mat_spdinv(double *a, const int n, const int lda, double *ldet);
+int mat_inv(double *a, const int n, const int lda, int *ipiv, double *det);
 void movem(void *a, void *b, const size_t size, const int nitem);
+int alloc_Moments(Moments * s, const int dim, const Boolean full);
+void fillz_Moments(Moments * s);
+void accum_Moments(Moments * s, const double *x);
+void merge_Moments(Moments * s, const Moments * t);
+void cov_Moments(const Moments * s, double *cov);
+void free_Moments(Moments * s);
 int mseq(void);
+int mseq_r(int *x);
+void philox_init(Philox * g, const unsigned long seed);
+void philox_seek(Philox * g, const unsigned long pos);
+void philox_skip(Philox * g, const unsigned long n);
+void philox_uniform(Philox * g, double *p, const int leng);
+void philox_normal(Philox * g, double *p, const int leng);
+int alloc_QSketch(QSketch * s, const double eps);
+void accum_QSketch(QSketch * s, const double x);
+void merge_QSketch(QSketch * s, const QSketch * t);
+double quantile_QSketch(const QSketch * s, const double q);
+double median_QSketch(const QSketch * s);
+void free_QSketch(QSketch * s);
+double simd_dot(const double *x, const double *y, const int n);
+double simd_dist2(const double *x, const double *y, const int n);
+double simd_wdist2(const double *x, const double *y, const double *v,
+                   const int n);
+const char *simd_level(void);
+void stats_open(const char *name, FILE * fp);
+void stats_stage(const char *name);
+void stats_frame(const int iter, const Boolean fail);
+void stats_restart(void);
+void stats_close(void);
+int symeig(double *a, const int n, const int k, double *e_val, double *e_vec);
 int theq(double *t, double *h, double *a, double *b, const int n, double eps);
 int toeplitz(double *t, double *a, double *b, const int n, double eps);
+double *warptab(const WarpKind kind, const int m1, const int m2,
+                const int fftsz, const double a, const double t,
+                const int size, int *isnew);
+void warptab_clear(void);
 
 
 /* tool routines */
@@ -214,6 +407,8 @@ void c2ir(double *c, const int nc, double *h, const int leng);
 void c2ndps(double *c, const int m, double *n, const int l);
 void ic2ir(double *h, const int leng, double *c, const int nc);
 void c2sp(double *c, const int m, double *x, double *y, const int l);
+void c2sp_batch(double *c, const int m, double *x, double *y, const int l,
+                const int nfrm);
 void clip(double *x, const int l, const double min, const double max,
           double *y);
 int dft(double *pReal, double *pImag, const int nDFTLength);
@@ -225,23 +420,37 @@ int dct_based_on_fft(double *pReal, double *pImag, const double *pInReal,
                      const double *pInImag);
 int dct_based_on_dft(double *pReal, double *pImag, const double *pInReal,
                      const double *pInImag);
+void idct(double *in, double *out, const int size, const int m,
+          const Boolean dftmode, const Boolean compmode);
+int delta_init(DELTASTREAM * s, const DELTAWINDOW * window, const int leng);
+int delta_push(DELTASTREAM * s, const double *x, double *y);
+int delta_flush(DELTASTREAM * s, double *y);
+void delta_free(DELTASTREAM * s);
 double df2(const double x, const double sf, const double f0p, const double wbp,
            const double f0z, const double wbz, const int fp, const int fz,
            double *buf, int *bufp);
 double dfs(double x, double *a, int m, double *b, int n, double *buf,
            int *bufp);
 int fft(double *x, double *y, const int m);
+int fftf(float *x, float *y, const int m);
 int fft2(double x[], double y[], const int n);
 void fftcep(double *sp, const int flng, double *c, const int m, int itr,
             double ac);
 int fftr(double *x, double *y, const int m);
+int fftrf(float *x, float *y, const int m);
 int fftr2(double x[], double y[], const int n);
 void freqt(double *c1, const int m1, double *c2, const int m2, const double a);
+void freqt_batch(double *c1, const int m1, double *c2, const int m2,
+                 const double a, const int nfrm);
 void gc2gc(double *c1, const int m1, const double g1, double *c2, const int m2,
            const double g2);
 int gcep(double *xw, const int flng, double *gc, const int m, const double g,
          const int itr1, const int itr2, const double d, const int etype,
          const double e, const double f, const int itype);
+int gcep_warm(double *xw, const int flng, double *gc, const int m,
+              const double g, const int itr1, const int itr2, const double d,
+              const int etype, const double e, const double f,
+              const int itype, CepWarm * w);
 double glsadf(double x, double *c, const int m, const int n, double *d);
 double glsadf1(double x, double *c, const int m, const int n, double *d);
 double glsadft(double x, double *c, const int m, const int n, double *d);
@@ -251,6 +460,7 @@ double cal_gconstf(double **var, const int D);
 double log_wgd(const GMM * gmm, const int m, const int L, const double *dat);
 double log_add(double logx, double logy);
 double log_outp(const GMM * gmm, const int L, const double *dat);
+double log_outpf(const GMM * gmm, const int L, const float *dat);
 void fillz_GMM(GMM * gmm);
 int alloc_GMM(GMM * gmm, const int M, const int L, const Boolean full);
 int load_GMM(GMM * gmm, FILE * fp);
@@ -258,6 +468,7 @@ int save_GMM(const GMM * gmm, FILE * fp);
 int free_GMM(GMM * gmm);
 int prepareCovInv_GMM(GMM * gmm);
 int prepareGconst_GMM(GMM * gmm);
+int prepareFloat_GMM(GMM * gmm);
 int floorWeight_GMM(GMM * gmm, double floor);
 int floorVar_GMM(GMM * gmm, double floor);
 void gnorm(double *c1, double *c2, int m, const double g);
@@ -293,12 +504,22 @@ double lmadf1(double x, double *c, const int m, double *d, const int m1,
               const int m2, const int pd);
 double lmadf1t(double x, double *b, const int pd, double *d);
 int lpc(double *x, const int flng, double *a, const int m, const double f);
+int lpcf(float *x, const int flng, float *a, const int m, const double f);
+int lpc_batch(double *x, const int flng, const int nfrm, double *a,
+              const int m, const double f, int *flag);
 void lpc2c(double *a, int m1, double *c, const int m2);
 int lpc2lsp(double *lpc, double *lsp, const int order, const int numsp,
             const int maxitr, const double eps);
+int lpc2lsp_batch(double *lpc, double *lsp, const int order, const int nfrm,
+                  const int numsp, const int maxitr, const double eps,
+                  int *flag);
 int lpc2par(double *a, double *k, const int m);
 void lsp2lpc(double *lsp, double *a, const int m);
 void lsp2sp(double *lsp, const int m, double *x, const int l, const int gain);
+void lsp2sp_batch(double *lsp, const int m, double *x, const int l,
+                  const int gain, const int nfrm);
+void lsp2sp_warp(double *lsp, const int m, const double *w, double *x,
+                 const int l, const int gain, const int nfrm);
 int lspcheck(double *lsp, const int ord);
 double lspdf_even(double x, double *f, const int m, double *d);
 double lspdf_odd(double x, double *f, const int m, double *d);
@@ -307,6 +528,18 @@ void mc2b(double *mc, double *b, int m, const double a);
 int mcep(double *xw, const int flng, double *mc, const int m, const double a,
          const int itr1, const int itr2, const double dd, const int etype,
          const double e, const double f, const int itype);
+void cepwarm_init(CepWarm * w, const Boolean on);
+void cepwarm_free(CepWarm * w);
+int cepwarm_ready(CepWarm * w, const int m);
+int cepwarm_valid(const double *c, const int m);
+void cepwarm_done(CepWarm * w, const double *c, const int m);
+int mfcc_init(MFCC * s, const double sampleFreq, const double alpha,
+              const double eps, const int wlng, const int flng, const int m,
+              const int n, const int ceplift, const Boolean usehamming);
+void mfcc_batch(MFCC * s, const double *in, const int nfrm, double *mc);
+void mfcc_batchf(MFCC * s, const float *in, const int nfrm, float *mc);
+void mfcc_logmel(MFCC * s, const double *in, const int nfrm, double *fb);
+void mfcc_free(MFCC * s);
 void mfcc(double *in, double *mc, const double sampleFreq, const double alpha,
           const double eps, const int wlng, const int flng, const int m,
           const int n, const int ceplift, const Boolean dftmode,
@@ -316,12 +549,20 @@ void mgc2mgc(double *c1, const int m1, const double a1, const double g1,
              double *c2, const int m2, const double a2, const double g2);
 void mgc2sp(double *mgc, const int m, const double a, const double g, double *x,
             double *y, const int flng);
+void mgc2sp_batch(double *mgc, const int m, const double a, const double g,
+                  double *x, double *y, const int flng, const int nfrm);
 void mgclsp2sp(double a, double g, double *lsp, const int m, double *x,
                const int l, const int gain);
+void mgclsp2sp_batch(double a, double g, double *lsp, const int m, double *x,
+                     const int l, const int gain, const int nfrm);
 int mgcep(double *xw, int flng, double *b, const int m, const double a,
           const double g, const int n, const int itr1, const int itr2,
           const double dd, const int etype, const double e, const double f,
           const int itype);
+int mgcep_warm(double *xw, int flng, double *b, const int m, const double a,
+               const double g, const int n, const int itr1, const int itr2,
+               const double dd, const int etype, const double e,
+               const double f, const int itype, CepWarm * w);
 double newton(double *x, const int flng, double *c, const int m, const double a,
               const double g, const int n, const int j, const double f);
 double mglsadf(double x, double *b, const int m, const double a, const int n,
@@ -336,6 +577,8 @@ int str2darray(char *c, double **x);
 int isfloat(char *c);
 double mlsadf(double x, double *b, const int m, const double a, const int pd,
               double *d);
+float mlsadff(float x, float *b, const int m, const float a, const int pd,
+              float *d);
 double mlsadft(double x, double *b, const int m, const double a, const int pd,
                double *d);
 void msvq(double *x, double *cb, const int l, int *cbsize, const int stage,
@@ -348,6 +591,11 @@ unsigned long srnd(const unsigned int seed);
 void par2lpc(double *k, double *a, const int m);
 void phase(double *p, const int mp, double *z, const int mz, double *ph,
            const int flng, const int unlap);
+int pipeline_init(PIPELINE * p, const char *spec, const Boolean round);
+int pipeline_push(PIPELINE * p, const double *x, const int n, double **y);
+int pipeline_flush(PIPELINE * p, double **y);
+void pipeline_reset(PIPELINE * p);
+void pipeline_free(PIPELINE * p);
 double poledf(double x, double *a, int m, double *d);
 double poledft(double x, double *a, int m, double *d);
 void reverse(double *x, const int l);
@@ -355,11 +603,26 @@ double rmse(double *x, double *y, const int n);
 void output_root_pol(Complex * x, int odr, int form);
 void root_pol(double *a, const int odr, Complex * x, const int a_zero,
               const double eps, const int itrat);
+int root_pol_aberth(double *a, const int odr, Complex * x, const int a_zero,
+                    const double eps, const int itrat);
+int root_pol_batch(double *a, const int odr, Complex * x, const int nfrm,
+                   const int a_zero, const double eps, const int itrat,
+                   int *flag);
+int root_pol_eig(double *a, const int odr, Complex * x, const int a_zero,
+                 const double eps, const int itrat);
 Complex *cplx_getmem(const int leng);
 int smcep(double *xw, const int flng, double *mc, const int m, const int fftsz,
           const double a, const double t, const int itr1, const int itr2,
           const double dd, const int etype, const double e, const double f,
           const int itype);
+int stft_init(STFT * s, const int leng, const int fprd, const int fftl,
+              const Window type, const int nflg, const Boolean noctr);
+int stft_nframes(const STFT * s, const int n);
+void stft_frame(STFT * s, const double *x, const int otype, const double eps,
+                double *y);
+int stft(STFT * s, const double *x, const int n, const int otype,
+         const double eps, double *y);
+void stft_free(STFT * s);
 int uels(double *xw, const int flng, double *c, const int m, const int itr1,
          const int itr2, const double dd, const int etype, const double e,
          const int itype);
@@ -372,6 +635,8 @@ int vc(const GMM * gmm, const DELTAWINDOW * window, const size_t total_frame,
 int vq(double *x, double *cb, const int l, const int cbsize);
 double edist(double *x, double *y, const int m);
 double window(Window type, double *x, const int size, const int nflg);
+double windowf(Window type, float *x, const int size, const int nflg);
+double window_table(Window type, double *w, const int size, const int nflg);
 double zcross(double *x, const int fl, const int n);
 double zerodf(double x, double *b, int m, double *d);
 double zerodft(double x, double *b, const int m, double *d);
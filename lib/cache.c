@@ -0,0 +1,419 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Content-Addressed Cache of Analysis Results
+
+    int  cache_open(c, dir, limit)
+    void cache_key(c, param)
+    void cache_update(c, data, n)
+    int  cache_get(c, data, n)
+    int  cache_put(c, data, n)
+    void cache_close(c)
+
+    Cache  *c      : cache
+    char   *dir    : directory of cache entries (must exist)
+    long   limit   : maximum total size of entries in bytes
+                     (0: no limit)
+    char   *param  : analysis parameters (command, options, ...)
+    void   *data   : input bytes (cache_update)
+                     cached result (cache_get, valid until the
+                     next call)
+                     result to be stored (cache_put)
+    size_t n       : number of bytes
+
+    return value of cache_open : 0 -> normally completed
+                                -1 -> dir is not given
+    return value of cache_get  : 0 -> hit, -1 -> miss
+    return value of cache_put  : 0 -> stored, -1 -> failed
+
+    A key is started by cache_key() with the parameters and
+    continued by cache_update() with the input bytes; the entry
+    file is named after two 32 bit hashes of the key.  Each entry
+    also holds the parameters, the input length, a separate
+    digest of the input (two CRC-32s of different polynomials)
+    and a checksum of the result.  An entry whose parameters,
+    length or digest differ from the key (a collision of the
+    file name) or whose result is damaged is treated as missing
+    and removed.  The hashes guard against accidental collisions
+    only, not against input crafted to collide.
+
+    Entries are written to a temporary file and renamed, so that
+    processes sharing a directory see either a complete entry or
+    none.  A hit refreshes the time stamp of the entry, and when
+    more than limit bytes are stored, the least recently used
+    entries are removed, together with temporary files left by
+    processes that died more than an hour ago.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <dirent.h>
+#  include <utime.h>
+#endif
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define M32 0xffffffffUL
+#define CACHE_MAGIC "SPTKCACHE 3"
+#define CACHE_SUFFIX ".sc"
+#define CACHE_TMP ".tmp"
+#define CACHE_TMPAGE 3600       /* age of orphaned temporary files (sec) */
+#define CRC_IEEE 0xedb88320UL
+#define CRC_CASTAGNOLI 0x82f63b78UL
+
+/* FNV-1a */
+static unsigned long hash_fnv(unsigned long h, const unsigned char *p,
+                              size_t n)
+{
+   while (n--) {
+      h ^= *p++;
+      h = (h * 16777619UL) & M32;
+   }
+
+   return (h);
+}
+
+/* one-at-a-time hash without final mixing */
+static unsigned long hash_oaat(unsigned long h, const unsigned char *p,
+                               size_t n)
+{
+   while (n--) {
+      h = (h + *p++) & M32;
+      h = (h + (h << 10)) & M32;
+      h ^= h >> 6;
+   }
+
+   return (h);
+}
+
+static unsigned long crc_ieee[256], crc_castagnoli[256];
+
+/* reflected CRC-32 of polynomial poly; table t is built on first use */
+static unsigned long cache_crc(unsigned long h, const unsigned char *p,
+                               size_t n, const unsigned long poly,
+                               unsigned long *t)
+{
+   int i, k;
+   unsigned long r;
+
+   if (t[1] == 0) {
+      for (i = 0; i < 256; i++) {
+         for (k = 0, r = i; k < 8; k++)
+            r = (r & 1) ? (r >> 1) ^ poly : r >> 1;
+         t[i] = r;
+      }
+   }
+   while (n--)
+      h = (h >> 8) ^ t[(h ^ *p++) & 0xff];
+
+   return (h);
+}
+
+/* CRC-32 of the input so far (as in zlib and iSCSI) */
+static unsigned long crc_final(const unsigned long h)
+{
+   return (h ^ M32);
+}
+
+static unsigned long hash_final(unsigned long h)
+{
+   h = (h + (h << 3)) & M32;
+   h ^= h >> 11;
+   h = (h + (h << 15)) & M32;
+
+   return (h);
+}
+
+int cache_open(Cache * c, const char *dir, const long limit)
+{
+   if (dir == NULL || *dir == '\0')
+      return (-1);
+
+   c->dir = getmem(strlen(dir) + 1, sizeof(*c->dir));
+   strcpy(c->dir, dir);
+   c->limit = limit;
+   c->param = NULL;
+   c->path = getmem(strlen(dir) + 32, sizeof(*c->path));
+   c->data = NULL;
+   c->size = 0;
+   c->written = 0;
+   c->nhit = c->nmiss = 0;
+
+   return (0);
+}
+
+void cache_key(Cache * c, const char *param)
+{
+   if (c->param != NULL)
+      free(c->param);
+   c->param = getmem(strlen(param) + 1, sizeof(*c->param));
+   strcpy(c->param, param);
+   c->h1 = hash_fnv(2166136261UL, (unsigned char *) param, strlen(param) + 1);
+   c->h2 = hash_oaat(0, (unsigned char *) param, strlen(param) + 1);
+   c->d1 = c->d2 = M32;
+   c->nin = 0;
+}
+
+void cache_update(Cache * c, const void *data, const size_t n)
+{
+   c->h1 = hash_fnv(c->h1, (const unsigned char *) data, n);
+   c->h2 = hash_oaat(c->h2, (const unsigned char *) data, n);
+   c->d1 = cache_crc(c->d1, (const unsigned char *) data, n, CRC_IEEE,
+                     crc_ieee);
+   c->d2 = cache_crc(c->d2, (const unsigned char *) data, n, CRC_CASTAGNOLI,
+                     crc_castagnoli);
+   c->nin += n;
+}
+
+static char *cache_path(Cache * c)
+{
+   sprintf(c->path, "%s/%08lx%08lx%s", c->dir, c->h1, hash_final(c->h2),
+           CACHE_SUFFIX);
+
+   return (c->path);
+}
+
+int cache_get(Cache * c, void **data, size_t * n)
+{
+   FILE *fp;
+   char line[128];
+   unsigned long nin, d1, d2, nout, sum, plen;
+   char *param;
+   int ok = 0;
+
+   if ((fp = fopen(cache_path(c), "rb")) == NULL) {
+      c->nmiss++;
+      return (-1);
+   }
+
+   /* header, parameters and result */
+   if (fgets(line, sizeof(line), fp) != NULL
+       && strncmp(line, CACHE_MAGIC, strlen(CACHE_MAGIC)) == 0
+       && sscanf(line + strlen(CACHE_MAGIC), "%lu %lx %lx %lu %lu %lu", &nin,
+                 &d1, &d2, &nout, &sum, &plen) == 6 && nin == c->nin
+       && d1 == crc_final(c->d1) && d2 == crc_final(c->d2) && plen == strlen(c->param)) {
+      param = getmem(plen + 1, sizeof(*param));
+      if (fread(param, 1, plen, fp) == plen && strcmp(param, c->param) == 0) {
+         if (nout > c->size) {
+            if (c->data != NULL)
+               free(c->data);
+            c->size = nout;
+            c->data = getmem(c->size + 1, sizeof(*c->data));
+         }
+         ok = (fread(c->data, 1, nout, fp) == nout && getc(fp) == EOF
+               && hash_fnv(2166136261UL, (unsigned char *) c->data,
+                           nout) == sum);
+      }
+      free(param);
+   }
+   fclose(fp);
+
+   if (!ok) {
+      /* damaged entry or collision */
+      remove(c->path);
+      c->nmiss++;
+      return (-1);
+   }
+#ifndef WIN32
+   utime(c->path, NULL);
+#endif
+   *data = c->data;
+   *n = nout;
+   c->nhit++;
+
+   return (0);
+}
+
+#ifndef WIN32
+typedef struct _CacheEntry {
+   char name[32];
+   long size;
+   time_t mtime;
+} CacheEntry;
+
+static int cmp_mtime(const void *a, const void *b)
+{
+   const time_t x = ((const CacheEntry *) a)->mtime;
+   const time_t y = ((const CacheEntry *) b)->mtime;
+
+   return ((x > y) - (x < y));
+}
+
+/* remove the least recently used entries until limit is met, and
+   temporary files of processes that died while writing */
+static void cache_evict(Cache * c)
+{
+   DIR *d;
+   struct dirent *e;
+   struct stat st;
+   CacheEntry *list = NULL, *p;
+   int n = 0, size = 0, k;
+   long total = 0;
+   char *path;
+   const size_t ls = strlen(CACHE_SUFFIX), lt = strlen(CACHE_TMP);
+   const time_t old = time(NULL) - CACHE_TMPAGE;
+
+   if ((d = opendir(c->dir)) == NULL)
+      return;
+   path = getmem(strlen(c->dir) + 256 + 2, sizeof(*path));
+   while ((e = readdir(d)) != NULL) {
+      k = strlen(e->d_name);
+      if (k > lt && k < 256 && strcmp(e->d_name + k - lt, CACHE_TMP) == 0
+          && strstr(e->d_name, CACHE_SUFFIX ".") != NULL) {
+         sprintf(path, "%s/%s", c->dir, e->d_name);
+         if (stat(path, &st) == 0 && st.st_mtime < old)
+            remove(path);
+         continue;
+      }
+      if (k <= ls || k >= 32 || strcmp(e->d_name + k - ls, CACHE_SUFFIX) != 0)
+         continue;
+      sprintf(path, "%s/%s", c->dir, e->d_name);
+      if (stat(path, &st) != 0)
+         continue;
+      if (n == size) {
+         size = (size == 0) ? 256 : 2 * size;
+         p = (CacheEntry *) getmem(size, sizeof(*p));
+         if (list != NULL) {
+            memcpy(p, list, n * sizeof(*p));
+            free(list);
+         }
+         list = p;
+      }
+      strcpy(list[n].name, e->d_name);
+      list[n].size = st.st_size;
+      list[n].mtime = st.st_mtime;
+      total += st.st_size;
+      n++;
+   }
+   closedir(d);
+
+   if (total > c->limit) {
+      qsort(list, n, sizeof(*list), cmp_mtime);
+      for (k = 0; k < n && total > c->limit; k++) {
+         sprintf(path, "%s/%s", c->dir, list[k].name);
+         remove(path);          /* may have been removed by others */
+         total -= list[k].size;
+      }
+   }
+
+   free(path);
+   if (list != NULL)
+      free(list);
+}
+#endif
+
+int cache_put(Cache * c, const void *data, const size_t n)
+{
+   FILE *fp;
+   char *tmp;
+   const size_t plen = strlen(c->param);
+   int ok;
+
+   cache_path(c);
+   tmp = getmem(strlen(c->path) + 32, sizeof(*tmp));
+#ifndef WIN32
+   sprintf(tmp, "%s.%ld%s", c->path, (long) getpid(), CACHE_TMP);
+#else
+   sprintf(tmp, "%s.%ld%s", c->path, (long) clock(), CACHE_TMP);
+#endif
+
+   if ((fp = fopen(tmp, "wb")) == NULL) {
+      free(tmp);
+      return (-1);
+   }
+   fprintf(fp, "%s %lu %08lx %08lx %lu %lu %lu\n", CACHE_MAGIC,
+           (unsigned long) c->nin, crc_final(c->d1), crc_final(c->d2),
+           (unsigned long) n,
+           hash_fnv(2166136261UL, (const unsigned char *) data, n),
+           (unsigned long) plen);
+   ok = (fwrite(c->param, 1, plen, fp) == plen
+         && fwrite(data, 1, n, fp) == n);
+   if (fclose(fp) != 0)
+      ok = 0;
+
+   /* an existing entry of the same key has the same contents */
+   if (ok && rename(tmp, c->path) != 0)
+      ok = 0;
+   if (!ok) {
+      remove(tmp);
+      free(tmp);
+      return (-1);
+   }
+   free(tmp);
+
+#ifndef WIN32
+   c->written += n + plen + 64;
+   if (c->limit > 0 && c->written > c->limit / 16) {
+      cache_evict(c);
+      c->written = 0;
+   }
+#endif
+
+   return (0);
+}
+
+void cache_close(Cache * c)
+{
+   free(c->dir);
+   free(c->path);
+   if (c->param != NULL)
+      free(c->param);
+   if (c->data != NULL)
+      free(c->data);
+   c->dir = c->path = c->param = c->data = NULL;
+}
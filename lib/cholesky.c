@@ -59,6 +59,9 @@
     return value : 0 -> normally completed
                   -1 -> abnormally completed
 
+    The LDL' factorization is done by mat_ldl() and the two
+    triangular systems by mat_trsv().
+
 ****************************************************************/
 
 #include <stdio.h>
@@ -73,57 +76,34 @@
 
 int cholesky(double *c, double *a, double *b, const int n, double eps)
 {
-   int i, j, k;
-   static double *d = NULL, *y, *v, *vp;
+   int i, j;
+   static double *v = NULL;
    static int size;
 
-   if (d == NULL) {
-      d = dgetmem(n * (n + 2));
-      y = d + n;
-      v = y + n;
+   if (v == NULL) {
+      v = dgetmem(n * n);
       size = n;
    }
 
    if (n > size) {
-      free(d);
-      d = dgetmem(n * (n + 2));
-      y = d + n;
-      v = y + n;
+      free(v);
+      v = dgetmem(n * n);
       size = n;
    }
 
-   if (eps < 0.0)
-      eps = 1.0e-6;
-
-   for (j = 0; j < n; j++, c += n) {
-      d[j] = c[j];
-      vp = v + j * n;
-      for (k = 0; k < j; k++)
-         d[j] -= vp[k] * vp[k] * d[k];
-
-      if (fabs(d[j]) <= eps)
-         return (-1);
-
-      for (i = j + 1; i < n; i++) {
-         vp = v + i * n;
-         vp[j] = c[i];
-         for (k = 0; k < j; k++)
-            vp[j] -= vp[k] * v[j * n + k] * d[k];
-         vp[j] /= d[j];
-      }
-   }
+   /* the upper triangle of c is referenced */
+   for (i = 0; i < n; i++)
+      for (j = i; j < n; j++)
+         v[j * n + i] = c[i * n + j];
 
-   for (i = 0; i < n; i++) {
-      y[i] = b[i];
-      vp = v + i * n;
-      for (k = 0; k < i; k++)
-         y[i] -= vp[k] * y[k];
-   }
+   if (mat_ldl(v, n, n, eps) != 0)
+      return (-1);
+
+   movem(b, a, sizeof(*b), n);
+   mat_trsv(v, n, n, 0, 1, a);
+   for (i = 0; i < n; i++)
+      a[i] /= v[i * n + i];
+   mat_trsv(v, n, n, 1, 1, a);
 
-   for (i = n - 1; i >= 0; i--) {
-      a[i] = y[i] / d[i];
-      for (k = i + 1; k < n; k++)
-         a[i] -= v[n * k + i] * a[k];
-   }
    return (0);
 }
@@ -62,6 +62,12 @@
     size_t leng : data length
     size_t size : size of data type
 
+    long getmem_count(bytes)
+
+    double *bytes : total size of allocated memory (may be NULL)
+
+    return value  : number of calls of getmem() so far
+
 **********************************************************************/
 
 #include <stdio.h>
@@ -73,10 +79,16 @@
 #define real float
 #endif
 
+static long nalloc = 0;
+static double nbyte = 0.0;
+
 char *getmem(const size_t leng, const size_t size)
 {
    char *p = NULL;
 
+   nalloc++;
+   nbyte += (double) leng * size;
+
    if ((p = (char *) calloc(leng, size)) == NULL) {
       fprintf(stderr, "Cannot allocate memory!\n");
       exit(3);
@@ -84,6 +96,13 @@ char *getmem(const size_t leng, const size_t size)
    return (p);
 }
 
+long getmem_count(double *bytes)
+{
+   if (bytes != NULL)
+      *bytes = nbyte;
+   return (nalloc);
+}
+
 short *sgetmem(const int leng)
 {
    return ((short *) getmem((size_t) leng, sizeof(short)));
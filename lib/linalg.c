@@ -0,0 +1,373 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Dense Linear Algebra Kernels
+
+    void mat_gemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc)
+                                     < C = alpha A B + beta C >
+    int mat_chol(a, n, lda)          < A = L L' >
+    int mat_ldl(a, n, lda, eps)      < A = L D L' >
+    void mat_trsv(l, n, lda, trans, unit, x)
+                                     < L x = b or L' x = b >
+    int mat_spdinv(a, n, lda, ldet)  < A <- inverse of A (A > 0) >
+    int mat_inv(a, n, lda, ipiv, det)
+                                     < A <- inverse of A >
+
+    double *a, *b, *c : row-major matrices
+    int    m, n, k    : C is m x n, A is m x k, B is k x n
+    int    lda, ...   : distance between the rows of each matrix
+    double alpha,beta : scale factors (beta = 0 ignores C)
+    double *l         : lower triangular factor
+    int    trans      : 0 -> solve L x = b, 1 -> solve L' x = b
+    int    unit       : 1 -> diagonal of L is assumed to be 1
+    double *x         : right-hand side, overwritten by solution
+    double eps        : singular check for D (if -1.0, 1.0e-6)
+    double *ldet      : log determinant of A (may be NULL)
+    int    *ipiv      : pivot indices (work, n)
+    double *det       : determinant of A (may be NULL)
+
+    return value : 0 -> normally completed
+                  -1 -> matrix is singular (or not positive
+                        definite for mat_chol and mat_spdinv)
+
+    All routines work in place on caller-owned storage and
+    never allocate or exit.  mat_chol and mat_ldl leave the
+    factor in the lower triangle (D on the diagonal for
+    mat_ldl) and do not touch the strict upper triangle.
+    mat_gemm and mat_chol are processed in MAT_BLOCK x MAT_BLOCK
+    tiles so that the working set stays in cache, and their
+    innermost loops run over contiguous memory.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define MAT_BLOCK 64
+
+static double dot(const double *x, const double *y, const int n)
+{
+   int i;
+   double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+
+   for (i = 0; i + 4 <= n; i += 4) {
+      s0 += x[i] * y[i];
+      s1 += x[i + 1] * y[i + 1];
+      s2 += x[i + 2] * y[i + 2];
+      s3 += x[i + 3] * y[i + 3];
+   }
+   for (; i < n; i++)
+      s0 += x[i] * y[i];
+
+   return ((s0 + s1) + (s2 + s3));
+}
+
+void mat_gemm(const int m, const int n, const int k, const double alpha,
+              const double *a, const int lda, const double *b, const int ldb,
+              const double beta, double *c, const int ldc)
+{
+   int i, j, p, ib, jb, pb, ie, je, pe;
+   double t0, t1, t2, t3, *c0, *c1, *c2, *c3;
+   const double *bp;
+
+   for (i = 0; i < m; i++) {
+      c0 = c + i * ldc;
+      if (beta == 0.0)
+         for (j = 0; j < n; j++)
+            c0[j] = 0.0;
+      else if (beta != 1.0)
+         for (j = 0; j < n; j++)
+            c0[j] *= beta;
+   }
+   if (alpha == 0.0)
+      return;
+
+   for (ib = 0; ib < m; ib += MAT_BLOCK) {
+      ie = (ib + MAT_BLOCK < m) ? ib + MAT_BLOCK : m;
+      for (pb = 0; pb < k; pb += MAT_BLOCK) {
+         pe = (pb + MAT_BLOCK < k) ? pb + MAT_BLOCK : k;
+         for (jb = 0; jb < n; jb += MAT_BLOCK) {
+            je = (jb + MAT_BLOCK < n) ? jb + MAT_BLOCK : n;
+
+            /* four rows of C share each row of B */
+            for (i = ib; i + 4 <= ie; i += 4) {
+               c0 = c + i * ldc;
+               c1 = c0 + ldc;
+               c2 = c1 + ldc;
+               c3 = c2 + ldc;
+               for (p = pb; p < pe; p++) {
+                  t0 = alpha * a[i * lda + p];
+                  t1 = alpha * a[(i + 1) * lda + p];
+                  t2 = alpha * a[(i + 2) * lda + p];
+                  t3 = alpha * a[(i + 3) * lda + p];
+                  bp = b + p * ldb;
+                  for (j = jb; j < je; j++) {
+                     c0[j] += t0 * bp[j];
+                     c1[j] += t1 * bp[j];
+                     c2[j] += t2 * bp[j];
+                     c3[j] += t3 * bp[j];
+                  }
+               }
+            }
+            for (; i < ie; i++) {
+               c0 = c + i * ldc;
+               for (p = pb; p < pe; p++) {
+                  t0 = alpha * a[i * lda + p];
+                  bp = b + p * ldb;
+                  for (j = jb; j < je; j++)
+                     c0[j] += t0 * bp[j];
+               }
+            }
+         }
+      }
+   }
+
+   return;
+}
+
+int mat_chol(double *a, const int n, const int lda)
+{
+   int i, j, jb, je, ib, ie, ii;
+   double d, *ai, *aj;
+
+   for (jb = 0; jb < n; jb += MAT_BLOCK) {
+      je = (jb + MAT_BLOCK < n) ? jb + MAT_BLOCK : n;
+
+      /* factorize diagonal block and the panel below it */
+      for (j = jb; j < je; j++) {
+         aj = a + j * lda;
+         d = aj[j] - dot(aj + jb, aj + jb, j - jb);
+         if (d <= 0.0)
+            return (-1);
+         aj[j] = d = sqrt(d);
+         for (i = j + 1; i < n; i++) {
+            ai = a + i * lda;
+            ai[j] = (ai[j] - dot(ai + jb, aj + jb, j - jb)) / d;
+         }
+      }
+
+      /* update trailing submatrix with the panel, tile by tile */
+      for (ib = je; ib < n; ib += MAT_BLOCK) {
+         ie = (ib + MAT_BLOCK < n) ? ib + MAT_BLOCK : n;
+         for (i = ib; i < n; i++) {
+            ai = a + i * lda;
+            for (ii = ib; ii < ie && ii <= i; ii++)
+               ai[ii] -= dot(ai + jb, a + ii * lda + jb, je - jb);
+         }
+      }
+   }
+
+   return (0);
+}
+
+int mat_ldl(double *a, const int n, const int lda, double eps)
+{
+   int i, j, k;
+   double d, s, *ai, *aj;
+
+   if (eps < 0.0)
+      eps = 1.0e-6;
+
+   for (j = 0; j < n; j++) {
+      aj = a + j * lda;
+      d = aj[j];
+      for (k = 0; k < j; k++)
+         d -= aj[k] * aj[k] * a[k * lda + k];
+      if (fabs(d) <= eps)
+         return (-1);
+      aj[j] = d;
+
+      for (i = j + 1; i < n; i++) {
+         ai = a + i * lda;
+         s = ai[j];
+         for (k = 0; k < j; k++)
+            s -= ai[k] * aj[k] * a[k * lda + k];
+         ai[j] = s / d;
+      }
+   }
+
+   return (0);
+}
+
+void mat_trsv(const double *l, const int n, const int lda, const int trans,
+              const int unit, double *x)
+{
+   int i, k;
+   double t;
+   const double *li;
+
+   if (!trans) {
+      for (i = 0; i < n; i++) {
+         li = l + i * lda;
+         x[i] -= dot(li, x, i);
+         if (!unit)
+            x[i] /= li[i];
+      }
+   } else {
+      for (i = n - 1; i >= 0; i--) {
+         li = l + i * lda;
+         if (!unit)
+            x[i] /= li[i];
+         t = x[i];
+         for (k = 0; k < i; k++)
+            x[k] -= t * li[k];
+      }
+   }
+
+   return;
+}
+
+int mat_spdinv(double *a, const int n, const int lda, double *ldet)
+{
+   int i, j, k;
+   double s, *ai;
+
+   if (mat_chol(a, n, lda) != 0)
+      return (-1);
+
+   if (ldet != NULL) {
+      for (i = 0, s = 0.0; i < n; i++)
+         s += log(a[i * lda + i]);
+      *ldet = 2.0 * s;
+   }
+
+   /* L <- inverse of L, column by column */
+   for (j = 0; j < n; j++) {
+      a[j * lda + j] = 1.0 / a[j * lda + j];
+      for (i = j + 1; i < n; i++) {
+         ai = a + i * lda;
+         for (k = j, s = 0.0; k < i; k++)
+            s += ai[k] * a[k * lda + j];
+         ai[j] = -s / ai[i];
+      }
+   }
+
+   /* A <- L^-T L^-1, lower triangle first */
+   for (i = 0; i < n; i++) {
+      for (j = 0; j <= i; j++) {
+         for (k = i, s = 0.0; k < n; k++)
+            s += a[k * lda + i] * a[k * lda + j];
+         a[i * lda + j] = s;
+      }
+   }
+   for (i = 0; i < n; i++)
+      for (j = i + 1; j < n; j++)
+         a[i * lda + j] = a[j * lda + i];
+
+   return (0);
+}
+
+int mat_inv(double *a, const int n, const int lda, int *ipiv, double *det)
+{
+   int i, j, k, p;
+   double u, d, t, *ak, *ai;
+
+   d = 1.0;
+   for (k = 0; k < n; k++) {
+      /* partial pivoting */
+      for (i = k, p = k, u = 0.0; i < n; i++)
+         if (fabs(a[i * lda + k]) > u) {
+            u = fabs(a[i * lda + k]);
+            p = i;
+         }
+      if (u == 0.0)
+         return (-1);
+      ipiv[k] = p;
+      ak = a + k * lda;
+      if (p != k) {
+         ai = a + p * lda;
+         for (j = 0; j < n; j++) {
+            t = ak[j];
+            ak[j] = ai[j];
+            ai[j] = t;
+         }
+         d = -d;
+      }
+
+      /* Gauss-Jordan elimination */
+      u = ak[k];
+      d *= u;
+      ak[k] = 1.0;
+      u = 1.0 / u;
+      for (j = 0; j < n; j++)
+         ak[j] *= u;
+      for (i = 0; i < n; i++) {
+         if (i == k)
+            continue;
+         ai = a + i * lda;
+         t = ai[k];
+         if (t == 0.0)
+            continue;
+         ai[k] = 0.0;
+         for (j = 0; j < n; j++)
+            ai[j] -= t * ak[j];
+      }
+   }
+
+   /* undo row interchanges as column interchanges */
+   for (k = n - 1; k >= 0; k--) {
+      if ((p = ipiv[k]) == k)
+         continue;
+      for (i = 0; i < n; i++) {
+         ai = a + i * lda;
+         t = ai[k];
+         ai[k] = ai[p];
+         ai[p] = t;
+      }
+   }
+
+   if (det != NULL)
+      *det = d;
+
+   return (0);
+}
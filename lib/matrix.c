@@ -60,6 +60,7 @@
         double a[] : answer
 
         if xx=1 and xy=1 ,then x[0] is regarded as scalar
+        the product is computed by mat_gemm()
 		
     add matrix
     addm(x, y, xx, yy, a)
@@ -87,8 +88,7 @@ static int tmpsize = 0;
 static void mm(double x[], const int xx, const int xy, double y[], const int yx,
                const int yy, double a[])
 {
-   int i, j, k;
-   double *wx, *wy;
+   int i;
 
    if (xx == 1 && xy == 1) {
       for (i = yx * yy - 1; i >= 0; i--)
@@ -102,21 +102,7 @@ static void mm(double x[], const int xx, const int xy, double y[], const int yx,
       exit(1);
    }
 
-   wx = x;
-   for (i = 0; i < xy; i++) {
-      for (j = 0; j < yx; j++) {
-         wy = &y[j];
-         *a = 0;
-         for (k = 0; k < xx; k++) {
-            *a += *wx * *wy;
-            wx++;
-            wy += yx;
-         }
-         wx -= xx;
-         a++;
-      }
-      wx += xx;
-   }
+   mat_gemm(xy, yx, xx, 1.0, x, xx, y, yx, 0.0, a, yx);
 
    return;
 }
@@ -126,7 +112,7 @@ void multim(double x[], const int xx, const int xy, double y[], const int yx,
 {
    int i;
 
-   if (x == a) {
+   if (x == a || y == a) {
       if (((xy > yy) ? xy : yy) * yx > tmpsize) {
          if (tmp != NULL)
             free(tmp);
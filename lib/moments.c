@@ -0,0 +1,178 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Streaming Mean and Covariance Accumulator
+
+    int  alloc_Moments(s, dim, full)
+    void fillz_Moments(s)
+    void accum_Moments(s, x)
+    void merge_Moments(s, t)
+    void cov_Moments(s, cov)
+    void free_Moments(s)
+
+    Moments *s    : accumulator
+    Moments *t    : accumulator merged into s
+    int     dim   : dimension of vector
+    Boolean full  : accumulate full covariance (FA: diagonal only)
+    double  *x    : input vector
+    double  *cov  : covariance (dim x dim if full, dim otherwise)
+
+    accum_Moments() updates the mean and the sum of squared
+    deviations by Welford's method, so that the result does not
+    suffer from cancellation like sum(x^2) - n * mean^2.
+    merge_Moments() combines two accumulators (Chan et al.),
+    e.g. partial results over shards of a corpus.
+
+    return value of alloc_Moments : 0 -> normally completed
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+int alloc_Moments(Moments * s, const int dim, const Boolean full)
+{
+   s->dim = dim;
+   s->full = full;
+   s->mean = dgetmem(dim + (full ? dim * dim : dim) + dim);
+   s->m2 = s->mean + dim;
+   s->delta = s->m2 + (full ? dim * dim : dim);
+   s->count = 0.0;
+
+   return (0);
+}
+
+void fillz_Moments(Moments * s)
+{
+   fillz(s->mean, sizeof(*(s->mean)),
+         s->dim + (s->full ? s->dim * s->dim : s->dim));
+   s->count = 0.0;
+}
+
+void accum_Moments(Moments * s, const double *x)
+{
+   int i, j;
+   const int dim = s->dim;
+   double *mean = s->mean, *m2 = s->m2, *d = s->delta, r, dx;
+
+   s->count += 1.0;
+   r = 1.0 / s->count;
+
+   for (i = 0; i < dim; i++) {
+      d[i] = x[i] - mean[i];
+      mean[i] += d[i] * r;
+   }
+
+   if (s->full) {
+      for (i = 0; i < dim; i++, m2 += dim) {
+         dx = x[i] - mean[i];
+         for (j = 0; j <= i; j++)
+            m2[j] += dx * d[j];
+      }
+   } else {
+      for (i = 0; i < dim; i++)
+         m2[i] += d[i] * (x[i] - mean[i]);
+   }
+}
+
+void merge_Moments(Moments * s, const Moments * t)
+{
+   int i, j;
+   const int dim = s->dim;
+   double *mean = s->mean, *m2 = s->m2, *d = s->delta, n, w;
+
+   if (t->count <= 0.0)
+      return;
+
+   n = s->count + t->count;
+   w = s->count * t->count / n;
+
+   for (i = 0; i < dim; i++) {
+      d[i] = t->mean[i] - mean[i];
+      mean[i] += d[i] * t->count / n;
+   }
+
+   if (s->full) {
+      for (i = 0; i < dim; i++, m2 += dim)
+         for (j = 0; j <= i; j++)
+            m2[j] += t->m2[i * dim + j] + w * d[i] * d[j];
+   } else {
+      for (i = 0; i < dim; i++)
+         m2[i] += t->m2[i] + w * d[i] * d[i];
+   }
+
+   s->count = n;
+}
+
+void cov_Moments(const Moments * s, double *cov)
+{
+   int i, j;
+   const int dim = s->dim;
+   double r;
+
+   r = (s->count > 0.0) ? 1.0 / s->count : 0.0;
+
+   if (s->full) {
+      for (i = 0; i < dim; i++)
+         for (j = 0; j <= i; j++)
+            cov[i * dim + j] = cov[j * dim + i] = s->m2[i * dim + j] * r;
+   } else {
+      for (i = 0; i < dim; i++)
+         cov[i] = s->m2[i] * r;
+   }
+}
+
+void free_Moments(Moments * s)
+{
+   free(s->mean);
+   s->mean = s->m2 = s->delta = NULL;
+}
@@ -48,9 +48,15 @@
     M-Sequence Generator using X**31 + X**28 + 1
 
     int mseq(void)
+    int mseq_r(x)
+
+    int *x       : shift register (initialize with 0x55555555)
 
     return value : M-Sequence
 
+    mseq() keeps its register in a static variable; mseq_r() is
+    the reentrant version which works on the caller's register.
+
 ****************************************************************/
 
 #define	B0    0x00000001
@@ -59,27 +65,33 @@
 #define	B31_  0x7fffffff
 #define	Z     0x00000000
 
-int mseq(void)
+int mseq_r(int *x)
 {
-   static int x = 0x55555555;
    int x0, x28;
 
-   x >>= 1;
+   *x >>= 1;
 
-   if (x & B0)
+   if (*x & B0)
       x0 = 1;
    else
       x0 = -1;
 
-   if (x & B28)
+   if (*x & B28)
       x28 = 1;
    else
       x28 = -1;
 
    if (x0 + x28)
-      x &= B31_;
+      *x &= B31_;
    else
-      x |= B31;
+      *x |= B31;
 
    return (x0);
 }
+
+int mseq(void)
+{
+   static int x = 0x55555555;
+
+   return (mseq_r(&x));
+}
@@ -0,0 +1,259 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Counter-Based Random Number Generator (Philox4x32-10)
+
+    void philox_init(g, seed)
+    void philox_seek(g, pos)
+    void philox_skip(g, n)
+    void philox_uniform(g, p, leng)
+    void philox_normal(g, p, leng)
+
+    Philox *g       : generator state
+    unsigned long seed : seed of random value
+    unsigned long pos  : absolute position in the stream
+    unsigned long n    : number of values to skip
+    double *p       : generated random value
+    int    leng     : length
+
+    The i-th value of a stream depends only on (seed, i), so
+    a sequence can be split into pieces generated independently
+    (e.g. one per thread) after philox_seek(), and the result is
+    identical to the one generated sequentially.
+
+    Each counter block of 4 x 32 bits yields two uniform values
+    with 53 bit resolution in (0, 1); philox_normal() converts
+    each pair into two normal values by the Box-Muller method.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define M32      0xffffffffUL
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+#define ROUNDS   10
+
+#define TWO26    67108864.0
+#define TWO53    9007199254740992.0
+
+static void mulhilo(const unsigned long a, const unsigned long b,
+                    unsigned long *hi, unsigned long *lo)
+{
+   unsigned long a0, a1, b0, b1, p00, p01, p10, p11, mid;
+
+   a0 = a & 0xffff;
+   a1 = (a >> 16) & 0xffff;
+   b0 = b & 0xffff;
+   b1 = (b >> 16) & 0xffff;
+
+   p00 = a0 * b0;
+   p01 = a0 * b1;
+   p10 = a1 * b0;
+   p11 = a1 * b1;
+
+   mid = (p00 >> 16) + (p01 & 0xffff) + (p10 & 0xffff);
+   *lo = ((mid << 16) | (p00 & 0xffff)) & M32;
+   *hi = (p11 + (p01 >> 16) + (p10 >> 16) + (mid >> 16)) & M32;
+}
+
+static void philox_block(const unsigned long *key, const unsigned long blo,
+                         const unsigned long bhi, unsigned long *w)
+{
+   int r;
+   unsigned long k0, k1, hi0, lo0, hi1, lo1;
+
+   w[0] = blo;
+   w[1] = bhi;
+   w[2] = 0;
+   w[3] = 0;
+   k0 = key[0];
+   k1 = key[1];
+
+   for (r = 0; r < ROUNDS; r++) {
+      mulhilo(PHILOX_M0, w[0], &hi0, &lo0);
+      mulhilo(PHILOX_M1, w[2], &hi1, &lo1);
+      w[0] = hi1 ^ w[1] ^ k0;
+      w[1] = lo1;
+      w[2] = hi0 ^ w[3] ^ k1;
+      w[3] = lo0;
+      k0 = (k0 + PHILOX_W0) & M32;
+      k1 = (k1 + PHILOX_W1) & M32;
+   }
+}
+
+/* block index and slot of the current position (2 values per block) */
+static void philox_where(const Philox * g, unsigned long *blo,
+                         unsigned long *bhi, int *slot)
+{
+   *slot = (int) (g->pos[0] & 1);
+   *blo = ((g->pos[0] >> 1) | ((g->pos[1] & 1) << 31)) & M32;
+   *bhi = (g->pos[1] >> 1) & M32;
+}
+
+static void philox_pair(const Philox * g, const unsigned long blo,
+                        const unsigned long bhi, double *u)
+{
+   unsigned long w[4];
+
+   philox_block(g->key, blo, bhi, w);
+   u[0] = ((double) (w[0] >> 5) * TWO26 + (double) (w[1] >> 6) + 0.5) / TWO53;
+   u[1] = ((double) (w[2] >> 5) * TWO26 + (double) (w[3] >> 6) + 0.5) / TWO53;
+}
+
+static void next_block(unsigned long *blo, unsigned long *bhi)
+{
+   *blo = (*blo + 1) & M32;
+   if (*blo == 0)
+      *bhi = (*bhi + 1) & M32;
+}
+
+void philox_init(Philox * g, const unsigned long seed)
+{
+   g->key[0] = seed & M32;
+   g->key[1] = ((seed >> 16) >> 16) & M32;
+   g->pos[0] = 0;
+   g->pos[1] = 0;
+}
+
+void philox_seek(Philox * g, const unsigned long pos)
+{
+   g->pos[0] = pos & M32;
+   g->pos[1] = ((pos >> 16) >> 16) & M32;
+}
+
+void philox_skip(Philox * g, const unsigned long n)
+{
+   unsigned long lo;
+
+   lo = (g->pos[0] + (n & M32)) & M32;
+   g->pos[1] = (g->pos[1] + ((n >> 16) >> 16) + (lo < g->pos[0])) & M32;
+   g->pos[0] = lo;
+}
+
+void philox_uniform(Philox * g, double *p, const int leng)
+{
+   int i = 0, slot;
+   unsigned long blo, bhi;
+   double u[2];
+
+   if (leng <= 0)
+      return;
+
+   philox_where(g, &blo, &bhi, &slot);
+
+   if (slot) {
+      philox_pair(g, blo, bhi, u);
+      p[i++] = u[1];
+      next_block(&blo, &bhi);
+   }
+   for (; i + 1 < leng; i += 2) {
+      philox_pair(g, blo, bhi, p + i);
+      next_block(&blo, &bhi);
+   }
+   if (i < leng) {
+      philox_pair(g, blo, bhi, u);
+      p[i] = u[0];
+   }
+
+   philox_skip(g, (unsigned long) leng);
+}
+
+static void boxmuller(double *u, const int leng)
+{
+   int i;
+   double r, t;
+
+   for (i = 0; i + 1 < leng; i += 2) {
+      r = sqrt(-2.0 * log(u[i]));
+      t = PI2 * u[i + 1];
+      u[i] = r * cos(t);
+      u[i + 1] = r * sin(t);
+   }
+}
+
+void philox_normal(Philox * g, double *p, const int leng)
+{
+   int i = 0, n;
+   Philox h;
+   double u[2];
+
+   if (leng <= 0)
+      return;
+
+   h = *g;
+
+   /* a stream starting at the second half of a pair */
+   if (h.pos[0] & 1) {
+      h.pos[0]--;
+      philox_uniform(&h, u, 2);
+      boxmuller(u, 2);
+      p[i++] = u[1];
+   }
+
+   /* bulk: whole pairs */
+   n = (leng - i) & ~1;
+   philox_uniform(&h, p + i, n);
+   boxmuller(p + i, n);
+   i += n;
+
+   if (i < leng) {
+      philox_uniform(&h, u, 2);
+      boxmuller(u, 2);
+      p[i] = u[0];
+   }
+
+   philox_skip(g, (unsigned long) leng);
+}
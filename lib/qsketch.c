@@ -0,0 +1,284 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Mergeable Quantile Sketch
+
+    int    alloc_QSketch(s, eps)
+    void   accum_QSketch(s, x)
+    void   merge_QSketch(s, t)
+    double quantile_QSketch(s, q)
+    double median_QSketch(s)
+    void   free_QSketch(s)
+
+    QSketch *s  : sketch
+    QSketch *t  : sketch merged into s
+    double  eps : bound of rank error relative to the number of
+                  values (0: keep all values, i.e. exact)
+    double  x   : input value
+    double  q   : quantile (0 <= q <= 1)
+
+    The sketch is a stack of compactors.  Level h holds values of
+    weight 2^h; when a level has reached its capacity it is sorted
+    and every other value is promoted to level h + 1.  Each such
+    compaction shifts any rank by at most 2^h, and a level is
+    compacted at most n / (2^h c) times, so that the rank error is
+    bounded by n H / c for H levels of capacity c.  The capacity
+    is chosen as c = QSKETCH_LEVELS / eps, which guarantees the
+    bound eps n as long as n < c 2^QSKETCH_LEVELS.
+
+    Until the first compaction the sketch is exact; the median of
+    an even number of values is the mean of the two middle ones.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define QSKETCH_LEVELS 32
+#define INITSIZE       64
+
+static int cmpdouble(const void *a, const void *b)
+{
+   const double x = *(const double *) a, y = *(const double *) b;
+
+   return ((x > y) - (x < y));
+}
+
+int alloc_QSketch(QSketch * s, const double eps)
+{
+   s->cap = (eps > 0.0) ? (long) ceil(QSKETCH_LEVELS / eps) : 0;
+   if (s->cap > 0 && s->cap < 2)
+      s->cap = 2;
+   s->nlev = 0;
+   s->count = 0.0;
+   s->flip = 0;
+   s->len = NULL;
+   s->size = NULL;
+   s->buf = NULL;
+
+   return (0);
+}
+
+static void add_level(QSketch * s)
+{
+   int h = s->nlev;
+   long *len, *size;
+   double **buf;
+
+   len = (long *) getmem((size_t) (h + 1), sizeof(long));
+   size = (long *) getmem((size_t) (h + 1), sizeof(long));
+   buf = (double **) getmem((size_t) (h + 1), sizeof(double *));
+   if (h > 0) {
+      movem(s->len, len, sizeof(long), h);
+      movem(s->size, size, sizeof(long), h);
+      movem(s->buf, buf, sizeof(double *), h);
+      free(s->len);
+      free(s->size);
+      free(s->buf);
+   }
+   size[h] = (s->cap > 0) ? 2 * s->cap : INITSIZE;
+   buf[h] = dgetmem((int) size[h]);
+   len[h] = 0;
+
+   s->len = len;
+   s->size = size;
+   s->buf = buf;
+   s->nlev = h + 1;
+}
+
+static void push(QSketch * s, const int h, const double x)
+{
+   double *p;
+
+   while (h >= s->nlev)
+      add_level(s);
+
+   if (s->len[h] == s->size[h]) {
+      p = dgetmem((int) (2 * s->size[h]));
+      movem(s->buf[h], p, sizeof(*p), (int) s->len[h]);
+      free(s->buf[h]);
+      s->buf[h] = p;
+      s->size[h] *= 2;
+   }
+   s->buf[h][s->len[h]++] = x;
+}
+
+/* compact level h and all levels it overflows into */
+static void compact(QSketch * s, int h)
+{
+   long i, n;
+   double *b;
+
+   while (s->cap > 0 && h < s->nlev && s->len[h] >= s->cap) {
+      b = s->buf[h];
+      n = s->len[h] & ~1L;
+      qsort(b, (size_t) n, sizeof(*b), cmpdouble);
+
+      /* alternate the offset so that the errors tend to cancel */
+      s->flip ^= 1;
+      for (i = s->flip; i < n; i += 2)
+         push(s, h + 1, s->buf[h][i]);
+
+      /* an odd value left over stays at this level */
+      b = s->buf[h];
+      if (s->len[h] > n)
+         b[0] = b[n];
+      s->len[h] -= n;
+      h++;
+   }
+}
+
+void accum_QSketch(QSketch * s, const double x)
+{
+   push(s, 0, x);
+   s->count += 1.0;
+   if (s->cap > 0 && s->len[0] >= s->cap)
+      compact(s, 0);
+}
+
+void merge_QSketch(QSketch * s, const QSketch * t)
+{
+   int h;
+   long i;
+
+   for (h = 0; h < t->nlev; h++)
+      for (i = 0; i < t->len[h]; i++)
+         push(s, h, t->buf[h][i]);
+   s->count += t->count;
+
+   for (h = 0; h < s->nlev; h++)
+      compact(s, h);
+}
+
+/* (value, weight) pairs of all retained values, sorted by value */
+static double *gather(const QSketch * s, long *n)
+{
+   int h;
+   long i, k;
+   double *vw, w;
+
+   for (h = 0, k = 0; h < s->nlev; h++)
+      k += s->len[h];
+
+   vw = dgetmem((int) (2 * (k > 0 ? k : 1)));
+   for (h = 0, k = 0, w = 1.0; h < s->nlev; h++, w *= 2.0)
+      for (i = 0; i < s->len[h]; i++, k++) {
+         vw[2 * k] = s->buf[h][i];
+         vw[2 * k + 1] = w;
+      }
+   qsort(vw, (size_t) k, 2 * sizeof(*vw), cmpdouble);
+
+   *n = k;
+   return (vw);
+}
+
+/* r-th smallest value (0-based, counting weights) */
+static double rank_value(const double *vw, const long n, const double r)
+{
+   long i;
+   double cum = 0.0;
+
+   for (i = 0; i < n - 1; i++) {
+      cum += vw[2 * i + 1];
+      if (cum > r)
+         break;
+   }
+
+   return (vw[2 * i]);
+}
+
+double quantile_QSketch(const QSketch * s, const double q)
+{
+   long n;
+   double *vw, x;
+
+   if (s->count <= 0.0)
+      return (0.0);
+
+   vw = gather(s, &n);
+   x = rank_value(vw, n, floor(q * (s->count - 1.0) + 0.5));
+   free(vw);
+
+   return (x);
+}
+
+double median_QSketch(const QSketch * s)
+{
+   long n;
+   double *vw, x;
+
+   if (s->count <= 0.0)
+      return (0.0);
+
+   vw = gather(s, &n);
+   x = (rank_value(vw, n, floor((s->count - 1.0) / 2.0))
+        + rank_value(vw, n, floor(s->count / 2.0))) / 2.0;
+   free(vw);
+
+   return (x);
+}
+
+void free_QSketch(QSketch * s)
+{
+   int h;
+
+   for (h = 0; h < s->nlev; h++)
+      free(s->buf[h]);
+   if (s->nlev > 0) {
+      free(s->len);
+      free(s->size);
+      free(s->buf);
+   }
+   s->nlev = 0;
+   s->count = 0.0;
+}
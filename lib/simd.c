@@ -0,0 +1,396 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Run-time Dispatch of Vector Kernels
+
+    double simd_dot(x, y, n)       < sum x(i) y(i) >
+    double simd_dist2(x, y, n)     < sum (x(i) - y(i))^2 >
+    double simd_wdist2(x, y, v, n) < sum (x(i) - y(i))^2 / v(i) >
+    const char *simd_level()       < name of the level in use >
+
+    double *x, *y : vectors
+    double *v     : divisors (e.g. variances)
+    int    n      : length of vectors
+
+    Each kernel is compiled for several instruction set levels
+    and the best one the CPU (and OS) supports is chosen on the
+    first call:
+
+      generic : plain C, summing from zero in index order
+      sse2    : 2 doubles per operation
+      avx2    : 4 doubles per operation
+      avx512  : 8 doubles per operation
+
+    The vector levels sum in several partial sums and may
+    differ from generic in the last bits.  The environment
+    variable SPTK_SIMD forces a level (e.g. SPTK_SIMD=generic
+    to reproduce results exactly); a level the CPU lacks falls
+    back to the best one it has.  The vector levels need GCC
+    or Clang on x86; otherwise, or with -DNO_SIMD, only
+    generic is built.
+
+    As with the warping tables, the choice is kept per process.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && !defined(NO_SIMD)
+#  define SIMD_X86
+#endif
+
+typedef struct _SimdOps {
+   const char *name;
+   double (*dot) (const double *, const double *, const int);
+   double (*dist2) (const double *, const double *, const int);
+   double (*wdist2) (const double *, const double *, const double *,
+                     const int);
+} SimdOps;
+
+static double dot_generic(const double *x, const double *y, const int n)
+{
+   int i;
+   double s = 0.0;
+
+   for (i = 0; i < n; i++)
+      s += x[i] * y[i];
+
+   return (s);
+}
+
+static double dist2_generic(const double *x, const double *y, const int n)
+{
+   int i;
+   double d, s = 0.0;
+
+   for (i = 0; i < n; i++) {
+      d = x[i] - y[i];
+      s += d * d;
+   }
+
+   return (s);
+}
+
+static double wdist2_generic(const double *x, const double *y,
+                             const double *v, const int n)
+{
+   int i;
+   double d, s = 0.0;
+
+   for (i = 0; i < n; i++) {
+      d = x[i] - y[i];
+      s += (d * d) / v[i];
+   }
+
+   return (s);
+}
+
+#ifdef SIMD_X86
+
+/* unaligned vectors of doubles */
+typedef double v2df __attribute__ ((vector_size(16), aligned(8), may_alias));
+typedef double v4df __attribute__ ((vector_size(32), aligned(8), may_alias));
+typedef double v8df __attribute__ ((vector_size(64), aligned(8), may_alias));
+
+#define V(t, p) (*(const t *) (p))
+
+__attribute__ ((target("sse2")))
+static double dot_sse2(const double *x, const double *y, const int n)
+{
+   int i;
+   double s;
+   v2df a = { 0.0, 0.0 };
+
+   for (i = 0; i + 2 <= n; i += 2)
+      a += V(v2df, x + i) * V(v2df, y + i);
+   for (s = a[0] + a[1]; i < n; i++)
+      s += x[i] * y[i];
+
+   return (s);
+}
+
+__attribute__ ((target("sse2")))
+static double dist2_sse2(const double *x, const double *y, const int n)
+{
+   int i;
+   double s, d;
+   v2df a = { 0.0, 0.0 }, e;
+
+   for (i = 0; i + 2 <= n; i += 2) {
+      e = V(v2df, x + i) - V(v2df, y + i);
+      a += e * e;
+   }
+   for (s = a[0] + a[1]; i < n; i++) {
+      d = x[i] - y[i];
+      s += d * d;
+   }
+
+   return (s);
+}
+
+__attribute__ ((target("sse2")))
+static double wdist2_sse2(const double *x, const double *y, const double *v,
+                          const int n)
+{
+   int i;
+   double s, d;
+   v2df a = { 0.0, 0.0 }, e;
+
+   for (i = 0; i + 2 <= n; i += 2) {
+      e = V(v2df, x + i) - V(v2df, y + i);
+      a += (e * e) / V(v2df, v + i);
+   }
+   for (s = a[0] + a[1]; i < n; i++) {
+      d = x[i] - y[i];
+      s += (d * d) / v[i];
+   }
+
+   return (s);
+}
+
+__attribute__ ((target("avx2")))
+static double dot_avx2(const double *x, const double *y, const int n)
+{
+   int i;
+   double s;
+   v4df a = { 0.0, 0.0, 0.0, 0.0 };
+
+   for (i = 0; i + 4 <= n; i += 4)
+      a += V(v4df, x + i) * V(v4df, y + i);
+   for (s = (a[0] + a[2]) + (a[1] + a[3]); i < n; i++)
+      s += x[i] * y[i];
+
+   return (s);
+}
+
+__attribute__ ((target("avx2")))
+static double dist2_avx2(const double *x, const double *y, const int n)
+{
+   int i;
+   double s, d;
+   v4df a = { 0.0, 0.0, 0.0, 0.0 }, e;
+
+   for (i = 0; i + 4 <= n; i += 4) {
+      e = V(v4df, x + i) - V(v4df, y + i);
+      a += e * e;
+   }
+   for (s = (a[0] + a[2]) + (a[1] + a[3]); i < n; i++) {
+      d = x[i] - y[i];
+      s += d * d;
+   }
+
+   return (s);
+}
+
+__attribute__ ((target("avx2")))
+static double wdist2_avx2(const double *x, const double *y, const double *v,
+                          const int n)
+{
+   int i;
+   double s, d;
+   v4df a = { 0.0, 0.0, 0.0, 0.0 }, e;
+
+   for (i = 0; i + 4 <= n; i += 4) {
+      e = V(v4df, x + i) - V(v4df, y + i);
+      a += (e * e) / V(v4df, v + i);
+   }
+   for (s = (a[0] + a[2]) + (a[1] + a[3]); i < n; i++) {
+      d = x[i] - y[i];
+      s += (d * d) / v[i];
+   }
+
+   return (s);
+}
+
+/* sum of the 8 elements of an avx512 vector */
+__attribute__ ((target("avx512f")))
+static double hsum8(v8df a)
+{
+   return (((a[0] + a[4]) + (a[2] + a[6])) + ((a[1] + a[5]) + (a[3] + a[7])));
+}
+
+__attribute__ ((target("avx512f")))
+static double dot_avx512(const double *x, const double *y, const int n)
+{
+   int i;
+   double s;
+   v8df a = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+   for (i = 0; i + 8 <= n; i += 8)
+      a += V(v8df, x + i) * V(v8df, y + i);
+   for (s = hsum8(a); i < n; i++)
+      s += x[i] * y[i];
+
+   return (s);
+}
+
+__attribute__ ((target("avx512f")))
+static double dist2_avx512(const double *x, const double *y, const int n)
+{
+   int i;
+   double s, d;
+   v8df a = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, e;
+
+   for (i = 0; i + 8 <= n; i += 8) {
+      e = V(v8df, x + i) - V(v8df, y + i);
+      a += e * e;
+   }
+   for (s = hsum8(a); i < n; i++) {
+      d = x[i] - y[i];
+      s += d * d;
+   }
+
+   return (s);
+}
+
+__attribute__ ((target("avx512f")))
+static double wdist2_avx512(const double *x, const double *y,
+                            const double *v, const int n)
+{
+   int i;
+   double s, d;
+   v8df a = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, e;
+
+   for (i = 0; i + 8 <= n; i += 8) {
+      e = V(v8df, x + i) - V(v8df, y + i);
+      a += (e * e) / V(v8df, v + i);
+   }
+   for (s = hsum8(a); i < n; i++) {
+      d = x[i] - y[i];
+      s += (d * d) / v[i];
+   }
+
+   return (s);
+}
+
+#endif                          /* SIMD_X86 */
+
+/* levels from the lowest, terminated by NULL */
+static SimdOps levels[] = {
+   {"generic", dot_generic, dist2_generic, wdist2_generic},
+#ifdef SIMD_X86
+   {"sse2", dot_sse2, dist2_sse2, wdist2_sse2},
+   {"avx2", dot_avx2, dist2_avx2, wdist2_avx2},
+   {"avx512", dot_avx512, dist2_avx512, wdist2_avx512},
+#endif
+   {NULL, NULL, NULL, NULL}
+};
+
+static SimdOps *ops = NULL;
+
+static int supported(const char *name)
+{
+#ifdef SIMD_X86
+   __builtin_cpu_init();
+   if (strcmp(name, "sse2") == 0)
+      return (__builtin_cpu_supports("sse2"));
+   if (strcmp(name, "avx2") == 0)
+      return (__builtin_cpu_supports("avx2"));
+   if (strcmp(name, "avx512") == 0)
+      return (__builtin_cpu_supports("avx512f"));
+#endif
+   return (strcmp(name, "generic") == 0);
+}
+
+static void simd_init(void)
+{
+   int i, best = 0, want = -1;
+   char *env = getenv("SPTK_SIMD");
+
+   for (i = 0; levels[i].name != NULL; i++) {
+      if (supported(levels[i].name))
+         best = i;
+      if (env != NULL && strcmp(env, levels[i].name) == 0)
+         want = i;
+   }
+   if (env != NULL && want < 0)
+      fprintf(stderr, "simd : Unknown level %s in SPTK_SIMD!\n", env);
+   else if (want > best)
+      fprintf(stderr, "simd : Level %s is not supported, using %s!\n",
+              env, levels[best].name);
+   else if (want >= 0)
+      best = want;
+
+   ops = &levels[best];
+}
+
+double simd_dot(const double *x, const double *y, const int n)
+{
+   if (ops == NULL)
+      simd_init();
+   return (ops->dot(x, y, n));
+}
+
+double simd_dist2(const double *x, const double *y, const int n)
+{
+   if (ops == NULL)
+      simd_init();
+   return (ops->dist2(x, y, n));
+}
+
+double simd_wdist2(const double *x, const double *y, const double *v,
+                   const int n)
+{
+   if (ops == NULL)
+      simd_init();
+   return (ops->wdist2(x, y, v, n));
+}
+
+const char *simd_level(void)
+{
+   if (ops == NULL)
+      simd_init();
+   return (ops->name);
+}
@@ -0,0 +1,257 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Run Statistics of Iterative Estimators
+
+    void stats_open(tool, fp)
+    void stats_stage(name)
+    void stats_frame(iter, fail)
+    void stats_restart()
+    void stats_close()
+
+    char    *tool : name of command
+    FILE    *fp   : stream of records (NULL: statistics are off)
+    char    *name : name of stage (kept by pointer, e.g. a literal)
+    int     iter  : number of iterations spent on the frame
+    Boolean fail  : the frame did not converge
+
+    Iterative routines (mcep, gcep, mgcep, smcep, lpc2lsp,
+    root_pol, lbg, ...) call stats_frame() once per solved
+    frame, and commands call stats_stage() whenever they move
+    on to another stage of processing (reading, analysis,
+    writing, ...).  Both return at once unless a command has
+    called stats_open(), so the routines can be used as before.
+
+    Each record is written to fp as one line of JSON.  A frame
+    record holds the number of iterations, the convergence
+    flag, whether the routine had to restart from its usual
+    initial value (stats_restart() called since the previous
+    frame, e.g. a failed warm start of gcep), the CPU time
+    since the previous record and the number of getmem() calls
+    made meanwhile:
+
+      {"type":"frame","tool":"gcep","stage":"analysis",
+       "frame":0,"iter":5,"fail":false,"restart":false,
+       "time":0.000112,"alloc":0}
+
+    stats_close() writes a summary record with the totals, the
+    frame that needed most iterations, the CPU time spent in
+    each stage and the number and size of allocations:
+
+      {"type":"summary","tool":"mcep","frames":759,"iter":3875,
+       "iter_mean":5.1,"iter_max":12,"iter_max_frame":101,
+       "fail":0,"restart":0,"time":{"setup":0.0001,...},
+       "time_total":0.35,"alloc":4,"alloc_bytes":24840}
+
+    The statistics are kept per process, like the registry of
+    warping tables.
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define STATS_NSTAGE 16
+
+static FILE *out = NULL;
+static const char *tool, *stage[STATS_NSTAGE];
+static double tstage[STATS_NSTAGE];
+static int nstage, cur, maxiter;
+static long nfrm, niter, nfail, nrestart, maxfrm, nalloc, falloc;
+static Boolean restart;
+static double nbyte;
+static clock_t mark, last;
+
+/* write s as a JSON string */
+static void putstr(const char *s)
+{
+   putc('"', out);
+   for (; *s != '\0'; s++) {
+      if (*s == '"' || *s == '\\')
+         fprintf(out, "\\%c", *s);
+      else if ((unsigned char) *s < 0x20)
+         fprintf(out, "\\u%04x", (unsigned char) *s);
+      else
+         putc(*s, out);
+   }
+   putc('"', out);
+}
+
+static double seconds(const clock_t t)
+{
+   return ((double) t / CLOCKS_PER_SEC);
+}
+
+void stats_open(const char *name, FILE * fp)
+{
+   out = fp;
+   if (out == NULL)
+      return;
+
+   tool = name;
+   stage[0] = "setup";
+   tstage[0] = 0.0;
+   nstage = 1;
+   cur = 0;
+   nfrm = niter = nfail = nrestart = maxfrm = 0;
+   restart = FA;
+   maxiter = -1;
+   nalloc = falloc = getmem_count(&nbyte);
+   mark = last = clock();
+}
+
+void stats_stage(const char *name)
+{
+   int i;
+   clock_t now;
+
+   if (out == NULL)
+      return;
+
+   now = clock();
+   tstage[cur] += seconds(now - mark);
+   mark = now;
+
+   for (i = 0; i < nstage; i++)
+      if (stage[i] == name || strcmp(stage[i], name) == 0)
+         break;
+   if (i == nstage) {
+      if (nstage == STATS_NSTAGE)       /* charge the last stage */
+         i = nstage - 1;
+      else {
+         stage[i] = name;
+         tstage[i] = 0.0;
+         nstage++;
+      }
+   }
+   cur = i;
+}
+
+void stats_frame(const int iter, const Boolean fail)
+{
+   long n;
+   clock_t now;
+
+   if (out == NULL)
+      return;
+
+   now = clock();
+   n = getmem_count(NULL);
+
+   fputs("{\"type\":\"frame\",\"tool\":", out);
+   putstr(tool);
+   fputs(",\"stage\":", out);
+   putstr(stage[cur]);
+   fprintf(out, ",\"frame\":%ld,\"iter\":%d,\"fail\":%s,\"restart\":%s",
+           nfrm, iter, (fail) ? "true" : "false", (restart) ? "true" : "false");
+   fprintf(out, ",\"time\":%.6f,\"alloc\":%ld}\n", seconds(now - last),
+           n - falloc);
+
+   if (iter > maxiter) {
+      maxiter = iter;
+      maxfrm = nfrm;
+   }
+   nfrm++;
+   niter += iter;
+   if (fail)
+      nfail++;
+   if (restart)
+      nrestart++;
+   restart = FA;
+   falloc = n;
+   last = now;
+}
+
+void stats_restart(void)
+{
+   if (out == NULL)
+      return;
+
+   restart = TR;
+}
+
+void stats_close(void)
+{
+   int i;
+   long n;
+   double total, bytes;
+
+   if (out == NULL)
+      return;
+
+   stats_stage(stage[cur]);
+   n = getmem_count(&bytes);
+
+   fputs("{\"type\":\"summary\",\"tool\":", out);
+   putstr(tool);
+   fprintf(out, ",\"frames\":%ld,\"iter\":%ld,\"iter_mean\":%g", nfrm, niter,
+           (nfrm > 0) ? (double) niter / nfrm : 0.0);
+   if (nfrm > 0)
+      fprintf(out, ",\"iter_max\":%d,\"iter_max_frame\":%ld", maxiter,
+              maxfrm);
+   fprintf(out, ",\"fail\":%ld,\"restart\":%ld,\"time\":{", nfail,
+           nrestart);
+   for (i = 0, total = 0.0; i < nstage; i++) {
+      if (i > 0)
+         putc(',', out);
+      putstr(stage[i]);
+      fprintf(out, ":%.6f", tstage[i]);
+      total += tstage[i];
+   }
+   fprintf(out, "},\"time_total\":%.6f,\"alloc\":%ld,\"alloc_bytes\":%.0f}\n",
+           total, n - nalloc, bytes - nbyte);
+   fflush(out);
+
+   out = NULL;
+}
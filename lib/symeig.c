@@ -0,0 +1,504 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Eigen Decomposition of Real Symmetric Matrix
+
+    int symeig(a, n, k, e_val, e_vec)
+
+    double *a     : symmetric matrix (n x n, destroyed)
+    int    n      : order of matrix
+    int    k      : number of eigen pairs to compute (k <= n)
+    double *e_val : k largest eigenvalues in descending order
+    double *e_vec : corresponding eigenvectors (k x n, row-wise)
+
+    return value  : 0 -> normally completed
+                   -1 -> QL iteration did not converge
+
+    The matrix is reduced to tridiagonal form by Householder
+    reflections and the eigenvalues are found by the implicit
+    QL method.  If all eigenpairs are wanted, the QL rotations
+    are accumulated onto the Householder basis; otherwise the
+    k eigenvectors are computed by inverse iteration on the
+    tridiagonal matrix and transformed back, which costs only
+    O(k n^2) beyond the reduction.  Inverse iteration cannot
+    separate the vectors of a split or (nearly) degenerate
+    tridiagonal matrix, e.g. of rank-deficient data, so such
+    matrices, and any result that fails to stay orthogonal,
+    are done by the full QL path and truncated to k.
+
+    Each eigenvector is normalized and its component of the
+    largest magnitude is made positive.  The total number of QL
+    iterations is reported to stats_frame().
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define MAXITR  30
+#define INVITR  3
+#define DBL_EPS 2.2204460492503131e-16
+#define CLUSTER 1.0e-8          /* relative gap of near-equal eigenvalues */
+#define ORTTOL  1.0e-6          /* largest |<x_i, x_j>| accepted */
+
+static double pythag(const double a, const double b)
+{
+   double x = fabs(a), y = fabs(b), r;
+
+   if (x > y) {
+      r = y / x;
+      return (x * sqrt(1.0 + r * r));
+   }
+   if (y == 0.0)
+      return (0.0);
+   r = x / y;
+   return (y * sqrt(1.0 + r * r));
+}
+
+/* Householder reduction: v_j is stored in a[j+1..n-1][j] (v_j[0] = 1) */
+static void tridiag(double *a, const int n, double *d, double *e,
+                    double *tau, double *w)
+{
+   int i, j, l;
+   double alpha, beta, norm, s, *v, *aj;
+
+   for (j = 0; j < n - 2; j++) {
+      l = n - j - 1;
+      v = w;
+      for (i = 0; i < l; i++)
+         v[i] = a[(j + 1 + i) * n + j];
+
+      for (i = 1, norm = 0.0; i < l; i++)
+         norm += v[i] * v[i];
+
+      if (norm == 0.0) {
+         tau[j] = 0.0;
+         e[j] = v[0];
+      } else {
+         alpha = v[0];
+         beta = -sqrt(alpha * alpha + norm);
+         if (alpha < 0.0)
+            beta = -beta;
+         tau[j] = (beta - alpha) / beta;
+         s = 1.0 / (alpha - beta);
+         v[0] = 1.0;
+         for (i = 1; i < l; i++)
+            v[i] *= s;
+         e[j] = beta;
+
+         /* A22 = H A22 H,  p = tau A22 v,  q = p - tau / 2 (p'v) v */
+         {
+            double *p = w + l, *a22 = a + (j + 1) * n + (j + 1), pv, t;
+            int r, c;
+
+            for (r = 0; r < l; r++)
+               p[r] = 0.0;
+            for (r = 0; r < l; r++) {
+               aj = a22 + r * n;
+               t = aj[r] * v[r];
+               for (c = 0; c < r; c++) {
+                  t += aj[c] * v[c];
+                  p[c] += aj[c] * v[r];
+               }
+               p[r] += t;
+            }
+            for (r = 0, pv = 0.0; r < l; r++) {
+               p[r] *= tau[j];
+               pv += p[r] * v[r];
+            }
+            t = 0.5 * tau[j] * pv;
+            for (r = 0; r < l; r++)
+               p[r] -= t * v[r];
+            for (r = 0; r < l; r++) {
+               aj = a22 + r * n;
+               for (c = 0; c <= r; c++)
+                  aj[c] -= v[r] * p[c] + p[r] * v[c];
+            }
+         }
+      }
+
+      for (i = 1; i < l; i++)
+         a[(j + 1 + i) * n + j] = v[i];
+      d[j] = a[j * n + j];
+   }
+
+   if (n > 1) {
+      d[n - 2] = a[(n - 2) * n + (n - 2)];
+      e[n - 2] = a[(n - 1) * n + (n - 2)];
+      if (n > 2)
+         tau[n - 2] = 0.0;
+   }
+   d[n - 1] = a[(n - 1) * n + (n - 1)];
+   e[n - 1] = 0.0;
+}
+
+/* x = H_0 H_1 ... H_{n-3} x */
+static void backtrans(const double *a, const int n, const double *tau,
+                      double *x)
+{
+   int i, j;
+   double s;
+
+   for (j = n - 3; j >= 0; j--) {
+      if (tau[j] == 0.0)
+         continue;
+      s = x[j + 1];
+      for (i = j + 2; i < n; i++)
+         s += a[i * n + j] * x[i];
+      s *= tau[j];
+      x[j + 1] -= s;
+      for (i = j + 2; i < n; i++)
+         x[i] -= s * a[i * n + j];
+   }
+}
+
+static int nitr;                /* QL iterations of the current matrix */
+
+/* implicit QL; rotations applied to the rows of z if z != NULL */
+static int tql(double *d, double *e, const int n, double *z)
+{
+   int i, k, l, m, iter;
+   double c, c2, c3, dl1, el1, f, g, h, p, r, s, s2, tst1, *zi, *zj;
+
+   f = 0.0;
+   tst1 = 0.0;
+   c3 = s2 = 0.0;
+
+   for (l = 0; l < n; l++) {
+      h = fabs(d[l]) + fabs(e[l]);
+      if (tst1 < h)
+         tst1 = h;
+      for (m = l; m < n; m++)
+         if (fabs(e[m]) <= DBL_EPS * tst1)
+            break;
+      if (m == n)
+         m = n - 1;
+
+      if (m > l) {
+         iter = 0;
+         do {
+            if (++iter > MAXITR)
+               return (-1);
+            nitr++;
+
+            g = d[l];
+            p = (d[l + 1] - g) / (2.0 * e[l]);
+            r = pythag(p, 1.0);
+            if (p < 0)
+               r = -r;
+            d[l] = e[l] / (p + r);
+            d[l + 1] = e[l] * (p + r);
+            dl1 = d[l + 1];
+            h = g - d[l];
+            for (i = l + 2; i < n; i++)
+               d[i] -= h;
+            f += h;
+
+            p = d[m];
+            c = 1.0;
+            c2 = c;
+            el1 = e[l + 1];
+            s = 0.0;
+            for (i = m - 1; i >= l; i--) {
+               c3 = c2;
+               c2 = c;
+               s2 = s;
+               g = c * e[i];
+               h = c * p;
+               r = pythag(p, e[i]);
+               e[i + 1] = s * r;
+               s = e[i] / r;
+               c = p / r;
+               p = c * d[i] - s * g;
+               d[i + 1] = h + s * (c * g + s * d[i]);
+
+               if (z != NULL) {
+                  zi = z + i * n;
+                  zj = zi + n;
+                  for (k = 0; k < n; k++) {
+                     h = zj[k];
+                     zj[k] = s * zi[k] + c * h;
+                     zi[k] = c * zi[k] - s * h;
+                  }
+               }
+            }
+            p = -s * s2 * c3 * el1 * e[l] / dl1;
+            e[l] = s * p;
+            d[l] = c * p;
+         } while (fabs(e[l]) > DBL_EPS * tst1);
+      }
+      d[l] += f;
+      e[l] = 0.0;
+   }
+
+   return (0);
+}
+
+/* solve (T - sigma I) x = b by LU with partial pivoting (LAPACK dgttrf) */
+static void tridiag_solve(const double *d, const double *e, const int n,
+                          const double sigma, const double tiny, double *w,
+                          int *ipiv, double *b)
+{
+   int i;
+   double *dd = w, *dl = dd + n, *du = dl + n, *du2 = du + n, fact, temp;
+
+   for (i = 0; i < n; i++) {
+      dd[i] = d[i] - sigma;
+      dl[i] = du[i] = e[i];
+      du2[i] = 0.0;
+   }
+
+   for (i = 0; i < n - 1; i++) {
+      if (fabs(dd[i]) >= fabs(dl[i])) {
+         if (dd[i] == 0.0)
+            dd[i] = tiny;
+         fact = dl[i] / dd[i];
+         dl[i] = fact;
+         dd[i + 1] -= fact * du[i];
+         ipiv[i] = i;
+      } else {
+         fact = dd[i] / dl[i];
+         dd[i] = dl[i];
+         dl[i] = fact;
+         temp = du[i];
+         du[i] = dd[i + 1];
+         dd[i + 1] = temp - fact * dd[i + 1];
+         if (i < n - 2) {
+            du2[i] = du[i + 1];
+            du[i + 1] = -fact * du[i + 1];
+         }
+         ipiv[i] = i + 1;
+      }
+   }
+   if (dd[n - 1] == 0.0)
+      dd[n - 1] = tiny;
+
+   for (i = 0; i < n - 1; i++) {
+      if (ipiv[i] == i)
+         b[i + 1] -= dl[i] * b[i];
+      else {
+         temp = b[i];
+         b[i] = b[i + 1];
+         b[i + 1] = temp - dl[i] * b[i];
+      }
+   }
+
+   b[n - 1] /= dd[n - 1];
+   if (n > 1)
+      b[n - 2] = (b[n - 2] - du[n - 2] * b[n - 1]) / dd[n - 2];
+   for (i = n - 3; i >= 0; i--)
+      b[i] = (b[i] - du[i] * b[i + 1] - du2[i] * b[i + 2]) / dd[i];
+}
+
+static void normalize(double *x, const int n)
+{
+   int i, imax = 0;
+   double s = 0.0;
+
+   for (i = 0; i < n; i++) {
+      s += x[i] * x[i];
+      if (fabs(x[i]) > fabs(x[imax]))
+         imax = i;
+   }
+   s = sqrt(s);
+   if (s == 0.0)
+      return;
+   if (x[imax] < 0.0)
+      s = -s;
+   for (i = 0; i < n; i++)
+      x[i] /= s;
+}
+
+/* indices of the k largest eigenvalues, in descending order */
+static void select_top(const double *d, const int n, const int k, int *idx)
+{
+   int i, j, t;
+
+   for (i = 0; i < n; i++)
+      idx[i] = i;
+   for (i = 0; i < k; i++)
+      for (j = n - 1; j > i; j--)
+         if (d[idx[j]] > d[idx[j - 1]]) {
+            t = idx[j];
+            idx[j] = idx[j - 1];
+            idx[j - 1] = t;
+         }
+}
+
+/* all eigenpairs by QL on the Householder basis; the k largest are kept */
+static int symeig_full(const double *a, const int n, const int k,
+                       double *d, double *e, const double *tau, int *idx,
+                       double *e_val, double *e_vec)
+{
+   int i, j, ret = 0;
+   double *z;
+
+   /* row i of z = Q e_i, i.e. z = Q' and QL rotates its rows */
+   z = dgetmem(n * n);
+   for (i = 0; i < n; i++) {
+      z[i * n + i] = 1.0;
+      backtrans(a, n, tau, z + i * n);
+   }
+   if (tql(d, e, n, z) != 0)
+      ret = -1;
+
+   select_top(d, n, n, idx);
+   for (i = 0; i < k; i++) {
+      e_val[i] = d[idx[i]];
+      for (j = 0; j < n; j++)
+         e_vec[i * n + j] = z[idx[i] * n + j];
+      normalize(e_vec + i * n, n);
+   }
+   free(z);
+
+   return (ret);
+}
+
+/* split blocks or near-equal eigenvalues among the k+1 largest */
+static int degenerate(const double *d, const double *e, const int n,
+                      const int k, const int *idx, const double tnorm)
+{
+   int i;
+
+   for (i = 0; i < n - 1; i++)
+      if (fabs(e[i]) <= DBL_EPS * tnorm)
+         return (1);
+   for (i = 0; i < k && i < n - 1; i++)
+      if (d[idx[i]] - d[idx[i + 1]] <= CLUSTER * tnorm)
+         return (1);
+
+   return (0);
+}
+
+int symeig(double *a, const int n, const int k, double *e_val, double *e_vec)
+{
+   int i, j, l, it, *idx, *ipiv, full, ret = 0;
+   double *d, *e, *td, *te, *tau, *w, *x, s, tnorm, tiny;
+
+   if (n <= 0 || k <= 0)
+      return (0);
+
+   d = dgetmem(9 * n);
+   e = d + n;
+   td = e + n;
+   te = td + n;
+   tau = te + n;
+   w = tau + n;                 /* 4n */
+   idx = (int *) getmem((size_t) (2 * n), sizeof(int));
+   ipiv = idx + n;
+
+   tridiag(a, n, d, e, tau, w);
+   nitr = 0;
+
+   if (k >= n) {
+      ret = symeig_full(a, n, n, d, e, tau, idx, e_val, e_vec);
+   } else {
+      for (i = 0; i < n; i++) {
+         td[i] = d[i];
+         te[i] = e[i];
+      }
+      if (tql(td, te, n, NULL) != 0)
+         ret = -1;
+
+      for (i = 0, tnorm = 0.0; i < n; i++)
+         tnorm += fabs(d[i]) + fabs(e[i]);
+      tiny = DBL_EPS * (tnorm > 0.0 ? tnorm : 1.0);
+
+      select_top(td, n, k + 1, idx);
+      full = degenerate(td, e, n, k, idx, tnorm);
+
+      for (l = 0; l < k && !full; l++) {
+         e_val[l] = td[idx[l]];
+         x = e_vec + l * n;
+         for (i = 0; i < n; i++)
+            x[i] = 1.0 + 0.01 * ((i * 7 + l * 3) % 11);
+
+         for (it = 0; it < INVITR; it++) {
+            tridiag_solve(d, e, n, e_val[l] + tiny * (l + 1), tiny, w, ipiv,
+                          x);
+            /* keep eigenvectors of close eigenvalues orthogonal */
+            for (j = 0; j < l; j++) {
+               for (i = 0, s = 0.0; i < n; i++)
+                  s += x[i] * e_vec[j * n + i];
+               for (i = 0; i < n; i++)
+                  x[i] -= s * e_vec[j * n + i];
+            }
+            normalize(x, n);
+         }
+
+         /* re-check after the last iteration */
+         for (j = 0; j <= l && !full; j++) {
+            for (i = 0, s = 0.0; i < n; i++)
+               s += x[i] * e_vec[j * n + i];
+            if (fabs(s - (j == l ? 1.0 : 0.0)) > ORTTOL)
+               full = 1;
+         }
+      }
+
+      if (full) {
+         ret = symeig_full(a, n, k, d, e, tau, idx, e_val, e_vec);
+      } else {
+         /* back-transform after all vectors of T are orthogonalized */
+         for (l = 0; l < k; l++) {
+            backtrans(a, n, tau, e_vec + l * n);
+            normalize(e_vec + l * n, n);
+         }
+      }
+   }
+
+   free(idx);
+   free(d);
+   stats_frame(nitr, ret != 0);
+
+   return (ret);
+}
@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------- */
+/*             The Speech Signal Processing Toolkit (SPTK)           */
+/*             developed by SPTK Working Group                       */
+/*             http://sp-tk.sourceforge.net/                         */
+/* ----------------------------------------------------------------- */
+/*                                                                   */
+/*  Copyright (c) 1984-2007  Tokyo Institute of Technology           */
+/*                           Interdisciplinary Graduate School of    */
+/*                           Science and Engineering                 */
+/*                                                                   */
+/*                1996-2014  Nagoya Institute of Technology          */
+/*                           Department of Computer Science          */
+/*                                                                   */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/* - Redistributions of source code must retain the above copyright  */
+/*   notice, this list of conditions and the following disclaimer.   */
+/* - Redistributions in binary form must reproduce the above         */
+/*   copyright notice, this list of conditions and the following     */
+/*   disclaimer in the documentation and/or other materials provided */
+/*   with the distribution.                                          */
+/* - Neither the name of the SPTK working group nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission.   */
+/*                                                                   */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            */
+/* CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       */
+/* INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          */
+/* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          */
+/* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS */
+/* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          */
+/* EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     */
+/* DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON */
+/* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   */
+/* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    */
+/* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           */
+/* POSSIBILITY OF SUCH DAMAGE.                                       */
+/* ----------------------------------------------------------------- */
+
+/****************************************************************
+
+    Registry of Frequency Warping Tables
+
+    double *warptab(kind, m1, m2, fftsz, a, t, size, isnew)
+    void   warptab_clear()
+
+    WarpKind kind  : kind of table
+    int      m1    : order of input sequence
+    int      m2    : order of warped sequence
+    int      fftsz : FFT size used to build the table (or 0)
+    double   a     : all-pass constant
+    double   t     : emphasized frequency (or 0)
+    int      size  : number of elements of the table
+    int      *isnew: set to 1 if the table has just been allocated
+                     and must be filled by the caller, else 0
+
+    return value   : table registered under the key
+                     (kind, m1, m2, fftsz, a, t)
+
+    Warping matrices depend only on the key, so they are built
+    once per process and shared by every caller.  The most
+    recently used tables are kept at the head of the list; when
+    more than WARPTAB_MAX tables exist, the least recently used
+    one is released.  A returned table is therefore valid only
+    until the next call of warptab().
+
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(WIN32)
+#  include "SPTK.h"
+#else
+#  include <SPTK.h>
+#endif
+
+#define WARPTAB_MAX 16
+
+static WarpTable *head = NULL;
+
+double *warptab(const WarpKind kind, const int m1, const int m2,
+                const int fftsz, const double a, const double t,
+                const int size, int *isnew)
+{
+   int n;
+   WarpTable *p, *prev;
+
+   for (p = head, prev = NULL, n = 0; p != NULL; prev = p, p = p->next, n++) {
+      if (p->kind == kind && p->m1 == m1 && p->m2 == m2 && p->fftsz == fftsz
+          && p->a == a && p->t == t && p->size == size) {
+         if (prev != NULL) {    /* move to front */
+            prev->next = p->next;
+            p->next = head;
+            head = p;
+         }
+         *isnew = 0;
+         return (p->mat);
+      }
+   }
+
+   /* release the least recently used table */
+   if (n >= WARPTAB_MAX) {
+      for (p = head, prev = NULL; p->next != NULL; prev = p, p = p->next);
+      prev->next = NULL;
+      free(p->mat);
+      free(p);
+   }
+
+   p = (WarpTable *) getmem(1, sizeof(*p));
+   p->kind = kind;
+   p->m1 = m1;
+   p->m2 = m2;
+   p->fftsz = fftsz;
+   p->a = a;
+   p->t = t;
+   p->size = size;
+   p->mat = dgetmem(size);
+   p->next = head;
+   head = p;
+
+   *isnew = 1;
+   return (p->mat);
+}
+
+void warptab_clear(void)
+{
+   WarpTable *p;
+
+   while ((p = head) != NULL) {
+      head = p->next;
+      free(p->mat);
+      free(p);
+   }
+
+   return;
+}